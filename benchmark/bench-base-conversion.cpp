@@ -0,0 +1,125 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "experimental/seal/base-conversion-avx512.hpp"
+#include "experimental/seal/base-conversion-internal.hpp"
+#include "hexl/experimental/seal/base-conversion.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+// state[1] is the number of input moduli
+// state[2] is the number of output moduli
+// state[3] is the bit-width of the moduli
+// state[4] is whether to correct the q-overflow
+static void BM_FastBaseConversion(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_in_moduli = state.range(1);
+  size_t num_out_moduli = state.range(2);
+  size_t bit_width = state.range(3);
+  bool exact = state.range(4);
+
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_in_moduli + num_out_moduli, bit_width, true, n);
+  std::vector<uint64_t> in_moduli(moduli.begin(),
+                                  moduli.begin() + num_in_moduli);
+  std::vector<uint64_t> out_moduli(moduli.begin() + num_in_moduli,
+                                   moduli.end());
+  BaseConverter converter(in_moduli, out_moduli);
+
+  AlignedVector64<uint64_t> input(n * num_in_moduli);
+  for (size_t i = 0; i < num_in_moduli; ++i) {
+    auto limb = GenerateInsecureUniformIntRandomValues(n, 0, in_moduli[i]);
+    std::copy(limb.begin(), limb.end(), &input[i * n]);
+  }
+  AlignedVector64<uint64_t> output(n * num_out_moduli);
+  AlignedVector64<uint64_t> buffer(n * num_in_moduli);
+
+  for (auto _ : state) {
+    converter.FastBaseConversion(output.data(), input.data(), n, exact,
+                                 buffer.data());
+  }
+}
+
+BENCHMARK(BM_FastBaseConversion)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {3, 8}, {4}, {45, 60}, {false, true}});
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the number of input moduli
+static void BM_FastBaseConversionNative(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_in_moduli = state.range(1);
+  size_t num_out_moduli = 4;
+
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_in_moduli + num_out_moduli, 45, true, n);
+  std::vector<uint64_t> in_moduli(moduli.begin(),
+                                  moduli.begin() + num_in_moduli);
+  std::vector<uint64_t> out_moduli(moduli.begin() + num_in_moduli,
+                                   moduli.end());
+  BaseConverter converter(in_moduli, out_moduli);
+
+  auto y = GenerateInsecureUniformIntRandomValues(n * num_in_moduli, 0,
+                                                  in_moduli[0]);
+  AlignedVector64<uint64_t> output(n * num_out_moduli);
+
+  for (auto _ : state) {
+    FastBaseConversionNative(output.data(), y.data(), n, num_in_moduli,
+                             out_moduli.data(), num_out_moduli,
+                             converter.GetQHatModP().data(), nullptr);
+  }
+}
+
+BENCHMARK(BM_FastBaseConversionNative)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {3, 8}});
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512IFMA
+// state[0] is the degree
+// state[1] is the number of input moduli
+static void BM_FastBaseConversionAVX512IFMA(  //  NOLINT
+    benchmark::State& state) {
+  size_t n = state.range(0);
+  size_t num_in_moduli = state.range(1);
+  size_t num_out_moduli = 4;
+
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_in_moduli + num_out_moduli, 45, true, n);
+  std::vector<uint64_t> in_moduli(moduli.begin(),
+                                  moduli.begin() + num_in_moduli);
+  std::vector<uint64_t> out_moduli(moduli.begin() + num_in_moduli,
+                                   moduli.end());
+  BaseConverter converter(in_moduli, out_moduli);
+
+  auto y = GenerateInsecureUniformIntRandomValues(n * num_in_moduli, 0,
+                                                  in_moduli[0]);
+  AlignedVector64<uint64_t> output(n * num_out_moduli);
+
+  for (auto _ : state) {
+    FastBaseConversionAVX512IFMA(output.data(), y.data(), n, num_in_moduli,
+                                 out_moduli.data(), num_out_moduli,
+                                 converter.GetQHatModP().data(), nullptr);
+  }
+}
+
+BENCHMARK(BM_FastBaseConversionAVX512IFMA)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {3, 8}});
+#endif
+
+}  // namespace hexl
+}  // namespace intel
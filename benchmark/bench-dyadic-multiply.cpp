@@ -0,0 +1,59 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/dyadic-multiply.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+// state[1] is the number of moduli
+// state[2] is the modulus bit width
+// state[3] is the number of threads; 0 uses the OpenMP default
+static void BM_DyadicMultiply(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t modulus_bits = state.range(2);
+  uint64_t num_threads = state.range(3);
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_moduli, modulus_bits, true, n);
+
+  AlignedVector64<uint64_t> operand1(2 * n * num_moduli);
+  AlignedVector64<uint64_t> operand2(2 * n * num_moduli);
+  for (size_t k = 0; k < 2; ++k) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      auto limb1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto limb2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      size_t offset = (k * num_moduli + i) * n;
+      std::copy(limb1.begin(), limb1.end(), &operand1[offset]);
+      std::copy(limb2.begin(), limb2.end(), &operand2[offset]);
+    }
+  }
+  AlignedVector64<uint64_t> result(3 * n * num_moduli);
+
+  uint64_t default_num_threads = GetDyadicMultiplyNumThreads();
+  SetDyadicMultiplyNumThreads(num_threads);
+  for (auto _ : state) {
+    DyadicMultiply(result.data(), operand1.data(), operand2.data(), n,
+                   moduli.data(), num_moduli);
+  }
+  SetDyadicMultiplyNumThreads(default_num_threads);
+  // Each call reads both operands and writes the result once
+  state.SetBytesProcessed(static_cast<int64_t>(
+      state.iterations() * 7 * n * num_moduli * sizeof(uint64_t)));
+}
+
+BENCHMARK(BM_DyadicMultiply)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 8192, 16384, 32768}, {3, 8, 20}, {40, 60}, {1, 0}});
+
+}  // namespace hexl
+}  // namespace intel
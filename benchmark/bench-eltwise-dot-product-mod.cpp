@@ -0,0 +1,155 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+// state[1] is the bit-width of the modulus
+static void BM_EltwiseDotProductMod(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  size_t bit_width = state.range(1);
+  uint64_t modulus = (1ULL << bit_width) + 7;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(EltwiseDotProductMod(
+        input1.data(), input2.data(), input_size, modulus, 1));
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductMod)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096, 16384}, {48, 60}});
+
+//=================================================================
+
+// Baseline: EltwiseMultMod into a temporary followed by a scalar reduction
+// state[0] is the degree
+// state[1] is the bit-width of the modulus
+static void BM_EltwiseDotProductModMultThenSum(  //  NOLINT
+    benchmark::State& state) {
+  size_t input_size = state.range(0);
+  size_t bit_width = state.range(1);
+  uint64_t modulus = (1ULL << bit_width) + 7;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  AlignedVector64<uint64_t> product(input_size, 0);
+
+  for (auto _ : state) {
+    EltwiseMultMod(product.data(), input1.data(), input2.data(), input_size,
+                   modulus, 1);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < input_size; ++i) {
+      sum = AddUIntMod(sum, product[i], modulus);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductModMultThenSum)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096, 16384}, {48, 60}});
+
+//=================================================================
+
+// state[0] is the degree
+static void BM_EltwiseDotProductModNative(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(EltwiseDotProductModNative<1>(
+        input1.data(), input2.data(), input_size, modulus));
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductModNative)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512DQ
+// state[0] is the degree
+// state[1] is the input_mod_factor
+static void BM_EltwiseDotProductModAVX512DQ(  //  NOLINT
+    benchmark::State& state) {
+  size_t input_size = state.range(0);
+  size_t input_mod_factor = state.range(1);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    switch (input_mod_factor) {
+      case 1:
+        benchmark::DoNotOptimize(EltwiseDotProductModAVX512DQ<1>(
+            input1.data(), input2.data(), input_size, modulus));
+        break;
+      case 2:
+        benchmark::DoNotOptimize(EltwiseDotProductModAVX512DQ<2>(
+            input1.data(), input2.data(), input_size, modulus));
+        break;
+      case 4:
+        benchmark::DoNotOptimize(EltwiseDotProductModAVX512DQ<4>(
+            input1.data(), input2.data(), input_size, modulus));
+        break;
+    }
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductModAVX512DQ)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096, 16384}, {1, 2, 4}});
+#endif
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512IFMA
+// state[0] is the degree
+static void BM_EltwiseDotProductModAVX512IFMA(  //  NOLINT
+    benchmark::State& state) {
+  size_t input_size = state.range(0);
+  uint64_t modulus = (1ULL << 50) + 7;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(EltwiseDotProductModAVX512IFMA(
+        input1.data(), input2.data(), input_size, modulus));
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductModAVX512IFMA)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -42,6 +42,39 @@ BENCHMARK(BM_EltwiseMultMod)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the bit-width of the modulus
+// state[2] is the EltwiseMultModAlgorithm: 0 = kAuto, 1 = kNative,
+// 2 = kAVX512Float, 3 = kAVX512IFMA, 4 = kAVX512DQInt
+static void BM_EltwiseMultModAlgorithm(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  size_t bit_width = state.range(1);
+  auto algorithm = static_cast<EltwiseMultModAlgorithm>(state.range(2));
+  uint64_t modulus = GeneratePrimes(1, bit_width, true)[0];
+
+  if (!IsEltwiseMultModAlgorithmSupported(algorithm, modulus)) {
+    state.SkipWithError("Algorithm not supported for this modulus");
+    return;
+  }
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  AlignedVector64<uint64_t> output(input_size, 2);
+
+  SetEltwiseMultModAlgorithm(algorithm);
+  for (auto _ : state) {
+    EltwiseMultMod(output.data(), input1.data(), input2.data(), input_size,
+                   modulus, 1);
+  }
+  SetEltwiseMultModAlgorithm(EltwiseMultModAlgorithm::kAuto);
+}
+
+BENCHMARK(BM_EltwiseMultModAlgorithm)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 16384}, {30, 40, 45, 49, 52, 60}, {0, 1, 2, 3, 4}});
+
+//=================================================================
+
 // state[0] is the degree
 static void BM_EltwiseMultModNative(benchmark::State& state) {  //  NOLINT
   size_t input_size = state.range(0);
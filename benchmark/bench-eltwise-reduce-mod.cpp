@@ -334,5 +334,80 @@ BENCHMARK(BM_EltwiseReduceModInOutMontFormAVX512BitShift52LT)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the input_mod_factor; 0 reduces the same data via Barrett
+static void BM_EltwiseReduceModLazy(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t input_mod_factor = state.range(1);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input1 =
+      GenerateInsecureUniformIntRandomValues(input_size, 0, 16 * modulus);
+  if (input_mod_factor == 0) {
+    input_mod_factor = modulus;
+  }
+  const uint64_t output_mod_factor = 1;
+  AlignedVector64<uint64_t> output(input_size, 0);
+
+  for (auto _ : state) {
+    EltwiseReduceMod(output.data(), input1.data(), input_size, modulus,
+                     input_mod_factor, output_mod_factor);
+  }
+}
+
+BENCHMARK(BM_EltwiseReduceModLazy)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096, 16384}, {0, 4, 8, 16}});
+
+//=================================================================
+
+// state[0] is the degree
+static void BM_EltwiseReduceMod128Native(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input_hi = GenerateInsecureUniformIntRandomValues(input_size, 0, ~0ULL);
+  auto input_lo = GenerateInsecureUniformIntRandomValues(input_size, 0, ~0ULL);
+  AlignedVector64<uint64_t> output(input_size, 0);
+
+  for (auto _ : state) {
+    EltwiseReduceMod128Native(output.data(), input_hi.data(), input_lo.data(),
+                              input_size, modulus, 1);
+  }
+}
+
+BENCHMARK(BM_EltwiseReduceMod128Native)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512DQ
+// state[0] is the degree
+static void BM_EltwiseReduceMod128AVX512(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input_hi = GenerateInsecureUniformIntRandomValues(input_size, 0, ~0ULL);
+  auto input_lo = GenerateInsecureUniformIntRandomValues(input_size, 0, ~0ULL);
+  AlignedVector64<uint64_t> output(input_size, 0);
+
+  for (auto _ : state) {
+    EltwiseReduceMod128AVX512(output.data(), input_hi.data(), input_lo.data(),
+                              input_size, modulus, 1);
+  }
+}
+
+BENCHMARK(BM_EltwiseReduceMod128AVX512)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+#endif
+
+//=================================================================
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,62 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-sum-mod-avx512.hpp"
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-sum-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+static void BM_EltwiseSumModNative(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        EltwiseSumModNative(input.data(), input_size, modulus));
+  }
+}
+
+BENCHMARK(BM_EltwiseSumModNative)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512DQ
+// state[0] is the degree
+static void BM_EltwiseSumModAVX512(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        EltwiseSumModAVX512(input.data(), input_size, modulus));
+  }
+}
+
+BENCHMARK(BM_EltwiseSumModAVX512)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,6 +5,9 @@
 
 #include <vector>
 
+#include "hexl/experimental/fft-like/ckks-encoding.hpp"
+#include "hexl/experimental/fft-like/fft-like-cache.hpp"
+#include "hexl/experimental/fft-like/fft-like-float.hpp"
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
 #include "hexl/experimental/fft-like/fwd-fft-like-avx512.hpp"
@@ -23,7 +26,7 @@ namespace hexl {
 static void BM_FFTLikeComplexRootsOfUnity(benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   for (auto _ : state) {
-    FFTLike fft_like(fft_like_size, nullptr);
+    FFTLike fft_like(fft_like_size);
   }
 }
 
@@ -33,6 +36,22 @@ BENCHMARK(BM_FFTLikeComplexRootsOfUnity)
     ->Args({4096})
     ->Args({16384});
 
+//=================================================================
+
+static void BM_GetFFTLike(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  PrewarmFFTLikeCache({fft_like_size});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&GetFFTLike(fft_like_size));
+  }
+}
+
+BENCHMARK(BM_GetFFTLike)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
 // Forward transforms
 //=================================================================
 
@@ -40,7 +59,7 @@ static void BM_FwdFFTLikeNativeRadix2InPlaceUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -72,7 +91,7 @@ static void BM_FwdFFTLikeNativeRadix2InPlaceSmallScaled(
   const size_t bound = 1 << 30;
   const double scale = 10;
   const double scalar = scale / static_cast<double>(fft_like_size);
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -104,7 +123,7 @@ static void BM_FwdFFTLikeNativeRadix2InPlaceLargeScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double scalar = scale / static_cast<double>(fft_like_size);
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -134,7 +153,7 @@ static void BM_FwdFFTLikeNativeRadix2CopyUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> output(fft_like_size);
   AlignedVector64<std::complex<double>> input(fft_like_size);
@@ -167,7 +186,7 @@ static void BM_FwdFFTLikeNativeRadix2CopyLargeScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double scalar = scale / static_cast<double>(fft_like_size);
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> output(fft_like_size);
   AlignedVector64<std::complex<double>> input(fft_like_size);
@@ -200,7 +219,7 @@ static void BM_InvFFTLikeNativeRadix2InPlaceUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -232,7 +251,7 @@ static void BM_InvFFTLikeNativeRadix2InPlaceSmallScaled(
   const size_t bound = 1 << 30;
   const double scale = 10;
   const double inv_scale = 1.0 / scale;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -265,7 +284,7 @@ static void BM_InvFFTLikeNativeRadix2InPlaceLargeScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double inv_scale = 1.0 / scale;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> input(fft_like_size);
   for (size_t i = 0; i < fft_like_size; i++) {
@@ -296,7 +315,7 @@ static void BM_InvFFTLikeNativeRadix2CopyUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> output(fft_like_size);
   AlignedVector64<std::complex<double>> input(fft_like_size);
@@ -329,7 +348,7 @@ static void BM_InvFFTLikeNativeRadix2CopyScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double inv_scale = 1.0 / scale;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<std::complex<double>> output(fft_like_size);
   AlignedVector64<std::complex<double>> input(fft_like_size);
@@ -363,7 +382,7 @@ static void BM_FwdFFTLikeAVX512InPlaceUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> input(2 * fft_like_size);
   input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
@@ -393,7 +412,7 @@ static void BM_FwdFFTLikeAVX512InPlaceScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double scalar = scale / static_cast<double>(fft_like_size);
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> input(2 * fft_like_size);
   input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
@@ -421,7 +440,7 @@ static void BM_FwdFFTLikeAVX512CopyUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> output(2 * fft_like_size);
   AlignedVector64<double> input(2 * fft_like_size);
@@ -450,7 +469,7 @@ static void BM_FwdFFTLikeAVX512CopyScaled(benchmark::State& state) {  //  NOLINT
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double scalar = scale / static_cast<double>(fft_like_size);
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> output(2 * fft_like_size);
   AlignedVector64<double> input(2 * fft_like_size);
@@ -479,7 +498,7 @@ static void BM_InvFFTLikeAVX512InPlaceUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> input(2 * fft_like_size);
   input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
@@ -508,7 +527,7 @@ static void BM_InvFFTLikeAVX512InPlaceScaled(
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double inv_scale = 1.0 / scale;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> input(2 * fft_like_size);
   input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
@@ -536,7 +555,7 @@ static void BM_InvFFTLikeAVX512CopyUnscaled(
     benchmark::State& state) {  //  NOLINT
   const size_t fft_like_size = state.range(0);
   const size_t bound = 1 << 30;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> output(2 * fft_like_size);
   AlignedVector64<double> input(2 * fft_like_size);
@@ -565,7 +584,7 @@ static void BM_InvFFTLikeAVX512CopyScaled(benchmark::State& state) {  //  NOLINT
   const size_t bound = 1 << 30;
   const double scale = 1.3611294676837539e+39;  // (1 << 130)
   const double inv_scale = 1.0 / scale;
-  FFTLike fft_like(fft_like_size, nullptr);
+  FFTLike fft_like(fft_like_size);
 
   AlignedVector64<double> output(2 * fft_like_size);
   AlignedVector64<double> input(2 * fft_like_size);
@@ -590,6 +609,774 @@ BENCHMARK(BM_InvFFTLikeAVX512CopyScaled)
 
 #endif
 
+// Radix-4 transforms
+//=================================================================
+
+static void BM_FwdFFTLikeNativeRadix4Copy(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t bound = 1 << 30;
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < fft_like_size; i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(0, bound),
+                             GenerateInsecureUniformRealRandomValue(0, bound));
+  }
+
+  AlignedVector64<std::complex<double>> root_powers =
+      fft_like.GetComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Forward_FFTLike_ToBitReverseRadix4(output.data(), input.data(),
+                                       root_powers.data(), fft_like_size);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeNativeRadix4Copy)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({32768});
+
+//=================================================================
+
+static void BM_InvFFTLikeNativeRadix4Copy(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t bound = 1 << 30;
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < fft_like_size; i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(0, bound),
+                             GenerateInsecureUniformRealRandomValue(0, bound));
+  }
+
+  AlignedVector64<std::complex<double>> inv_root_powers =
+      fft_like.GetInvComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Inverse_FFTLike_FromBitReverseRadix4(output.data(), input.data(),
+                                         inv_root_powers.data(), fft_like_size);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeNativeRadix4Copy)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({32768});
+
+//=================================================================
+
+#ifdef HEXL_HAS_AVX512DQ
+
+static void BM_FwdFFTLikeAVX512Radix4Copy(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t bound = 1 << 30;
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<double> output(2 * fft_like_size);
+  AlignedVector64<double> input(2 * fft_like_size);
+  input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
+
+  AlignedVector64<std::complex<double>> root_powers =
+      fft_like.GetComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Forward_FFTLike_ToBitReverseRadix4AVX512(
+        output.data(), input.data(),
+        &reinterpret_cast<double(&)[2]>(root_powers[0])[0], fft_like_size);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeAVX512Radix4Copy)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({32768});
+
+//=================================================================
+
+static void BM_InvFFTLikeAVX512Radix4Copy(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t bound = 1 << 30;
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<double> output(2 * fft_like_size);
+  AlignedVector64<double> input(2 * fft_like_size);
+  input = GenerateInsecureUniformRealRandomValues(2 * fft_like_size, 0, bound);
+
+  AlignedVector64<std::complex<double>> inv_root_powers =
+      fft_like.GetInvComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Inverse_FFTLike_FromBitReverseRadix4AVX512(
+        output.data(), input.data(),
+        &reinterpret_cast<double(&)[2]>(inv_root_powers[0])[0], fft_like_size);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeAVX512Radix4Copy)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({32768});
+
+#endif
+
+// Batched transforms
+//=================================================================
+
+static void BM_FwdFFTLikeNativeRadix2Loop(
+    benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  AlignedVector64<std::complex<double>> root_powers =
+      fft_like.GetComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    for (size_t b = 0; b < batch_size; b++) {
+      Forward_FFTLike_ToBitReverseRadix2(
+          output.data() + b * fft_like_size, input.data() + b * fft_like_size,
+          root_powers.data(), fft_like_size);
+    }
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeNativeRadix2Loop)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {4, 16}});
+
+//=================================================================
+
+static void BM_FwdFFTLikeNativeRadix2Batch(
+    benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  AlignedVector64<std::complex<double>> root_powers =
+      fft_like.GetComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Forward_FFTLike_ToBitReverseRadix2Batch(output.data(), input.data(),
+                                           root_powers.data(), fft_like_size,
+                                           batch_size);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeNativeRadix2Batch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {4, 16}});
+
+//=================================================================
+
+static void BM_InvFFTLikeNativeRadix2Loop(
+    benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  AlignedVector64<std::complex<double>> inv_root_powers =
+      fft_like.GetInvComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    for (size_t b = 0; b < batch_size; b++) {
+      Inverse_FFTLike_FromBitReverseRadix2(
+          output.data() + b * fft_like_size, input.data() + b * fft_like_size,
+          inv_root_powers.data(), fft_like_size);
+    }
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeNativeRadix2Loop)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {4, 16}});
+
+//=================================================================
+
+static void BM_InvFFTLikeNativeRadix2Batch(
+    benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  AlignedVector64<std::complex<double>> inv_root_powers =
+      fft_like.GetInvComplexRootsOfUnity();
+
+  for (auto _ : state) {
+    Inverse_FFTLike_FromBitReverseRadix2Batch(
+        output.data(), input.data(), inv_root_powers.data(), fft_like_size,
+        batch_size);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeNativeRadix2Batch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {4, 16}});
+
+//=================================================================
+
+static void BM_FwdFFTLikeLoop(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  for (auto _ : state) {
+    for (size_t b = 0; b < batch_size; b++) {
+      fft_like.ComputeForwardFFTLike(output.data() + b * fft_like_size,
+                                     input.data() + b * fft_like_size);
+    }
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeLoop)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {64}});
+
+//=================================================================
+
+static void BM_FwdFFTLikeBatch(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  const size_t num_threads = state.range(2);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  SetFFTLikeNumThreads(num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLikeBatch(output.data(), input.data(),
+                                        batch_size);
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+BENCHMARK(BM_FwdFFTLikeBatch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {64}, {1, 2, 4}});
+
+//=================================================================
+
+static void BM_InvFFTLikeLoop(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  for (auto _ : state) {
+    for (size_t b = 0; b < batch_size; b++) {
+      fft_like.ComputeInverseFFTLike(output.data() + b * fft_like_size,
+                                     input.data() + b * fft_like_size);
+    }
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeLoop)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {64}});
+
+//=================================================================
+
+static void BM_InvFFTLikeBatch(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  const size_t num_threads = state.range(2);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(batch_size * fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(batch_size * fft_like_size);
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  SetFFTLikeNumThreads(num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLikeBatch(output.data(), input.data(),
+                                        batch_size);
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+BENCHMARK(BM_InvFFTLikeBatch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {64}, {1, 2, 4}});
+
+//=================================================================
+
+// Multi-threaded transforms
+//=================================================================
+
+static void BM_FwdFFTLikeThreads(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t num_threads = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  SetFFTLikeNumThreads(num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLike(output.data(), input.data());
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+BENCHMARK(BM_FwdFFTLikeThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->ArgsProduct({{32768, 65536, 131072}, {1, 2, 4, 8}});
+
+//=================================================================
+
+static void BM_InvFFTLikeThreads(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t num_threads = state.range(1);
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  SetFFTLikeNumThreads(num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLike(output.data(), input.data());
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+BENCHMARK(BM_InvFFTLikeThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->ArgsProduct({{32768, 65536, 131072}, {1, 2, 4, 8}});
+
+//=================================================================
+
+// Single and mixed precision transforms, against the double precision ones
+//=================================================================
+
+static void BM_FwdFFTLikeDouble(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1.0 / 1099511627776.0;  // 1 / (1 << 40)
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLike(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeDouble)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+static void BM_FwdFFTLikeFloat(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const float scale = 1.0f / 1048576.0f;  // 1 / (1 << 20)
+  FFTLikeFloat fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<float>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<float>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                            GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<float>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLike(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeFloat)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+static void BM_FwdFFTLikeMixed(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1.0 / 1099511627776.0;  // 1 / (1 << 40)
+  FFTLikeFloat fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLikeMixed(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeMixed)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+static void BM_InvFFTLikeDouble(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale =
+      1099511627776.0 / static_cast<double>(fft_like_size);  // (1 << 40) / N
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLike(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeDouble)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+static void BM_InvFFTLikeFloat(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const float scale = 1048576.0f / static_cast<float>(fft_like_size);
+  FFTLikeFloat fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<float>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<float>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                            GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<float>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLike(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeFloat)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+static void BM_InvFFTLikeMixed(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale =
+      1099511627776.0 / static_cast<double>(fft_like_size);  // (1 << 40) / N
+  FFTLikeFloat fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLikeMixed(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeMixed)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
+// CKKS slot transforms, against the full transforms with the slot
+// permutation as a separate pass
+//=================================================================
+
+static void BM_FwdFFTLikeGatherSlots(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1.0 / 1099511627776.0;  // 1 / (1 << 40)
+  FFTLike fft_like(fft_like_size);
+  const uint64_t* slot_positions = fft_like.GetSlotPositions().data();
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1), 0);
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+  AlignedVector64<std::complex<double>> slots(fft_like_size / 2);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLike(output.data(), input.data(), &scale);
+    for (size_t i = 0; i < slots.size(); i++) {
+      slots[i] = output[slot_positions[i]];
+    }
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeGatherSlots)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+static void BM_FwdFFTLikeToSlots(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1.0 / 1099511627776.0;  // 1 / (1 << 40)
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1), 0);
+  }
+  AlignedVector64<std::complex<double>> slots(fft_like_size / 2);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLikeToSlots(slots.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeToSlots)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+static void BM_InvFFTLikeScatterSlots(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1099511627776.0 / fft_like_size;  // (1 << 40) / N
+  FFTLike fft_like(fft_like_size);
+  const uint64_t* slot_index = fft_like.GetSlotIndex().data();
+
+  AlignedVector64<std::complex<double>> slots(fft_like_size / 2);
+  for (size_t i = 0; i < slots.size(); i++) {
+    slots[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> input(fft_like_size);
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    for (size_t j = 0; j < slots.size(); j++) {
+      input[j] = slots[slot_index[j]];
+      input[fft_like_size - 1 - j] = std::conj(slots[slot_index[j]]);
+    }
+    fft_like.ComputeInverseFFTLike(output.data(), input.data(), &scale);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeScatterSlots)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+static void BM_InvFFTLikeFromSlots(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const double scale = 1099511627776.0 / fft_like_size;  // (1 << 40) / N
+  FFTLike fft_like(fft_like_size);
+
+  AlignedVector64<std::complex<double>> slots(fft_like_size / 2);
+  for (size_t i = 0; i < slots.size(); i++) {
+    slots[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<std::complex<double>> output(fft_like_size);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLikeFromSlots(output.data(), slots.data(),
+                                            &scale);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeFromSlots)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+// CKKS encoding
+//=================================================================
+
+static void BM_EncodeCKKS(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t num_moduli = state.range(1);
+  const double scale = 1099511627776.0;  // (1 << 40)
+  FFTLike fft_like(fft_like_size);
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_moduli, 50, true, fft_like_size);
+
+  AlignedVector64<std::complex<double>> values(fft_like_size);
+  for (size_t i = 0; i < fft_like_size; i++) {
+    values[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                             GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  AlignedVector64<uint64_t> result(fft_like_size * num_moduli);
+
+  for (auto _ : state) {
+    EncodeCKKS(result.data(), values.data(), fft_like, scale, moduli.data(),
+               num_moduli);
+  }
+}
+
+BENCHMARK(BM_EncodeCKKS)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {3, 8}});
+
+//=================================================================
+
+static void BM_DecodeCKKS(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t num_moduli = state.range(1);
+  const double scale = 1099511627776.0;  // (1 << 40)
+  FFTLike fft_like(fft_like_size);
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_moduli, 50, true, fft_like_size);
+
+  AlignedVector64<uint64_t> plain(fft_like_size * num_moduli);
+  for (size_t k = 0; k < num_moduli; k++) {
+    for (size_t i = 0; i < fft_like_size; i++) {
+      plain[k * fft_like_size + i] =
+          GenerateInsecureUniformIntRandomValue(0, moduli[k]);
+    }
+  }
+  AlignedVector64<std::complex<double>> result(fft_like_size);
+
+  for (auto _ : state) {
+    DecodeCKKS(result.data(), plain.data(), fft_like, scale, moduli.data(),
+               num_moduli);
+  }
+}
+
+BENCHMARK(BM_DecodeCKKS)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384, 32768}, {3, 8}});
+
 //=================================================================
 
 }  // namespace hexl
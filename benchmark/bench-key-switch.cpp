@@ -0,0 +1,232 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+#include "hexl/experimental/seal/hybrid-key-switch.hpp"
+#include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Random KeySwitch inputs for batch_size ciphertexts sharing one key
+struct KeySwitchInputs {
+  KeySwitchInputs(size_t n, size_t decomp_modulus_size,
+                  size_t key_component_count, size_t batch_size)
+      : n(n),
+        decomp_modulus_size(decomp_modulus_size),
+        key_modulus_size(decomp_modulus_size + 1),
+        rns_modulus_size(decomp_modulus_size + 1),
+        key_component_count(key_component_count),
+        moduli(GeneratePrimes(key_modulus_size, 50, true, n)),
+        key_vector(decomp_modulus_size),
+        t_target(batch_size),
+        input(batch_size) {
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      modswitch_factors.push_back(
+          InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+    }
+    for (auto& each_key : key_vector) {
+      for (size_t k = 0; k < key_component_count; ++k) {
+        for (size_t i = 0; i < key_modulus_size; ++i) {
+          auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+          each_key.insert(each_key.end(), limb.begin(), limb.end());
+        }
+      }
+      key_ptrs.push_back(each_key.data());
+    }
+    for (size_t b = 0; b < batch_size; ++b) {
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+        t_target[b].insert(t_target[b].end(), limb.begin(), limb.end());
+      }
+      input[b].resize(n * decomp_modulus_size * key_component_count, 0);
+      target_ptrs.push_back(t_target[b].data());
+      input_ptrs.push_back(input[b].data());
+    }
+  }
+
+  size_t n;
+  size_t decomp_modulus_size;
+  size_t key_modulus_size;
+  size_t rns_modulus_size;
+  size_t key_component_count;
+  std::vector<uint64_t> moduli;
+  std::vector<uint64_t> modswitch_factors;
+  std::vector<std::vector<uint64_t>> key_vector;
+  std::vector<const uint64_t*> key_ptrs;
+  std::vector<std::vector<uint64_t>> t_target;
+  std::vector<std::vector<uint64_t>> input;
+  std::vector<const uint64_t*> target_ptrs;
+  std::vector<uint64_t*> input_ptrs;
+};
+
+constexpr size_t kKeySwitchBenchBatch = 16;
+
+// Bytes one KeySwitch of a single ciphertext streams through memory: the key
+// limbs it reads, the target and the read-modify-write of the output
+int64_t KeySwitchBytes(size_t n, size_t decomp_modulus_size,
+                       size_t rns_modulus_size, size_t key_component_count) {
+  size_t key_limbs = decomp_modulus_size * key_component_count *
+                     rns_modulus_size;
+  size_t output_limbs = 2 * key_component_count * decomp_modulus_size;
+  return static_cast<int64_t>((key_limbs + decomp_modulus_size +
+                               output_limbs) *
+                              n * sizeof(uint64_t));
+}
+
+// Degree and decomp_modulus_size pairs in the range of SEAL parameter sets,
+// each with 1 to 4 key components
+void SEALKeySwitchArgs(benchmark::internal::Benchmark* b) {
+  const std::vector<std::pair<int64_t, int64_t>> params{
+      {4096, 3}, {8192, 3}, {8192, 8}, {16384, 8}, {32768, 8}, {32768, 20}};
+  for (const auto& param : params) {
+    for (int64_t key_component_count = 1; key_component_count <= 4;
+         ++key_component_count) {
+      b->Args({param.first, param.second, key_component_count});
+    }
+  }
+}
+
+}  // namespace
+
+// state[0] is the degree
+// state[1] is the decomp_modulus_size
+// state[2] is the key_component_count
+static void BM_KeySwitch(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  size_t key_component_count = state.range(2);
+  KeySwitchInputs in(n, decomp_modulus_size, key_component_count, 1);
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, key_component_count);
+
+  for (auto _ : state) {
+    KeySwitch(in.input_ptrs[0], in.target_ptrs[0], n, decomp_modulus_size,
+              in.key_modulus_size, in.rns_modulus_size, key_component_count,
+              in.moduli.data(), in.key_ptrs.data(),
+              in.modswitch_factors.data(), workspace);
+  }
+  state.SetBytesProcessed(
+      state.iterations() * KeySwitchBytes(n, decomp_modulus_size,
+                                          in.rns_modulus_size,
+                                          key_component_count));
+}
+
+BENCHMARK(BM_KeySwitch)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(SEALKeySwitchArgs);
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the decomp_modulus_size
+static void BM_KeySwitchSequential(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  KeySwitchInputs in(n, decomp_modulus_size, 2, kKeySwitchBenchBatch);
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, in.key_component_count);
+
+  for (auto _ : state) {
+    for (size_t b = 0; b < kKeySwitchBenchBatch; ++b) {
+      KeySwitch(in.input_ptrs[b], in.target_ptrs[b], n, decomp_modulus_size,
+                in.key_modulus_size, in.rns_modulus_size,
+                in.key_component_count, in.moduli.data(), in.key_ptrs.data(),
+                in.modswitch_factors.data(), workspace);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kKeySwitchBenchBatch);
+  state.SetBytesProcessed(state.iterations() * kKeySwitchBenchBatch *
+                          KeySwitchBytes(n, decomp_modulus_size,
+                                         in.rns_modulus_size,
+                                         in.key_component_count));
+}
+
+BENCHMARK(BM_KeySwitchSequential)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgsProduct({{8192, 32768}, {8, 16}});
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the decomp_modulus_size
+// state[2] is the number of ciphertexts per pass over the key
+static void BM_KeySwitchBatch(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  size_t batch_size = state.range(2);
+  KeySwitchInputs in(n, decomp_modulus_size, 2, kKeySwitchBenchBatch);
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, in.key_component_count,
+                               batch_size);
+
+  for (auto _ : state) {
+    KeySwitchBatch(in.input_ptrs.data(), in.target_ptrs.data(),
+                   kKeySwitchBenchBatch, n, decomp_modulus_size,
+                   in.key_modulus_size, in.rns_modulus_size,
+                   in.key_component_count, in.moduli.data(),
+                   in.key_ptrs.data(), in.modswitch_factors.data(), workspace);
+  }
+  state.SetItemsProcessed(state.iterations() * kKeySwitchBenchBatch);
+  state.SetBytesProcessed(state.iterations() * kKeySwitchBenchBatch *
+                          KeySwitchBytes(n, decomp_modulus_size,
+                                         in.rns_modulus_size,
+                                         in.key_component_count));
+}
+
+BENCHMARK(BM_KeySwitchBatch)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgsProduct({{8192, 32768}, {8, 16}, {1, 2, 4, 8}});
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the decomp_modulus_size
+// state[2] is the digit size, which is also the number of special primes
+static void BM_HybridKeySwitch(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  size_t digit_size = state.range(2);
+  size_t key_component_count = 2;
+  size_t key_modulus_size = decomp_modulus_size + digit_size;
+  std::vector<uint64_t> moduli = GeneratePrimes(key_modulus_size, 50, true, n);
+  HybridKeySwitcher switcher(n, moduli, digit_size, digit_size);
+
+  std::vector<std::vector<uint64_t>> key_vector(
+      switcher.NumDigits(decomp_modulus_size));
+  std::vector<const uint64_t*> key_ptrs;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    key_ptrs.push_back(each_key.data());
+  }
+  std::vector<uint64_t> t_target;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    t_target.insert(t_target.end(), limb.begin(), limb.end());
+  }
+  std::vector<uint64_t> output(n * decomp_modulus_size * key_component_count,
+                               0);
+
+  for (auto _ : state) {
+    switcher.KeySwitch(output.data(), t_target.data(), decomp_modulus_size,
+                       key_component_count, key_ptrs.data());
+  }
+}
+
+BENCHMARK(BM_HybridKeySwitch)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgsProduct({{8192, 32768}, {8, 16}, {1, 4, 8}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,56 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/misc/lr-mat-vec-mult.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+// state[1] is the number of moduli
+// state[2] is the number of weights
+static void BM_LinRegMatrixVectorMultiply(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t num_weights = state.range(2);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  size_t cipher_size = 2 * n * num_moduli;
+  AlignedVector64<uint64_t> operand1(num_weights * cipher_size);
+  AlignedVector64<uint64_t> operand2(num_weights * cipher_size);
+  for (size_t r = 0; r < 2 * num_weights; ++r) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      auto limb1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto limb2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      size_t offset = (r * num_moduli + i) * n;
+      std::copy(limb1.begin(), limb1.end(), &operand1[offset]);
+      std::copy(limb2.begin(), limb2.end(), &operand2[offset]);
+    }
+  }
+  AlignedVector64<uint64_t> result(num_weights * 3 * n * num_moduli);
+
+  for (auto _ : state) {
+    LinRegMatrixVectorMultiply(result.data(), operand1.data(),
+                               operand2.data(), n, moduli.data(), num_moduli,
+                               num_weights);
+  }
+  // Each call reads both operands and writes the result once
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * num_weights * 7 * n *
+                           num_moduli * sizeof(uint64_t)));
+}
+
+BENCHMARK(BM_LinRegMatrixVectorMultiply)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 8192, 16384, 32768}, {3, 8, 20}, {4, 16}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,50 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/rns-rescale.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+// state[1] is the number of moduli, including the one to drop
+// state[2] is whether the input is in NTT form
+static void BM_RNSRescale(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  bool ntt_form = state.range(2);
+
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+  std::vector<uint64_t> inv_qk_mod_qi;
+  for (size_t i = 0; i + 1 < num_moduli; ++i) {
+    inv_qk_mod_qi.push_back(InverseMod(moduli.back() % moduli[i], moduli[i]));
+  }
+
+  AlignedVector64<uint64_t> input(n * num_moduli);
+  for (size_t i = 0; i < num_moduli; ++i) {
+    auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    std::copy(limb.begin(), limb.end(), &input[i * n]);
+  }
+  AlignedVector64<uint64_t> output(n * (num_moduli - 1));
+  AlignedVector64<uint64_t> scratch(n * num_moduli);
+
+  for (auto _ : state) {
+    RNSRescale(output.data(), input.data(), n, num_moduli, moduli.data(),
+               inv_qk_mod_qi.data(), ntt_form, 1, scratch.data());
+  }
+}
+
+BENCHMARK(BM_RNSRescale)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 32768}, {4, 17}, {false, true}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,167 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+template uint64_t EltwiseDotProductModAVX512DQ<1>(const uint64_t* operand1,
+                                                  const uint64_t* operand2,
+                                                  uint64_t n, uint64_t modulus);
+template uint64_t EltwiseDotProductModAVX512DQ<2>(const uint64_t* operand1,
+                                                  const uint64_t* operand2,
+                                                  uint64_t n, uint64_t modulus);
+template uint64_t EltwiseDotProductModAVX512DQ<4>(const uint64_t* operand1,
+                                                  const uint64_t* operand2,
+                                                  uint64_t n, uint64_t modulus);
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+uint64_t EltwiseDotProductModAVX512IFMA(const uint64_t* operand1,
+                                        const uint64_t* operand2, uint64_t n,
+                                        uint64_t modulus) {
+  HEXL_CHECK(modulus < (1ULL << 52), "Require modulus < 2^52");
+  HEXL_CHECK_BOUNDS(operand1, n, MaximumValue(52),
+                    "operand1 exceeds bound " << MaximumValue(52));
+  HEXL_CHECK_BOUNDS(operand2, n, MaximumValue(52),
+                    "operand2 exceeds bound " << MaximumValue(52));
+
+  // Each fused multiply-add adds a value < 2^52 to the 64-bit lane
+  // accumulators, so we may accumulate 2^11 products before flushing.
+  constexpr uint64_t kFlushInterval = 1ULL << 11;
+
+  uint64_t acc_hi = 0;
+  uint64_t acc_lo = 0;
+
+  // Inputs need not be reduced, so the high word of each product is reduced
+  // before accumulation
+  uint64_t n_mod_8 = n % 8;
+  for (size_t i = 0; i < n_mod_8; ++i) {
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(operand1[i], operand2[i], &prod_hi, &prod_lo);
+    AccumulateLazy128(&acc_hi, &acc_lo, prod_hi % modulus, prod_lo, modulus);
+  }
+  operand1 += n_mod_8;
+  operand2 += n_mod_8;
+  n -= n_mod_8;
+
+  __m512i v_acc_hi = _mm512_setzero_si512();
+  __m512i v_acc_lo = _mm512_setzero_si512();
+
+  // Adds the 104-bit lane sums acc_hi * 2^52 + acc_lo to the scalar lazy
+  // accumulator
+  auto flush = [&]() {
+    uint64_t lane_hi[8];
+    uint64_t lane_lo[8];
+    _mm512_storeu_si512(lane_hi, v_acc_hi);
+    _mm512_storeu_si512(lane_lo, v_acc_lo);
+    for (size_t j = 0; j < 8; ++j) {
+      uint64_t add_lo = lane_hi[j] << 52;
+      uint64_t add_hi = lane_hi[j] >> 12;
+      add_lo += lane_lo[j];
+      add_hi += static_cast<uint64_t>(add_lo < lane_lo[j]);
+      AccumulateLazy128(&acc_hi, &acc_lo, add_hi % modulus, add_lo, modulus);
+    }
+    v_acc_hi = _mm512_setzero_si512();
+    v_acc_lo = _mm512_setzero_si512();
+  };
+
+  const __m512i* vp_operand1 = reinterpret_cast<const __m512i*>(operand1);
+  const __m512i* vp_operand2 = reinterpret_cast<const __m512i*>(operand2);
+
+  uint64_t num_vectors = n / 8;
+  while (num_vectors > 0) {
+    uint64_t block = std::min(num_vectors, kFlushInterval);
+    for (size_t i = 0; i < block; ++i) {
+      __m512i v_operand1 = _mm512_loadu_si512(vp_operand1++);
+      __m512i v_operand2 = _mm512_loadu_si512(vp_operand2++);
+      v_acc_lo = _mm512_madd52lo_epu64(v_acc_lo, v_operand1, v_operand2);
+      v_acc_hi = _mm512_madd52hi_epu64(v_acc_hi, v_operand1, v_operand2);
+    }
+    flush();
+    num_vectors -= block;
+  }
+
+  return BarrettReduce128(acc_hi, acc_lo, modulus);
+}
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+template <int InputModFactor>
+uint64_t EltwiseDotProductModAVX512DQ(const uint64_t* operand1,
+                                      const uint64_t* operand2, uint64_t n,
+                                      uint64_t modulus) {
+  HEXL_CHECK(InputModFactor * modulus < (1ULL << 63),
+             "InputModFactor * modulus exceeds 2^63");
+  HEXL_CHECK_BOUNDS(operand1, n, InputModFactor * modulus,
+                    "operand1 exceeds bound " << (InputModFactor * modulus));
+  HEXL_CHECK_BOUNDS(operand2, n, InputModFactor * modulus,
+                    "operand2 exceeds bound " << (InputModFactor * modulus));
+
+  uint64_t tail = 0;
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    tail = EltwiseDotProductModNative<InputModFactor>(operand1, operand2,
+                                                      n_mod_8, modulus);
+    operand1 += n_mod_8;
+    operand2 += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(2 * modulus));
+  __m512i v_one = _mm512_set1_epi64(1);
+
+  // Per-lane lazy 128-bit accumulators; v_acc_hi is kept in [0, modulus)
+  __m512i v_acc_hi = _mm512_setzero_si512();
+  __m512i v_acc_lo = _mm512_setzero_si512();
+
+  const __m512i* vp_operand1 = reinterpret_cast<const __m512i*>(operand1);
+  const __m512i* vp_operand2 = reinterpret_cast<const __m512i*>(operand2);
+
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_operand1 = _mm512_loadu_si512(vp_operand1++);
+    __m512i v_operand2 = _mm512_loadu_si512(vp_operand2++);
+    v_operand1 = _mm512_hexl_small_mod_epu64<InputModFactor>(
+        v_operand1, v_modulus, &v_twice_mod);
+    v_operand2 = _mm512_hexl_small_mod_epu64<InputModFactor>(
+        v_operand2, v_modulus, &v_twice_mod);
+
+    __m512i v_prod_hi = _mm512_hexl_mulhi_epi<64>(v_operand1, v_operand2);
+    __m512i v_prod_lo = _mm512_hexl_mullo_epi<64>(v_operand1, v_operand2);
+
+    v_acc_lo = _mm512_add_epi64(v_acc_lo, v_prod_lo);
+    __mmask8 carry = _mm512_cmplt_epu64_mask(v_acc_lo, v_prod_lo);
+    v_acc_hi = _mm512_add_epi64(v_acc_hi, v_prod_hi);
+    v_acc_hi = _mm512_mask_add_epi64(v_acc_hi, carry, v_acc_hi, v_one);
+    v_acc_hi = _mm512_hexl_small_mod_epu64(v_acc_hi, v_modulus);
+  }
+
+  uint64_t lane_hi[8];
+  uint64_t lane_lo[8];
+  _mm512_storeu_si512(lane_hi, v_acc_hi);
+  _mm512_storeu_si512(lane_lo, v_acc_lo);
+
+  uint64_t acc_hi = 0;
+  uint64_t acc_lo = 0;
+  for (size_t j = 0; j < 8; ++j) {
+    AccumulateLazy128(&acc_hi, &acc_lo, lane_hi[j], lane_lo[j], modulus);
+  }
+  return AddUIntMod(BarrettReduce128(acc_hi, acc_lo, modulus), tail, modulus);
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
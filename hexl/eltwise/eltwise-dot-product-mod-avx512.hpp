@@ -0,0 +1,30 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief Returns sum_i (operand1[i] * operand2[i]) mod modulus using the
+/// 52-bit fused multiply-add instructions of AVX512IFMA
+/// @details Requires all input elements to be less than 2^52
+uint64_t EltwiseDotProductModAVX512IFMA(const uint64_t* operand1,
+                                        const uint64_t* operand2, uint64_t n,
+                                        uint64_t modulus);
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief Returns sum_i (operand1[i] * operand2[i]) mod modulus using 64-bit
+/// AVX512DQ multiplications
+template <int InputModFactor>
+uint64_t EltwiseDotProductModAVX512DQ(const uint64_t* operand1,
+                                      const uint64_t* operand2, uint64_t n,
+                                      uint64_t modulus);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,45 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Returns sum_i (operand1[i] * operand2[i]) mod modulus
+/// @details Each product of reduced inputs is < q^2, so its high word is < q
+/// and the lazy 128-bit accumulator never overflows.
+template <int InputModFactor>
+uint64_t EltwiseDotProductModNative(const uint64_t* operand1,
+                                    const uint64_t* operand2, uint64_t n,
+                                    uint64_t modulus) {
+  HEXL_CHECK(InputModFactor * modulus < (1ULL << 63),
+             "InputModFactor * modulus exceeds 2^63");
+
+  const uint64_t twice_modulus = 2 * modulus;
+  uint64_t acc_hi = 0;
+  uint64_t acc_lo = 0;
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t x =
+        ReduceMod<InputModFactor>(operand1[i], modulus, &twice_modulus);
+    uint64_t y =
+        ReduceMod<InputModFactor>(operand2[i], modulus, &twice_modulus);
+
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(x, y, &prod_hi, &prod_lo);
+    AccumulateLazy128(&acc_hi, &acc_lo, prod_hi, prod_lo, modulus);
+  }
+  return BarrettReduce128(acc_hi, acc_lo, modulus);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,82 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+uint64_t EltwiseDotProductMod(const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t input_mod_factor) {
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "Require input_mod_factor = 1, 2, or 4")
+  HEXL_CHECK(input_mod_factor * modulus < (1ULL << 63),
+             "Require input_mod_factor * modulus < (1ULL << 63)");
+  HEXL_CHECK_BOUNDS(operand1, n, input_mod_factor * modulus,
+                    "operand1 exceeds bound " << (input_mod_factor * modulus))
+  HEXL_CHECK_BOUNDS(operand2, n, input_mod_factor * modulus,
+                    "operand2 exceeds bound " << (input_mod_factor * modulus))
+
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && input_mod_factor * modulus <= (1ULL << 52)) {
+    HEXL_VLOG(3, "Calling EltwiseDotProductModAVX512IFMA");
+    return EltwiseDotProductModAVX512IFMA(operand1, operand2, n, modulus);
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling EltwiseDotProductModAVX512DQ");
+    switch (input_mod_factor) {
+      case 1:
+        return EltwiseDotProductModAVX512DQ<1>(operand1, operand2, n, modulus);
+      case 2:
+        return EltwiseDotProductModAVX512DQ<2>(operand1, operand2, n, modulus);
+      case 4:
+        return EltwiseDotProductModAVX512DQ<4>(operand1, operand2, n, modulus);
+    }
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling EltwiseDotProductModNative");
+  switch (input_mod_factor) {
+    case 1:
+      return EltwiseDotProductModNative<1>(operand1, operand2, n, modulus);
+    case 2:
+      return EltwiseDotProductModNative<2>(operand1, operand2, n, modulus);
+    case 4:
+      return EltwiseDotProductModNative<4>(operand1, operand2, n, modulus);
+  }
+  HEXL_CHECK(false, "Invalid input_mod_factor " << input_mod_factor);
+  return 0;
+}
+
+void EltwiseDotProductMod(uint64_t* result, const uint64_t* operand1,
+                          const uint64_t* operand2, uint64_t n,
+                          const uint64_t* moduli, uint64_t num_moduli,
+                          uint64_t input_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+
+  for (size_t i = 0; i < num_moduli; ++i) {
+    result[i] = EltwiseDotProductMod(operand1 + i * n, operand2 + i * n, n,
+                                     moduli[i], input_mod_factor);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,6 +3,10 @@
 
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include "eltwise/eltwise-mult-mod-avx512.hpp"
 #include "eltwise/eltwise-mult-mod-internal.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
@@ -11,34 +15,25 @@
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/measure-algorithm.hpp"
 
 namespace intel {
 namespace hexl {
 
-void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
-                    const uint64_t* operand2, uint64_t n, uint64_t modulus,
-                    uint64_t input_mod_factor) {
-  HEXL_CHECK(result != nullptr, "Require result != nullptr");
-  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
-  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
-  HEXL_CHECK(n != 0, "Require n != 0");
-  HEXL_CHECK(modulus > 1, "Require modulus > 1");
-  HEXL_CHECK(input_mod_factor * modulus < (1ULL << 63),
-             "Require input_mod_factor * modulus < (1ULL << 63)");
-  HEXL_CHECK(
-      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
-      "Require input_mod_factor = 1, 2, or 4")
-  HEXL_CHECK_BOUNDS(operand1, n, input_mod_factor * modulus,
-                    "operand1 exceeds bound " << (input_mod_factor * modulus))
-  HEXL_CHECK_BOUNDS(operand2, n, input_mod_factor * modulus,
-                    "operand2 exceeds bound " << (input_mod_factor * modulus))
+namespace {
 
+std::atomic<EltwiseMultModAlgorithm> eltwise_mult_mod_algorithm{
+    EltwiseMultModAlgorithm::kAuto};
+
+// Runs the given kernel, which must be supported for the modulus
+void EltwiseMultModKernel(EltwiseMultModAlgorithm algorithm, uint64_t* result,
+                          const uint64_t* operand1, const uint64_t* operand2,
+                          uint64_t n, uint64_t modulus,
+                          uint64_t input_mod_factor) {
+  switch (algorithm) {
 #ifdef HEXL_HAS_AVX512DQ
-  if (has_avx512dq) {
-    if (modulus < (1ULL << 50)) {
-      // EltwiseMultModAVX512IFMA has similar performance to
-      // EltwiseMultModAVX512Float, but requires the AVX512IFMA instruction set,
-      // so we prefer to use EltwiseMultModAVX512Float.
+    case EltwiseMultModAlgorithm::kAVX512Float:
+      HEXL_VLOG(3, "Calling EltwiseMultModAVX512Float");
       switch (input_mod_factor) {
         case 1:
           EltwiseMultModAVX512Float<1>(result, operand1, operand2, n, modulus);
@@ -50,7 +45,9 @@ void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
           EltwiseMultModAVX512Float<4>(result, operand1, operand2, n, modulus);
           break;
       }
-    } else {
+      return;
+    case EltwiseMultModAlgorithm::kAVX512DQInt:
+      HEXL_VLOG(3, "Calling EltwiseMultModAVX512DQInt");
       switch (input_mod_factor) {
         case 1:
           EltwiseMultModAVX512DQInt<1>(result, operand1, operand2, n, modulus);
@@ -62,10 +59,30 @@ void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
           EltwiseMultModAVX512DQInt<4>(result, operand1, operand2, n, modulus);
           break;
       }
-    }
-    return;
-  }
+      return;
+#endif
+#ifdef HEXL_HAS_AVX512IFMA
+    case EltwiseMultModAlgorithm::kAVX512IFMA:
+      HEXL_VLOG(3, "Calling EltwiseMultModAVX512IFMAInt");
+      switch (input_mod_factor) {
+        case 1:
+          EltwiseMultModAVX512IFMAInt<1>(result, operand1, operand2, n,
+                                         modulus);
+          break;
+        case 2:
+          EltwiseMultModAVX512IFMAInt<2>(result, operand1, operand2, n,
+                                         modulus);
+          break;
+        case 4:
+          EltwiseMultModAVX512IFMAInt<4>(result, operand1, operand2, n,
+                                         modulus);
+          break;
+      }
+      return;
 #endif
+    default:
+      break;
+  }
 
   HEXL_VLOG(3, "Calling EltwiseMultModNative");
   switch (input_mod_factor) {
@@ -79,7 +96,113 @@ void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
       EltwiseMultModNative<4>(result, operand1, operand2, n, modulus);
       break;
   }
-  return;
+}
+
+// Times each AVX512 kernel supported for moduli below 2^50 and returns the
+// fastest. Ties keep the earlier candidate, so kAVX512Float is preferred
+// when the timings are equal.
+EltwiseMultModAlgorithm MeasureSmallModulusAlgorithm(
+    const std::vector<EltwiseMultModAlgorithm>& candidates) {
+  constexpr uint64_t kNumElements = 4096;
+  const uint64_t modulus = (1ULL << 49) + 9;
+  AlignedVector64<uint64_t> operand1(kNumElements);
+  AlignedVector64<uint64_t> operand2(kNumElements);
+  AlignedVector64<uint64_t> result(kNumElements);
+  GenerateTimingOperands(operand1.data(), operand2.data(), kNumElements,
+                         modulus);
+
+  return MeasureFastestAlgorithm(
+      candidates, [&](EltwiseMultModAlgorithm candidate) {
+        EltwiseMultModKernel(candidate, result.data(), operand1.data(),
+                             operand2.data(), kNumElements, modulus, 1);
+      });
+}
+
+EltwiseMultModAlgorithm AutoEltwiseMultModAlgorithm(uint64_t modulus) {
+  if (modulus < (1ULL << 50)) {
+    // Support depends only on the CPU for moduli below 2^50
+    static const std::vector<EltwiseMultModAlgorithm> candidates = []() {
+      std::vector<EltwiseMultModAlgorithm> supported;
+      for (EltwiseMultModAlgorithm candidate :
+           {EltwiseMultModAlgorithm::kAVX512Float,
+            EltwiseMultModAlgorithm::kAVX512IFMA}) {
+        if (IsEltwiseMultModAlgorithmSupported(candidate, 2)) {
+          supported.push_back(candidate);
+        }
+      }
+      return supported;
+    }();
+    if (candidates.empty()) {
+      return EltwiseMultModAlgorithm::kNative;
+    }
+    static MeasuredAlgorithm<EltwiseMultModAlgorithm> small_modulus_algorithm;
+    return small_modulus_algorithm.Get(
+        candidates.front(),
+        []() { return MeasureSmallModulusAlgorithm(candidates); });
+  }
+  return IsEltwiseMultModAlgorithmSupported(
+             EltwiseMultModAlgorithm::kAVX512DQInt, modulus)
+             ? EltwiseMultModAlgorithm::kAVX512DQInt
+             : EltwiseMultModAlgorithm::kNative;
+}
+
+}  // namespace
+
+void SetEltwiseMultModAlgorithm(EltwiseMultModAlgorithm algorithm) {
+  eltwise_mult_mod_algorithm.store(algorithm);
+}
+
+EltwiseMultModAlgorithm GetEltwiseMultModAlgorithm() {
+  return eltwise_mult_mod_algorithm.load();
+}
+
+bool IsEltwiseMultModAlgorithmSupported(EltwiseMultModAlgorithm algorithm,
+                                        uint64_t modulus) {
+  HEXL_UNUSED(modulus);
+  switch (algorithm) {
+    case EltwiseMultModAlgorithm::kAuto:
+    case EltwiseMultModAlgorithm::kNative:
+      return true;
+#ifdef HEXL_HAS_AVX512DQ
+    case EltwiseMultModAlgorithm::kAVX512Float:
+      return has_avx512dq && modulus < (1ULL << 50);
+    case EltwiseMultModAlgorithm::kAVX512DQInt:
+      return has_avx512dq && modulus >= (1ULL << 50);
+#endif
+#ifdef HEXL_HAS_AVX512IFMA
+    case EltwiseMultModAlgorithm::kAVX512IFMA:
+      return has_avx512ifma && modulus < (1ULL << 50);
+#endif
+    default:
+      return false;
+  }
+}
+
+void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
+                    const uint64_t* operand2, uint64_t n, uint64_t modulus,
+                    uint64_t input_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(input_mod_factor * modulus < (1ULL << 63),
+             "Require input_mod_factor * modulus < (1ULL << 63)");
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "Require input_mod_factor = 1, 2, or 4")
+  HEXL_CHECK_BOUNDS(operand1, n, input_mod_factor * modulus,
+                    "operand1 exceeds bound " << (input_mod_factor * modulus))
+  HEXL_CHECK_BOUNDS(operand2, n, input_mod_factor * modulus,
+                    "operand2 exceeds bound " << (input_mod_factor * modulus))
+
+  EltwiseMultModAlgorithm algorithm = GetEltwiseMultModAlgorithm();
+  if (algorithm == EltwiseMultModAlgorithm::kAuto ||
+      !IsEltwiseMultModAlgorithmSupported(algorithm, modulus)) {
+    algorithm = AutoEltwiseMultModAlgorithm(modulus);
+  }
+  EltwiseMultModKernel(algorithm, result, operand1, operand2, n, modulus,
+                       input_mod_factor);
 }
 }  // namespace hexl
 }  // namespace intel
@@ -13,6 +13,76 @@ template void EltwiseReduceModAVX512<64>(uint64_t* result,
                                          uint64_t modulus,
                                          uint64_t input_mod_factor,
                                          uint64_t output_mod_factor);
+
+void EltwiseReduceMod128AVX512(uint64_t* result, const uint64_t* operand_hi,
+                               const uint64_t* operand_lo, uint64_t n,
+                               uint64_t modulus, uint64_t output_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand_hi != nullptr, "Require operand_hi != nullptr");
+  HEXL_CHECK(operand_lo != nullptr, "Require operand_lo != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 63), "Require modulus < 2^63");
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+
+  // Deals with n not divisible by 8
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    EltwiseReduceMod128Native(result, operand_hi, operand_lo, n_mod_8, modulus,
+                              output_mod_factor);
+    operand_hi += n_mod_8;
+    operand_lo += n_mod_8;
+    result += n_mod_8;
+    n -= n_mod_8;
+  }
+  if (n == 0) {
+    return;
+  }
+
+  // (hi * 2^64 + lo) mod q == (hi * (2^64 mod q) + lo) mod q
+  uint64_t two_pow_64_mod = BarrettReduce128(1, 0, modulus);
+  uint64_t two_pow_64_barrett =
+      MultiplyFactor(two_pow_64_mod, 64, modulus).BarrettFactor();
+  uint64_t barrett_factor = MultiplyFactor(1, 64, modulus).BarrettFactor();
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_neg_mod = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  __m512i v_w = _mm512_set1_epi64(static_cast<int64_t>(two_pow_64_mod));
+  __m512i v_w_barr =
+      _mm512_set1_epi64(static_cast<int64_t>(two_pow_64_barrett));
+  __m512i v_bf = _mm512_set1_epi64(static_cast<int64_t>(barrett_factor));
+
+  const __m512i* v_operand_hi = reinterpret_cast<const __m512i*>(operand_hi);
+  const __m512i* v_operand_lo = reinterpret_cast<const __m512i*>(operand_lo);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_hi = _mm512_loadu_si512(v_operand_hi);
+    __m512i v_lo = _mm512_loadu_si512(v_operand_lo);
+
+    // hi * (2^64 mod q) via Shoup multiplication, in [0, 2q)
+    __m512i v_q_hat = _mm512_hexl_mulhi_epi<64>(v_hi, v_w_barr);
+    __m512i v_prod = _mm512_hexl_mullo_epi<64>(v_hi, v_w);
+    v_prod = _mm512_hexl_mullo_add_lo_epi<64>(v_prod, v_q_hat, v_neg_mod);
+    v_prod = _mm512_hexl_small_mod_epu64(v_prod, v_modulus);
+
+    v_lo = _mm512_hexl_barrett_reduce64<64, 1>(v_lo, v_modulus, v_bf, v_bf, 0,
+                                               v_neg_mod);
+    __m512i v_sum = _mm512_add_epi64(v_prod, v_lo);
+    if (output_mod_factor == 1) {
+      v_sum = _mm512_hexl_small_mod_epu64(v_sum, v_modulus);
+    }
+    HEXL_CHECK_BOUNDS(ExtractValues(v_sum).data(), 8,
+                      output_mod_factor * modulus,
+                      "v_sum exceeds bound " << output_mod_factor * modulus);
+    _mm512_storeu_si512(v_result, v_sum);
+
+    ++v_operand_hi;
+    ++v_operand_lo;
+    ++v_result;
+  }
+}
 #endif
 
 #ifdef HEXL_HAS_AVX512IFMA
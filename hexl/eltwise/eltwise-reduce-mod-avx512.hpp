@@ -19,6 +19,26 @@ namespace intel {
 namespace hexl {
 
 #ifdef HEXL_HAS_AVX512DQ
+// Reduces n elements by conditionally subtracting each of v_multiples in turn.
+// NumSteps > 0 fixes the number of multiples at compile time so the ladder is
+// unrolled; NumSteps == 0 uses the run-time num_multiples.
+template <int NumSteps>
+inline void EltwiseReduceModLadderAVX512(__m512i* v_result,
+                                         const __m512i* v_operand, uint64_t n,
+                                         const __m512i* v_multiples,
+                                         int num_multiples) {
+  const int steps = NumSteps > 0 ? NumSteps : num_multiples;
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_op = _mm512_loadu_si512(v_operand);
+    for (int j = 0; j < steps; ++j) {
+      v_op = _mm512_hexl_small_mod_epu64(v_op, v_multiples[j]);
+    }
+    _mm512_storeu_si512(v_result, v_op);
+    ++v_operand;
+    ++v_result;
+  }
+}
+
 template <int BitShift = 64>
 void EltwiseReduceModAVX512(uint64_t* result, const uint64_t* operand,
                             uint64_t n, uint64_t modulus,
@@ -27,11 +47,12 @@ void EltwiseReduceModAVX512(uint64_t* result, const uint64_t* operand,
   HEXL_CHECK(operand != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
-  HEXL_CHECK(input_mod_factor == modulus || input_mod_factor == 2 ||
-                 input_mod_factor == 4,
-             "input_mod_factor must be modulus or 2 or 4" << input_mod_factor);
-  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
-             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+  HEXL_CHECK(input_mod_factor == modulus ||
+                 (IsPowerOfTwo(input_mod_factor) && input_mod_factor >= 2),
+             "input_mod_factor must be modulus or a power of two >= 2 "
+                 << input_mod_factor);
+  HEXL_CHECK(IsPowerOfTwo(output_mod_factor),
+             "output_mod_factor must be a power of two " << output_mod_factor);
   HEXL_CHECK(input_mod_factor != output_mod_factor,
              "input_mod_factor must not be equal to output_mod_factor ");
 
@@ -76,13 +97,13 @@ void EltwiseReduceModAVX512(uint64_t* result, const uint64_t* operand,
   __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(twice_mod));
 
   if (input_mod_factor == modulus) {
-    if (output_mod_factor == 2) {
+    if (output_mod_factor >= 2) {
       for (size_t i = 0; i < n_tmp; i += 8) {
         __m512i v_op = _mm512_loadu_si512(v_operand);
         v_op = _mm512_hexl_barrett_reduce64<BitShift, 2>(
             v_op, v_modulus, v_bf, v_bf_52, prod_right_shift, v_neg_mod);
-        HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 8, modulus,
-                          "v_op exceeds bound " << modulus);
+        HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 8, twice_mod,
+                          "v_op exceeds bound " << twice_mod);
         _mm512_storeu_si512(v_result, v_op);
         ++v_operand;
         ++v_result;
@@ -113,7 +134,7 @@ void EltwiseReduceModAVX512(uint64_t* result, const uint64_t* operand,
     }
   }
 
-  if (input_mod_factor == 4) {
+  if (input_mod_factor == 4 && output_mod_factor <= 2) {
     if (output_mod_factor == 1) {
       for (size_t i = 0; i < n_tmp; i += 8) {
         __m512i v_op = _mm512_loadu_si512(v_operand);
@@ -138,8 +159,45 @@ void EltwiseReduceModAVX512(uint64_t* result, const uint64_t* operand,
       }
     }
   }
+
+  if (input_mod_factor != modulus && input_mod_factor > 4) {
+    // Conditionally subtract input_mod_factor / 2 * q, ...,
+    // output_mod_factor * q
+    __m512i v_multiples[64];
+    int num_multiples = 0;
+    for (uint64_t f = input_mod_factor >> 1; f >= output_mod_factor; f >>= 1) {
+      v_multiples[num_multiples++] =
+          _mm512_set1_epi64(static_cast<int64_t>(f * modulus));
+    }
+    switch (num_multiples) {
+      case 1:
+        EltwiseReduceModLadderAVX512<1>(v_result, v_operand, n_tmp,
+                                        v_multiples, num_multiples);
+        break;
+      case 2:
+        EltwiseReduceModLadderAVX512<2>(v_result, v_operand, n_tmp,
+                                        v_multiples, num_multiples);
+        break;
+      case 3:
+        EltwiseReduceModLadderAVX512<3>(v_result, v_operand, n_tmp,
+                                        v_multiples, num_multiples);
+        break;
+      case 4:
+        EltwiseReduceModLadderAVX512<4>(v_result, v_operand, n_tmp,
+                                        v_multiples, num_multiples);
+        break;
+      default:
+        EltwiseReduceModLadderAVX512<0>(v_result, v_operand, n_tmp,
+                                        v_multiples, num_multiples);
+    }
+  }
 }
 
+/// @brief AVX512 implementation of EltwiseReduceMod128
+void EltwiseReduceMod128AVX512(uint64_t* result, const uint64_t* operand_hi,
+                               const uint64_t* operand_lo, uint64_t n,
+                               uint64_t modulus, uint64_t output_mod_factor);
+
 /// @brief Returns Montgomery form of modular product ab mod q, computed via the
 ///  REDC algorithm, also known as Montgomery reduction.
 /// @tparam BitShift denotes the operational length, in bits, of the operands
@@ -14,15 +14,27 @@ namespace hexl {
 // @param[in] n Number of elements in operand
 // @param[in] modulus Modulus with which to perform modular reduction
 // @param[in] input_mod_factor Assumes input elements are in [0,
-// input_mod_factor * p) Must be modulus, 2 or 4. input_mod_factor=modulus
-// means, input range is [0, p * p]. Barrett reduction will be used in this case
-// input_mod_factor > output_mod_factor
+// input_mod_factor * p) Must be modulus or a power of two >= 2.
+// input_mod_factor=modulus means, input range is [0, 2^64). Barrett reduction
+// will be used in this case input_mod_factor > output_mod_factor
 // @param[in] output_mod_factor output elements will be in [0, output_mod_factor
-// * p) Must be 1 or 2. for input_mod_factor=0, output_mod_factor will be set
-// to 1.
+// * p) Must be a power of two.
 void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
                             uint64_t n, uint64_t modulus,
                             uint64_t input_mod_factor,
                             uint64_t output_mod_factor);
+
+// @brief Performs elementwise modular reduction of 128-bit values
+// @param[out] result Stores result
+// @param[in] operand_hi High 64 bits of each element
+// @param[in] operand_lo Low 64 bits of each element
+// @param[in] n Number of elements in operand_hi and operand_lo
+// @param[in] modulus Modulus with which to perform modular reduction. Must be
+// less than 2^63
+// @param[in] output_mod_factor output elements will be in [0, output_mod_factor
+// * p) Must be 1 or 2.
+void EltwiseReduceMod128Native(uint64_t* result, const uint64_t* operand_hi,
+                               const uint64_t* operand_lo, uint64_t n,
+                               uint64_t modulus, uint64_t output_mod_factor);
 }  // namespace hexl
 }  // namespace intel
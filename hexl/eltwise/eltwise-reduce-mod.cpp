@@ -21,11 +21,12 @@ void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
-  HEXL_CHECK(input_mod_factor == modulus || input_mod_factor == 2 ||
-                 input_mod_factor == 4,
-             "input_mod_factor must be modulus or 2 or 4" << input_mod_factor);
-  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
-             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+  HEXL_CHECK(input_mod_factor == modulus ||
+                 (IsPowerOfTwo(input_mod_factor) && input_mod_factor >= 2),
+             "input_mod_factor must be modulus or a power of two >= 2 "
+                 << input_mod_factor);
+  HEXL_CHECK(IsPowerOfTwo(output_mod_factor),
+             "output_mod_factor must be a power of two " << output_mod_factor);
   HEXL_CHECK(input_mod_factor != output_mod_factor,
              "input_mod_factor must not be equal to output_mod_factor ");
 
@@ -33,7 +34,7 @@ void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
 
   uint64_t twice_modulus = modulus << 1;
   if (input_mod_factor == modulus) {
-    if (output_mod_factor == 2) {
+    if (output_mod_factor >= 2) {
       for (size_t i = 0; i < n; ++i) {
         if (operand[i] >= modulus) {
           result[i] = BarrettReduce64<2>(operand[i], modulus, barrett_factor);
@@ -61,7 +62,7 @@ void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
     HEXL_CHECK_BOUNDS(result, n, modulus, "result exceeds bound " << modulus);
   }
 
-  if (input_mod_factor == 4) {
+  if (input_mod_factor == 4 && output_mod_factor <= 2) {
     if (output_mod_factor == 1) {
       for (size_t i = 0; i < n; ++i) {
         result[i] = ReduceMod<4>(operand[i], modulus, &twice_modulus);
@@ -76,6 +77,56 @@ void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
                         "result exceeds bound " << twice_modulus);
     }
   }
+
+  if (input_mod_factor != modulus && input_mod_factor > 4) {
+    // Generic lazy range [0, input_mod_factor * q): conditionally subtract
+    // input_mod_factor / 2 * q, input_mod_factor / 4 * q, ...,
+    // output_mod_factor * q
+    uint64_t multiples[64];
+    size_t num_multiples = 0;
+    for (uint64_t f = input_mod_factor >> 1; f >= output_mod_factor; f >>= 1) {
+      multiples[num_multiples++] = f * modulus;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t x = operand[i];
+      for (size_t j = 0; j < num_multiples; ++j) {
+        x = (x >= multiples[j]) ? x - multiples[j] : x;
+      }
+      result[i] = x;
+    }
+    HEXL_CHECK_BOUNDS(result, n, output_mod_factor * modulus,
+                      "result exceeds bound " << output_mod_factor * modulus);
+  }
+}
+
+void EltwiseReduceMod128Native(uint64_t* result, const uint64_t* operand_hi,
+                               const uint64_t* operand_lo, uint64_t n,
+                               uint64_t modulus, uint64_t output_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand_hi != nullptr, "Require operand_hi != nullptr");
+  HEXL_CHECK(operand_lo != nullptr, "Require operand_lo != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 63), "Require modulus < 2^63");
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+
+  // (hi * 2^64 + lo) mod q == (hi * (2^64 mod q) + lo) mod q
+  uint64_t two_pow_64_mod = BarrettReduce128(1, 0, modulus);
+  uint64_t two_pow_64_barrett =
+      MultiplyFactor(two_pow_64_mod, 64, modulus).BarrettFactor();
+  uint64_t barrett_factor = MultiplyFactor(1, 64, modulus).BarrettFactor();
+
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t hi = MultiplyModLazy<64>(operand_hi[i], two_pow_64_mod,
+                                      two_pow_64_barrett, modulus);
+    hi = ReduceMod<2>(hi, modulus);
+    uint64_t lo = BarrettReduce64<1>(operand_lo[i], modulus, barrett_factor);
+    uint64_t sum = hi + lo;
+    result[i] = (output_mod_factor == 1) ? ReduceMod<2>(sum, modulus) : sum;
+  }
+  HEXL_CHECK_BOUNDS(result, n, output_mod_factor * modulus,
+                    "result exceeds bound " << output_mod_factor * modulus);
 }
 
 void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
@@ -85,11 +136,18 @@ void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
-  HEXL_CHECK(input_mod_factor == modulus || input_mod_factor == 2 ||
-                 input_mod_factor == 4,
-             "input_mod_factor must be modulus  or 2 or 4" << input_mod_factor);
-  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
-             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+  HEXL_CHECK(input_mod_factor == modulus ||
+                 (IsPowerOfTwo(input_mod_factor) && input_mod_factor >= 2),
+             "input_mod_factor must be modulus or a power of two >= 2 "
+                 << input_mod_factor);
+  HEXL_CHECK(input_mod_factor == modulus ||
+                 input_mod_factor / 2 <= (~0ULL) / modulus,
+             "input_mod_factor / 2 * modulus must fit in 64 bits");
+  HEXL_CHECK(IsPowerOfTwo(output_mod_factor),
+             "output_mod_factor must be a power of two " << output_mod_factor);
+  HEXL_CHECK(input_mod_factor == modulus ||
+                 output_mod_factor <= input_mod_factor,
+             "output_mod_factor must not exceed input_mod_factor");
 
   if (input_mod_factor == output_mod_factor && (operand != result)) {
     for (size_t i = 0; i < n; ++i) {
@@ -98,11 +156,20 @@ void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
     return;
   }
 
+  // Beyond a few conditional subtractions, a single Barrett reduction over
+  // the full 64-bit range is cheaper than the subtraction ladder
+  if (input_mod_factor != modulus &&
+      Log2(input_mod_factor) - Log2(output_mod_factor) > 3) {
+    input_mod_factor = modulus;
+  }
+
 #ifdef HEXL_HAS_AVX512IFMA
-  // Modulus can be 52 bits only if input mod factors <= 4
-  // otherwise modulus should be 51 bits max to give correct results
-  if ((has_avx512ifma && modulus < (1ULL << 51)) ||
-      (modulus < (1ULL << 52) && input_mod_factor <= 4)) {
+  // Modulus can be 52 bits only for power-of-two input mod factors, which
+  // are reduced by conditional subtraction; otherwise modulus should be 51
+  // bits max to give correct results
+  if (has_avx512ifma &&
+      (modulus < (1ULL << 51) ||
+       (modulus < (1ULL << 52) && input_mod_factor != modulus))) {
     EltwiseReduceModAVX512<52>(result, operand, n, modulus, input_mod_factor,
                                output_mod_factor);
     return;
@@ -121,5 +188,31 @@ void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
   EltwiseReduceModNative(result, operand, n, modulus, input_mod_factor,
                          output_mod_factor);
 }
+
+void EltwiseReduceMod128(uint64_t* result, const uint64_t* operand_hi,
+                         const uint64_t* operand_lo, uint64_t n,
+                         uint64_t modulus, uint64_t output_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand_hi != nullptr, "Require operand_hi != nullptr");
+  HEXL_CHECK(operand_lo != nullptr, "Require operand_lo != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 63), "Require modulus < 2^63");
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling EltwiseReduceMod128AVX512");
+    EltwiseReduceMod128AVX512(result, operand_hi, operand_lo, n, modulus,
+                              output_mod_factor);
+    return;
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling EltwiseReduceMod128Native");
+  EltwiseReduceMod128Native(result, operand_hi, operand_lo, n, modulus,
+                            output_mod_factor);
+}
 }  // namespace hexl
 }  // namespace intel
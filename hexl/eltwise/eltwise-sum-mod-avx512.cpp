@@ -0,0 +1,73 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-sum-mod-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+uint64_t EltwiseSumModAVX512(const uint64_t* operand, uint64_t n,
+                             uint64_t modulus) {
+  uint64_t acc_hi = 0;
+  uint64_t acc_lo = 0;
+
+  uint64_t n_mod_8 = n % 8;
+  for (size_t i = 0; i < n_mod_8; ++i) {
+    AccumulateLazy128(&acc_hi, &acc_lo, 0, operand[i], modulus);
+  }
+  operand += n_mod_8;
+  n -= n_mod_8;
+
+  // Per-lane 128-bit accumulators; v_acc_hi counts the carries out of
+  // v_acc_lo. Two independent accumulator pairs hide the add latency.
+  __m512i v_one = _mm512_set1_epi64(1);
+  __m512i v_acc_hi0 = _mm512_setzero_si512();
+  __m512i v_acc_lo0 = _mm512_setzero_si512();
+  __m512i v_acc_hi1 = _mm512_setzero_si512();
+  __m512i v_acc_lo1 = _mm512_setzero_si512();
+
+  const __m512i* vp_operand = reinterpret_cast<const __m512i*>(operand);
+
+  size_t num_vectors = n / 8;
+  for (size_t i = num_vectors / 2; i > 0; --i) {
+    __m512i v_operand0 = _mm512_loadu_si512(vp_operand++);
+    __m512i v_operand1 = _mm512_loadu_si512(vp_operand++);
+
+    v_acc_lo0 = _mm512_add_epi64(v_acc_lo0, v_operand0);
+    v_acc_lo1 = _mm512_add_epi64(v_acc_lo1, v_operand1);
+    __mmask8 carry0 = _mm512_cmplt_epu64_mask(v_acc_lo0, v_operand0);
+    __mmask8 carry1 = _mm512_cmplt_epu64_mask(v_acc_lo1, v_operand1);
+    v_acc_hi0 = _mm512_mask_add_epi64(v_acc_hi0, carry0, v_acc_hi0, v_one);
+    v_acc_hi1 = _mm512_mask_add_epi64(v_acc_hi1, carry1, v_acc_hi1, v_one);
+  }
+  if (num_vectors % 2 != 0) {
+    __m512i v_operand0 = _mm512_loadu_si512(vp_operand);
+    v_acc_lo0 = _mm512_add_epi64(v_acc_lo0, v_operand0);
+    __mmask8 carry0 = _mm512_cmplt_epu64_mask(v_acc_lo0, v_operand0);
+    v_acc_hi0 = _mm512_mask_add_epi64(v_acc_hi0, carry0, v_acc_hi0, v_one);
+  }
+
+  uint64_t lane_hi[16];
+  uint64_t lane_lo[16];
+  _mm512_storeu_si512(lane_hi, v_acc_hi0);
+  _mm512_storeu_si512(lane_hi + 8, v_acc_hi1);
+  _mm512_storeu_si512(lane_lo, v_acc_lo0);
+  _mm512_storeu_si512(lane_lo + 8, v_acc_lo1);
+  for (size_t j = 0; j < 16; ++j) {
+    AccumulateLazy128(&acc_hi, &acc_lo, lane_hi[j] % modulus, lane_lo[j],
+                      modulus);
+  }
+  return BarrettReduce128(acc_hi, acc_lo, modulus);
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
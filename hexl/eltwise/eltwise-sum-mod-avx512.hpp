@@ -0,0 +1,18 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief Returns sum_i operand[i] mod modulus
+uint64_t EltwiseSumModAVX512(const uint64_t* operand, uint64_t n,
+                             uint64_t modulus);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
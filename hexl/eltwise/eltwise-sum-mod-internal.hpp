@@ -0,0 +1,41 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Adds the 128-bit value (\p add_hi, \p add_lo) to the lazy
+/// accumulator (\p acc_hi, \p acc_lo), keeping \p acc_hi in [0, modulus).
+/// @details Since acc_hi * 2^64 = (acc_hi mod q) * 2^64 mod q, the high word
+/// may be reduced independently of the low word.
+/// Assumes \p acc_hi < modulus and \p add_hi < modulus.
+inline void AccumulateLazy128(uint64_t* acc_hi, uint64_t* acc_lo,
+                              uint64_t add_hi, uint64_t add_lo,
+                              uint64_t modulus) {
+  *acc_lo += add_lo;
+  uint64_t hi = *acc_hi + add_hi + static_cast<uint64_t>(*acc_lo < add_lo);
+  *acc_hi = (hi >= modulus) ? hi - modulus : hi;
+}
+
+/// @brief Returns sum_i operand[i] mod modulus
+inline uint64_t EltwiseSumModNative(const uint64_t* operand, uint64_t n,
+                                    uint64_t modulus) {
+  uint64_t acc_hi = 0;
+  uint64_t acc_lo = 0;
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < n; ++i) {
+    AccumulateLazy128(&acc_hi, &acc_lo, 0, operand[i], modulus);
+  }
+  return BarrettReduce128(acc_hi, acc_lo, modulus);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,52 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/eltwise/eltwise-sum-mod.hpp"
+
+#include "eltwise/eltwise-sum-mod-avx512.hpp"
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+uint64_t EltwiseSumMod(const uint64_t* operand, uint64_t n, uint64_t modulus,
+                       uint64_t input_mod_factor) {
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "Require input_mod_factor = 1, 2, or 4")
+  HEXL_CHECK_BOUNDS(operand, n, input_mod_factor * modulus,
+                    "operand exceeds bound " << (input_mod_factor * modulus))
+  HEXL_UNUSED(input_mod_factor);
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling EltwiseSumModAVX512");
+    return EltwiseSumModAVX512(operand, n, modulus);
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling EltwiseSumModNative");
+  return EltwiseSumModNative(operand, n, modulus);
+}
+
+void EltwiseSumMod(uint64_t* result, const uint64_t* operand, uint64_t n,
+                   const uint64_t* moduli, uint64_t num_moduli,
+                   uint64_t input_mod_factor) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+
+  for (size_t i = 0; i < num_moduli; ++i) {
+    result[i] = EltwiseSumMod(operand + i * n, n, moduli[i], input_mod_factor);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,146 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "experimental/fft-like/ckks-encoding-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "experimental/fft-like/ckks-encoding-internal.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+namespace {
+
+// Rounds to the nearest integer, half away from zero, like std::round
+inline __m512d RoundHalfAwayFromZero(__m512d x) {
+  __m512d v_trunc =
+      _mm512_roundscale_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  __m512d v_frac = _mm512_abs_pd(_mm512_sub_pd(x, v_trunc));
+  __mmask8 round_away =
+      _mm512_cmp_pd_mask(v_frac, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+  // copysign(1.0, x)
+  __m512d v_one = _mm512_or_pd(_mm512_set1_pd(1.0),
+                               _mm512_and_pd(x, _mm512_set1_pd(-0.0)));
+  return _mm512_mask_add_pd(v_trunc, round_away, v_trunc, v_one);
+}
+
+// Writes the 8 integer-valued doubles in v_coeff mod moduli[k] to
+// result[k * n], ..., result[k * n + 7] for each modulus
+inline void ReduceRoundedCoefficients(__m512d v_coeff, uint64_t* result,
+                                      uint64_t n, const uint64_t* moduli,
+                                      const uint64_t* barrett_factors,
+                                      uint64_t num_moduli) {
+  const double two_pow_64 = 18446744073709551616.0;
+  __m512d v_abs = _mm512_abs_pd(v_coeff);
+
+  // Values of 64 bits or more are rare; reduce them one at a time
+  __mmask8 large =
+      _mm512_cmp_pd_mask(v_abs, _mm512_set1_pd(two_pow_64), _CMP_NLT_UQ);
+  if (large != 0) {
+    double coeffs[8];
+    _mm512_storeu_pd(coeffs, v_coeff);
+    for (size_t t = 0; t < 8; ++t) {
+      ReduceRoundedCoefficient(coeffs[t], result + t, n, moduli,
+                               barrett_factors, num_moduli);
+    }
+    return;
+  }
+
+  __mmask8 negative = _mm512_movepi64_mask(_mm512_castpd_si512(v_coeff));
+  __m512i v_abs_coeff = _mm512_cvttpd_epu64(v_abs);
+  for (uint64_t k = 0; k < num_moduli; ++k) {
+    __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(moduli[k]));
+    __m512i v_bf = _mm512_set1_epi64(static_cast<int64_t>(barrett_factors[k]));
+    __m512i v_reduced = _mm512_hexl_barrett_reduce64<64, 1>(
+        v_abs_coeff, v_modulus, v_bf, v_bf, 0, v_modulus);
+    __mmask8 negate = negative & _mm512_test_epi64_mask(v_reduced, v_reduced);
+    v_reduced = _mm512_mask_sub_epi64(v_reduced, negate, v_modulus, v_reduced);
+    _mm512_storeu_si512(result + k * n, v_reduced);
+  }
+}
+
+}  // namespace
+
+void EncodeCKKSFinalStageAVX512(uint64_t* result,
+                                const double* operand_8C_intrlvd,
+                                const double* W_1C_intrlvd, double scale,
+                                uint64_t n, const uint64_t* moduli,
+                                const uint64_t* barrett_factors,
+                                uint64_t num_moduli) {
+  HEXL_CHECK(n % 16 == 0, "Require n % 16 == 0, got n = " << n);
+  const uint64_t half_n = n / 2;
+  const __m512d v_scale = _mm512_set1_pd(scale);
+  const __m512d v_W_real = _mm512_mul_pd(_mm512_set1_pd(W_1C_intrlvd[0]),
+                                         v_scale);
+  const __m512d v_W_imag = _mm512_mul_pd(_mm512_set1_pd(W_1C_intrlvd[1]),
+                                         v_scale);
+
+  const double* X_pt = operand_8C_intrlvd;
+  const double* Y_pt = operand_8C_intrlvd + n;
+  for (uint64_t j = 0; j < half_n; j += 8, X_pt += 16, Y_pt += 16) {
+    __m512d v_X_real = _mm512_loadu_pd(X_pt);
+    __m512d v_X_imag = _mm512_loadu_pd(X_pt + 8);
+    __m512d v_Y_real = _mm512_loadu_pd(Y_pt);
+    __m512d v_Y_imag = _mm512_loadu_pd(Y_pt + 8);
+
+    // Only the real parts of X = (X + Y) * scale and Y = (X - Y) * W * scale
+    // are needed
+    __m512d v_out_X =
+        _mm512_mul_pd(_mm512_add_pd(v_X_real, v_Y_real), v_scale);
+    __m512d v_V_real = _mm512_sub_pd(v_X_real, v_Y_real);
+    __m512d v_V_imag = _mm512_sub_pd(v_X_imag, v_Y_imag);
+    __m512d v_out_Y = _mm512_sub_pd(_mm512_mul_pd(v_V_real, v_W_real),
+                                    _mm512_mul_pd(v_V_imag, v_W_imag));
+
+    ReduceRoundedCoefficients(RoundHalfAwayFromZero(v_out_X), result + j, n,
+                              moduli, barrett_factors, num_moduli);
+    ReduceRoundedCoefficients(RoundHalfAwayFromZero(v_out_Y),
+                              result + half_n + j, n, moduli, barrett_factors,
+                              num_moduli);
+  }
+}
+
+void DecodeCKKSFirstStageAVX512(double* X_8C_intrlvd, double* Y_8C_intrlvd,
+                                const double* X_1C_intrlvd,
+                                const double* Y_1C_intrlvd,
+                                const double* W_1C_intrlvd, uint64_t count) {
+  HEXL_CHECK(count % 8 == 0, "Require count % 8 == 0, got count = " << count);
+  // Picks the real parts out of 8 complex interleaved values
+  const __m512i v_real_idx = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+  const __m512d v_W_real = _mm512_set1_pd(W_1C_intrlvd[0]);
+  const __m512d v_W_imag = _mm512_set1_pd(W_1C_intrlvd[1]);
+  const __m512d v_zero = _mm512_setzero_pd();
+
+  for (uint64_t i = 0; i < count; i += 8) {
+    __m512d v_X = _mm512_permutex2var_pd(_mm512_loadu_pd(X_1C_intrlvd),
+                                         v_real_idx,
+                                         _mm512_loadu_pd(X_1C_intrlvd + 8));
+    __m512d v_Y = _mm512_permutex2var_pd(_mm512_loadu_pd(Y_1C_intrlvd),
+                                         v_real_idx,
+                                         _mm512_loadu_pd(Y_1C_intrlvd + 8));
+
+    // X = X + Y * W, Y = X - Y * W with real X and Y
+    __m512d v_V_real = _mm512_mul_pd(v_Y, v_W_real);
+    __m512d v_V_imag = _mm512_mul_pd(v_Y, v_W_imag);
+    _mm512_storeu_pd(X_8C_intrlvd, _mm512_add_pd(v_X, v_V_real));
+    _mm512_storeu_pd(X_8C_intrlvd + 8, v_V_imag);
+    _mm512_storeu_pd(Y_8C_intrlvd, _mm512_sub_pd(v_X, v_V_real));
+    _mm512_storeu_pd(Y_8C_intrlvd + 8, _mm512_sub_pd(v_zero, v_V_imag));
+
+    X_1C_intrlvd += 16;
+    Y_1C_intrlvd += 16;
+    X_8C_intrlvd += 16;
+    Y_8C_intrlvd += 16;
+  }
+}
+
+#endif  // HEXL_HAS_AVX512DQ
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,48 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512 implementation of the final stage of EncodeCKKS
+/// @param[in] operand_8C_intrlvd The two halves of the transform, each in the
+/// 8 complex interleaved layout Inverse_FFTLike_FromBitReverseAVX512 leaves
+/// before its final stage
+/// @param[in] W_1C_intrlvd Inverse root of unity power n - 1, as one complex
+/// interleaved value
+/// @param[in] scale Scale applied to the outputs before rounding
+/// @param[in] barrett_factors floor(2^64 / moduli[k]) for each modulus
+/// @details Requires n to be a multiple of 16
+void EncodeCKKSFinalStageAVX512(uint64_t* result,
+                                const double* operand_8C_intrlvd,
+                                const double* W_1C_intrlvd, double scale,
+                                uint64_t n, const uint64_t* moduli,
+                                const uint64_t* barrett_factors,
+                                uint64_t num_moduli);
+
+/// @brief AVX512 implementation of the first forward FFT like stage of
+/// DecodeCKKS, on real inputs
+/// @param[out] X_8C_intrlvd Outputs for X, in the 8 complex interleaved layout
+/// Forward_FFTLike_ToBitReverseAVX512 uses after its first stage
+/// @param[out] Y_8C_intrlvd Outputs for Y, in the same layout
+/// @param[in] X_1C_intrlvd count complex values with zero imaginary parts, as
+/// written by BuildFloatingPointsAVX512
+/// @param[in] Y_1C_intrlvd count complex values with zero imaginary parts
+/// @param[in] W_1C_intrlvd Root of unity power 1, as one complex interleaved
+/// value
+/// @details Requires count to be a multiple of 8
+void DecodeCKKSFirstStageAVX512(double* X_8C_intrlvd, double* Y_8C_intrlvd,
+                                const double* X_1C_intrlvd,
+                                const double* Y_1C_intrlvd,
+                                const double* W_1C_intrlvd, uint64_t count);
+#endif
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,56 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cmath>
+
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+/// @brief Writes value mod moduli[k] to result[k * n] for each of the
+/// num_moduli moduli
+/// @param[in] value Integer-valued double of any magnitude
+/// @param[in] barrett_factors floor(2^64 / moduli[k]) for each modulus
+inline void ReduceRoundedCoefficient(double value, uint64_t* result,
+                                     uint64_t n, const uint64_t* moduli,
+                                     const uint64_t* barrett_factors,
+                                     uint64_t num_moduli) {
+  HEXL_CHECK(std::isfinite(value), "Coefficient " << value << " is not finite");
+  const double two_pow_64 = 18446744073709551616.0;
+  bool is_negative = std::signbit(value);
+  double abs_value = std::fabs(value);
+
+  if (abs_value < two_pow_64) {
+    uint64_t coeff = static_cast<uint64_t>(abs_value);
+    for (uint64_t k = 0; k < num_moduli; ++k) {
+      uint64_t reduced = BarrettReduce64(coeff, moduli[k], barrett_factors[k]);
+      result[k * n] =
+          (is_negative && reduced != 0) ? moduli[k] - reduced : reduced;
+    }
+    return;
+  }
+
+  // abs_value is mantissa * 2^exponent with a 53-bit integer mantissa
+  int exponent;
+  double fraction = std::frexp(abs_value, &exponent);
+  uint64_t mantissa = static_cast<uint64_t>(std::ldexp(fraction, 53));
+  uint64_t shift = static_cast<uint64_t>(exponent - 53);
+  for (uint64_t k = 0; k < num_moduli; ++k) {
+    uint64_t reduced = MultiplyMod(
+        BarrettReduce64(mantissa, moduli[k], barrett_factors[k]),
+        PowMod(2, shift, moduli[k]), moduli[k]);
+    result[k * n] =
+        (is_negative && reduced != 0) ? moduli[k] - reduced : reduced;
+  }
+}
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,462 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/ckks-encoding.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "experimental/fft-like/ckks-encoding-avx512.hpp"
+#include "experimental/fft-like/ckks-encoding-internal.hpp"
+#include "experimental/fft-like/fft-like-native-internal.hpp"
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/experimental/fft-like/fwd-fft-like-avx512.hpp"
+#include "hexl/experimental/fft-like/inv-fft-like-avx512.hpp"
+#include "hexl/experimental/seal/ntt-cache.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "hexl/util/compiler.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+std::atomic<uint64_t> decode_ckks_num_threads{0};
+
+// Degree from which DecodeCKKS runs on multiple threads
+constexpr uint64_t kDecodeCKKSParallelDegree = 1ULL << 15;
+
+// Number of coefficients in each half of the transform that DecodeCKKS
+// composes at a time. Keeps the composed words in the L1 cache.
+constexpr uint64_t kDecodeCKKSBlockSize = 32;
+
+// value *= factor for a num_words-word value. The product must fit.
+void MultiplyUIntInPlace(uint64_t* value, uint64_t factor,
+                         uint64_t num_words) {
+  uint64_t carry = 0;
+  for (uint64_t w = 0; w < num_words; ++w) {
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(value[w], factor, &prod_hi, &prod_lo);
+    prod_hi += AddUInt64(prod_lo, carry, &value[w]);
+    carry = prod_hi;
+  }
+}
+
+// Returns x < y for num_words-word x and y
+bool IsLessThanUInt(const uint64_t* x, const uint64_t* y, uint64_t num_words) {
+  for (uint64_t w = num_words; w-- > 0;) {
+    if (x[w] != y[w]) {
+      return x[w] < y[w];
+    }
+  }
+  return false;
+}
+
+// x -= y for num_words-word x >= y, ignoring a carry out of x
+void SubtractUIntInPlace(uint64_t* x, const uint64_t* y, uint64_t num_words) {
+  uint64_t borrow = 0;
+  for (uint64_t w = 0; w < num_words; ++w) {
+    uint64_t diff = x[w] - y[w];
+    uint64_t next_borrow = (x[w] < y[w]) || (diff < borrow);
+    x[w] = diff - borrow;
+    borrow = next_borrow;
+  }
+}
+
+// x += y for num_words-word x and y, ignoring a carry out of x
+void AddUIntInPlace(uint64_t* x, const uint64_t* y, uint64_t num_words) {
+  unsigned char carry = 0;
+  for (uint64_t w = 0; w < num_words; ++w) {
+    uint64_t sum;
+    unsigned char carry1 = AddUInt64(x[w], y[w], &sum);
+    unsigned char carry2 = AddUInt64(sum, carry, &x[w]);
+    carry = carry1 | carry2;
+  }
+}
+
+// Composes residues modulo num_moduli moduli into num_moduli-word integers
+// modulo their product Q, by the Chinese remainder theorem
+class CRTComposer {
+ public:
+  CRTComposer(const uint64_t* moduli, uint64_t num_moduli)
+      : m_moduli(moduli, moduli + num_moduli),
+        m_product(num_moduli, 0),
+        m_threshold(num_moduli, 0),
+        m_punctured_products(num_moduli * num_moduli, 0),
+        m_inv_punctured_products(num_moduli),
+        m_inv_punctured_precons(num_moduli) {
+    for (uint64_t k = 0; k < num_moduli; ++k) {
+      // Q / moduli[k], and its inverse modulo moduli[k]
+      uint64_t* punctured = &m_punctured_products[k * num_moduli];
+      punctured[0] = 1;
+      uint64_t punctured_mod_q = 1;
+      for (uint64_t j = 0; j < num_moduli; ++j) {
+        if (j != k) {
+          MultiplyUIntInPlace(punctured, moduli[j], num_moduli);
+          punctured_mod_q =
+              MultiplyMod(punctured_mod_q, moduli[j] % moduli[k], moduli[k]);
+        }
+      }
+      m_inv_punctured_products[k] = InverseMod(punctured_mod_q, moduli[k]);
+      m_inv_punctured_precons[k] =
+          MultiplyFactor(m_inv_punctured_products[k], 64, moduli[k])
+              .BarrettFactor();
+    }
+
+    std::copy(m_punctured_products.begin(),
+              m_punctured_products.begin() + num_moduli, m_product.begin());
+    MultiplyUIntInPlace(m_product.data(), moduli[0], num_moduli);
+
+    // Q is odd, so (Q + 1) / 2 = floor(Q / 2) + 1
+    for (uint64_t w = 0; w < num_moduli; ++w) {
+      m_threshold[w] = m_product[w] >> 1;
+      if (w + 1 < num_moduli) {
+        m_threshold[w] |= m_product[w + 1] << 63;
+      }
+    }
+    for (uint64_t w = 0; w < num_moduli; ++w) {
+      if (++m_threshold[w] != 0) {
+        break;
+      }
+    }
+  }
+
+  // Composes count coefficients at once, writing the composition of
+  // residues[t], residues[t + stride], ... to the num_moduli words of
+  // result[t * num_moduli], for count up to kDecodeCKKSBlockSize
+  void Compose(uint64_t* result, const uint64_t* residues, uint64_t stride,
+               uint64_t count) const {
+    HEXL_CHECK(count <= kDecodeCKKSBlockSize,
+               "Require count <= " << kDecodeCKKSBlockSize);
+    const uint64_t num_moduli = m_moduli.size();
+    if (num_moduli == 1) {
+      std::copy(residues, residues + count, result);
+      return;
+    }
+
+    // Sum of factor * Q / moduli[k] over the moduli, with factor below
+    // moduli[k]. The sum is below num_moduli * Q, so only one extra word, top,
+    // is needed, and it is reduced once at the end. The coefficients are
+    // independent, so looping over them innermost overlaps their carry chains.
+    uint64_t top[kDecodeCKKSBlockSize] = {0};
+    std::fill(result, result + count * num_moduli, 0);
+    for (uint64_t k = 0; k < num_moduli; ++k) {
+      const uint64_t* punctured = &m_punctured_products[k * num_moduli];
+      for (uint64_t t = 0; t < count; ++t) {
+        uint64_t factor =
+            MultiplyMod(residues[k * stride + t], m_inv_punctured_products[k],
+                        m_inv_punctured_precons[k], m_moduli[k]);
+        uint64_t* coeff = result + t * num_moduli;
+        uint64_t carry = 0;
+        for (uint64_t w = 0; w < num_moduli; ++w) {
+          uint64_t prod_hi;
+          uint64_t prod_lo;
+          MultiplyUInt64(punctured[w], factor, &prod_hi, &prod_lo);
+          // Cannot overflow, as punctured[w] * factor + carry + coeff[w] fits
+          // in 128 bits
+          prod_hi += AddUInt64(prod_lo, carry, &prod_lo);
+          prod_hi += AddUInt64(coeff[w], prod_lo, &coeff[w]);
+          carry = prod_hi;
+        }
+        top[t] += carry;
+      }
+    }
+    for (uint64_t t = 0; t < count; ++t) {
+      ReduceModProduct(result + t * num_moduli, top[t]);
+    }
+  }
+
+  uint64_t NumModuli() const { return m_moduli.size(); }
+
+  // Q, in num_moduli words
+  const uint64_t* Product() const { return m_product.data(); }
+
+  // (Q + 1) / 2, from which composed values are negative
+  const uint64_t* Threshold() const { return m_threshold.data(); }
+
+ private:
+  // Reduces top * 2^(64 * num_moduli) + value below num_moduli * Q modulo Q,
+  // for num_moduli >= 2
+  void ReduceModProduct(uint64_t* value, uint64_t top) const {
+    const uint64_t num_moduli = m_moduli.size();
+    const uint64_t* product = m_product.data();
+
+    // The quotient is small, so the leading words give it to within one
+    const double two_pow_64 = 18446744073709551616.0;
+    double value_hi =
+        (static_cast<double>(top) * two_pow_64 +
+         static_cast<double>(value[num_moduli - 1])) *
+            two_pow_64 +
+        static_cast<double>(value[num_moduli - 2]);
+    double product_hi =
+        static_cast<double>(product[num_moduli - 1]) * two_pow_64 +
+        static_cast<double>(product[num_moduli - 2]);
+    uint64_t quotient = static_cast<uint64_t>(value_hi / product_hi);
+
+    // value -= quotient * Q
+    uint64_t carry = 0;
+    uint64_t borrow = 0;
+    for (uint64_t w = 0; w < num_moduli; ++w) {
+      uint64_t prod_hi;
+      uint64_t prod_lo;
+      MultiplyUInt64(product[w], quotient, &prod_hi, &prod_lo);
+      prod_hi += AddUInt64(prod_lo, carry, &prod_lo);
+      carry = prod_hi;
+
+      uint64_t diff = value[w] - prod_lo;
+      uint64_t next_borrow = (value[w] < prod_lo) || (diff < borrow);
+      value[w] = diff - borrow;
+      borrow = next_borrow;
+    }
+
+    if (top < carry + borrow) {
+      // The quotient was one too large
+      AddUIntInPlace(value, product, num_moduli);
+    } else if (top != carry + borrow ||
+               !IsLessThanUInt(value, product, num_moduli)) {
+      // The quotient was one too small
+      SubtractUIntInPlace(value, product, num_moduli);
+    }
+  }
+
+  std::vector<uint64_t> m_moduli;
+  std::vector<uint64_t> m_product;
+  std::vector<uint64_t> m_threshold;
+  std::vector<uint64_t> m_punctured_products;
+  std::vector<uint64_t> m_inv_punctured_products;
+  std::vector<uint64_t> m_inv_punctured_precons;
+};
+
+// Composes the count coefficients coeffs[0], ..., coeffs[count - 1] of the
+// limbs n apart and writes them times inv_scale to values, centered modulo Q
+void ComposeFloatingPoints(std::complex<double>* values, uint64_t* words,
+                           const uint64_t* coeffs, const CRTComposer& composer,
+                           double inv_scale, uint64_t n, uint64_t count) {
+  const uint64_t num_moduli = composer.NumModuli();
+  composer.Compose(words, coeffs, n, count);
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && count % 8 == 0) {
+    BuildFloatingPointsAVX512(reinterpret_cast<double*>(values), words,
+                              composer.Threshold(), composer.Product(),
+                              inv_scale, num_moduli, count);
+    return;
+  }
+#endif
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    BuildFloatingPointsAVX2(reinterpret_cast<double*>(values), words,
+                            composer.Threshold(), composer.Product(),
+                            inv_scale, num_moduli, count);
+    return;
+  }
+#endif
+  BuildFloatingPointsNative(values, words, composer.Threshold(),
+                            composer.Product(), inv_scale, num_moduli, count);
+}
+
+// Forward FFT like of the composed coefficients times inv_scale. The
+// composition and scaling are fused into the first stage, one block of
+// coefficients at a time.
+void ForwardFFTLikeFromRNS(std::complex<double>* result, const uint64_t* coeffs,
+                           const CRTComposer& composer,
+                           const AlignedVector64<std::complex<double>>& roots,
+                           double inv_scale, uint64_t n, int num_threads) {
+  const uint64_t half_n = n / 2;
+  const uint64_t block_size = std::min(half_n, kDecodeCKKSBlockSize);
+  const int64_t num_blocks = static_cast<int64_t>(half_n / block_size);
+  const std::complex<double> W = roots[1];
+
+  bool use_avx512 = false;
+#ifdef HEXL_HAS_AVX512DQ
+  use_avx512 = has_avx512dq && n >= 32;
+#endif
+  HEXL_VLOG(3, "Calling " << (use_avx512 ? "64-bit AVX512-DQ" : "Native")
+                          << " DecodeCKKS");
+
+#pragma omp parallel num_threads(num_threads) if (num_blocks > 1)
+  {
+    std::vector<uint64_t> words(block_size * composer.NumModuli());
+    AlignedVector64<std::complex<double>> X(block_size);
+    AlignedVector64<std::complex<double>> Y(block_size);
+
+#pragma omp for
+    for (int64_t block = 0; block < num_blocks; ++block) {
+      const uint64_t j = static_cast<uint64_t>(block) * block_size;
+      ComposeFloatingPoints(X.data(), words.data(), coeffs + j, composer,
+                            inv_scale, n, block_size);
+      ComposeFloatingPoints(Y.data(), words.data(), coeffs + half_n + j,
+                            composer, inv_scale, n, block_size);
+
+#ifdef HEXL_HAS_AVX512DQ
+      if (use_avx512) {
+        double* result_pt = reinterpret_cast<double*>(result);
+        internal::DecodeCKKSFirstStageAVX512(
+            result_pt + 2 * j, result_pt + n + 2 * j,
+            reinterpret_cast<const double*>(X.data()),
+            reinterpret_cast<const double*>(Y.data()),
+            reinterpret_cast<const double*>(&W), block_size);
+        continue;
+      }
+#endif
+      for (uint64_t t = 0; t < block_size; ++t) {
+        std::complex<double> U = X[t];
+        std::complex<double> V = Y[t] * W;
+        result[j + t] = U + V;
+        result[half_n + j + t] = U - V;
+      }
+    }
+  }
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (use_avx512) {
+    // The two half transforms of the recursive case of
+    // Forward_FFTLike_ToBitReverseAVX512, whose first stage is fused above
+    double* result_pt = reinterpret_cast<double*>(result);
+    const double* roots_pt = reinterpret_cast<const double*>(roots.data());
+#pragma omp parallel for num_threads(std::min(num_threads, 2))
+    for (int64_t half = 0; half < 2; ++half) {
+      Forward_FFTLike_ToBitReverseAVX512(
+          result_pt + half * n, result_pt + half * n, roots_pt, half_n,
+          nullptr, 1, static_cast<uint64_t>(half));
+    }
+    return;
+  }
+#endif
+  internal::Forward_FFTLike_ToBitReverseRadix2Stages(result, roots.data(), n,
+                                                     nullptr);
+}
+
+// Final stage of the native inverse FFT like, keeping only the real parts of
+// its outputs, which are rounded and reduced into result
+void EncodeCKKSFinalStageNative(uint64_t* result,
+                                const std::complex<double>* operand,
+                                std::complex<double> W, double scale,
+                                uint64_t n, const uint64_t* moduli,
+                                const uint64_t* barrett_factors,
+                                uint64_t num_moduli) {
+  const uint64_t half_n = n / 2;
+  for (uint64_t j = 0; j < half_n; ++j) {
+    const std::complex<double>& X = operand[j];
+    const std::complex<double>& Y = operand[j + half_n];
+    double out_X = (X.real() + Y.real()) * scale;
+    std::complex<double> V = X - Y;
+    double out_Y = V.real() * W.real() - V.imag() * W.imag();
+
+    internal::ReduceRoundedCoefficient(std::round(out_X), result + j, n,
+                                       moduli, barrett_factors, num_moduli);
+    internal::ReduceRoundedCoefficient(std::round(out_Y), result + half_n + j,
+                                       n, moduli, barrett_factors, num_moduli);
+  }
+}
+
+// Inverse FFT like of values into scratch, with the scaling, rounding and
+// reduction fused into the final stage
+void InverseFFTLikeToRNS(uint64_t* result, const std::complex<double>* values,
+                         std::complex<double>* scratch,
+                         const AlignedVector64<std::complex<double>>& inv_roots,
+                         double scale, uint64_t n, const uint64_t* moduli,
+                         const uint64_t* barrett_factors,
+                         uint64_t num_moduli) {
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 32) {
+    HEXL_VLOG(3, "Calling 64-bit AVX512-DQ EncodeCKKS");
+    const double* roots = reinterpret_cast<const double*>(inv_roots.data());
+    const double* values_pt = reinterpret_cast<const double*>(values);
+    double* scratch_pt = reinterpret_cast<double*>(scratch);
+
+    // The two half transforms of the recursive case of
+    // Inverse_FFTLike_FromBitReverseAVX512; its final stage is fused below
+    Inverse_FFTLike_FromBitReverseAVX512(scratch_pt, values_pt, roots, n / 2,
+                                         nullptr, 1, 0);
+    Inverse_FFTLike_FromBitReverseAVX512(scratch_pt + n, values_pt + n, roots,
+                                         n / 2, nullptr, 1, 1);
+    internal::EncodeCKKSFinalStageAVX512(result, scratch_pt,
+                                         roots + 2 * (n - 1), scale, n,
+                                         moduli, barrett_factors, num_moduli);
+    return;
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling Native EncodeCKKS");
+  internal::Inverse_FFTLike_FromBitReverseRadix2Stages(
+      scratch, values, inv_roots.data(), n, true);
+  EncodeCKKSFinalStageNative(result, scratch, scale * inv_roots[n - 1], scale,
+                             n, moduli, barrett_factors, num_moduli);
+}
+
+}  // namespace
+
+void EncodeCKKS(uint64_t* result, const std::complex<double>* values,
+                const FFTLike& fft_like, double scale, const uint64_t* moduli,
+                uint64_t num_moduli) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(values != nullptr, "Require values != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(num_moduli != 0, "Require num_moduli != 0");
+  HEXL_CHECK(scale > 0, "Require scale > 0");
+
+  const uint64_t n = fft_like.GetDegree();
+  std::vector<uint64_t> barrett_factors(num_moduli);
+  for (uint64_t k = 0; k < num_moduli; ++k) {
+    barrett_factors[k] = MultiplyFactor(1, 64, moduli[k]).BarrettFactor();
+  }
+
+  AlignedVector64<std::complex<double>> scratch(n);
+  InverseFFTLikeToRNS(result, values, scratch.data(),
+                      fft_like.GetInvComplexRootsOfUnity(),
+                      scale / static_cast<double>(n), n, moduli,
+                      barrett_factors.data(), num_moduli);
+
+  for (uint64_t k = 0; k < num_moduli; ++k) {
+    uint64_t* limb = result + k * n;
+    GetNTT(n, moduli[k]).ComputeForward(limb, limb, 1, 1);
+  }
+}
+
+void SetDecodeCKKSNumThreads(uint64_t num_threads) {
+  decode_ckks_num_threads.store(num_threads);
+}
+
+uint64_t GetDecodeCKKSNumThreads() { return decode_ckks_num_threads.load(); }
+
+void DecodeCKKS(std::complex<double>* result, const uint64_t* operand,
+                const FFTLike& fft_like, double scale, const uint64_t* moduli,
+                uint64_t num_moduli) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(num_moduli != 0, "Require num_moduli != 0");
+  HEXL_CHECK(scale > 0, "Require scale > 0");
+
+  const uint64_t n = fft_like.GetDegree();
+  HEXL_CHECK(n >= 2, "Require n >= 2, got n = " << n);
+  const int num_threads =
+      n >= kDecodeCKKSParallelDegree
+          ? GetOmpNumThreads(GetDecodeCKKSNumThreads())
+          : 1;
+
+  AlignedVector64<uint64_t> coeffs(n * num_moduli);
+#pragma omp parallel for num_threads(num_threads) if (num_moduli > 1)
+  for (int64_t k = 0; k < static_cast<int64_t>(num_moduli); ++k) {
+    uint64_t offset = static_cast<uint64_t>(k) * n;
+    GetNTT(n, moduli[k])
+        .ComputeInverse(&coeffs[offset], operand + offset, 1, 1);
+  }
+
+  CRTComposer composer(moduli, num_moduli);
+  ForwardFFTLikeFromRNS(result, coeffs.data(), composer,
+                        fft_like.GetComplexRootsOfUnity(), 1.0 / scale, n,
+                        num_threads);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,349 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <complex>
+
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/logging/logging.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+namespace {
+
+// Returns all-ones in the lanes where x > y as unsigned integers. AVX2 only
+// compares signed integers, so both sides are offset by 2^63.
+inline __m256i CmpGtEpu64(__m256i x, __m256i y) {
+  const __m256i v_sign = _mm256_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+  return _mm256_cmpgt_epi64(_mm256_xor_si256(x, v_sign),
+                            _mm256_xor_si256(y, v_sign));
+}
+
+// Loads base[0], base[stride], base[2 * stride], base[3 * stride]
+inline __m256i LoadStrided(const uint64_t* base, size_t stride) {
+  return _mm256_set_epi64x(static_cast<int64_t>(base[3 * stride]),
+                           static_cast<int64_t>(base[2 * stride]),
+                           static_cast<int64_t>(base[stride]),
+                           static_cast<int64_t>(base[0]));
+}
+
+// Returns y * w on 4 complex values with interleaved real and imaginary
+// parts. w_real and w_imag hold the real and imaginary parts of w in both
+// lanes of each complex value.
+inline __m256 MultiplyComplexAVX2(__m256 y, __m256 w_real, __m256 w_imag) {
+  __m256 y_swapped = _mm256_permute_ps(y, 0xB1);
+  return _mm256_addsub_ps(_mm256_mul_ps(y, w_real),
+                          _mm256_mul_ps(y_swapped, w_imag));
+}
+
+// Stages with butterfly distance Gap < 4 process 8 complex values held in two
+// registers at a time. SplitNarrowAVX2 gathers the X and Y inputs of the 4
+// butterflies: values 0, 1, 4, 5 and 2, 3, 6, 7 for Gap 2, and values 0, 4,
+// 2, 6 and 1, 5, 3, 7 for Gap 1. MergeNarrowAVX2 reverses it.
+template <size_t Gap>
+inline void SplitNarrowAVX2(__m256 lo, __m256 hi, __m256* X, __m256* Y) {
+  if (Gap == 2) {
+    *X = _mm256_permute2f128_ps(lo, hi, 0x20);
+    *Y = _mm256_permute2f128_ps(lo, hi, 0x31);
+  } else {
+    *X = _mm256_castpd_ps(
+        _mm256_unpacklo_pd(_mm256_castps_pd(lo), _mm256_castps_pd(hi)));
+    *Y = _mm256_castpd_ps(
+        _mm256_unpackhi_pd(_mm256_castps_pd(lo), _mm256_castps_pd(hi)));
+  }
+}
+
+template <size_t Gap>
+inline void MergeNarrowAVX2(__m256 X, __m256 Y, __m256* lo, __m256* hi) {
+  if (Gap == 2) {
+    *lo = _mm256_permute2f128_ps(X, Y, 0x20);
+    *hi = _mm256_permute2f128_ps(X, Y, 0x31);
+  } else {
+    *lo = _mm256_castpd_ps(
+        _mm256_unpacklo_pd(_mm256_castps_pd(X), _mm256_castps_pd(Y)));
+    *hi = _mm256_castpd_ps(
+        _mm256_unpackhi_pd(_mm256_castps_pd(X), _mm256_castps_pd(Y)));
+  }
+}
+
+// Loads the root of unity powers of the butterflies gathered by
+// SplitNarrowAVX2, in the same lane order
+template <size_t Gap>
+inline __m256 LoadNarrowRootsAVX2(const float* W) {
+  if (Gap == 2) {
+    __m256d v_W = _mm256_castpd128_pd256(_mm_castps_pd(_mm_loadu_ps(W)));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(v_W, 0x50));
+  }
+  __m256d v_W = _mm256_castps_pd(_mm256_loadu_ps(W));
+  return _mm256_castpd_ps(_mm256_permute4x64_pd(v_W, 0xD8));
+}
+
+// Forward stage with butterfly distance gap >= 4, where W points to the root
+// of unity power of the first of the m blocks
+void FwdFloatStageWideAVX2(float* result, const float* operand,
+                           const float* W, size_t m, size_t gap) {
+  for (size_t i = 0; i < m; i++) {
+    const __m256 v_W_real = _mm256_set1_ps(W[2 * i]);
+    const __m256 v_W_imag = _mm256_set1_ps(W[2 * i + 1]);
+    const size_t offset = i * 4 * gap;
+    const float* X_op = operand + offset;
+    const float* Y_op = X_op + 2 * gap;
+    float* X_r = result + offset;
+    float* Y_r = X_r + 2 * gap;
+    for (size_t j = 0; j < 2 * gap; j += 8) {
+      __m256 v_X = _mm256_loadu_ps(X_op + j);
+      __m256 v_Y = _mm256_loadu_ps(Y_op + j);
+      __m256 v_V = MultiplyComplexAVX2(v_Y, v_W_real, v_W_imag);
+      _mm256_storeu_ps(X_r + j, _mm256_add_ps(v_X, v_V));
+      _mm256_storeu_ps(Y_r + j, _mm256_sub_ps(v_X, v_V));
+    }
+  }
+}
+
+// Forward stage with butterfly distance Gap < 4
+template <size_t Gap>
+void FwdFloatStageNarrowAVX2(float* result, const float* operand,
+                             const float* W, uint64_t n, const float* scalar) {
+  for (size_t c = 0; c < n; c += 8) {
+    __m256 v_X;
+    __m256 v_Y;
+    SplitNarrowAVX2<Gap>(_mm256_loadu_ps(operand + 2 * c),
+                         _mm256_loadu_ps(operand + 2 * c + 8), &v_X, &v_Y);
+    __m256 v_W = LoadNarrowRootsAVX2<Gap>(W + c / Gap);
+    if (scalar != nullptr) {
+      const __m256 v_scalar = _mm256_set1_ps(*scalar);
+      v_X = _mm256_mul_ps(v_X, v_scalar);
+      v_W = _mm256_mul_ps(v_W, v_scalar);
+    }
+    __m256 v_V = MultiplyComplexAVX2(v_Y, _mm256_moveldup_ps(v_W),
+                                     _mm256_movehdup_ps(v_W));
+    __m256 v_lo;
+    __m256 v_hi;
+    MergeNarrowAVX2<Gap>(_mm256_add_ps(v_X, v_V), _mm256_sub_ps(v_X, v_V),
+                         &v_lo, &v_hi);
+    _mm256_storeu_ps(result + 2 * c, v_lo);
+    _mm256_storeu_ps(result + 2 * c + 8, v_hi);
+  }
+}
+
+// Inverse stage with butterfly distance gap >= 4, where W points to the root
+// of unity power of the first of the m blocks
+void InvFloatStageWideAVX2(float* result, const float* operand,
+                           const float* W, size_t m, size_t gap,
+                           const float* scalar) {
+  const float scale = scalar != nullptr ? *scalar : 1.0f;
+  const __m256 v_scalar = _mm256_set1_ps(scale);
+  for (size_t i = 0; i < m; i++) {
+    const __m256 v_W_real = _mm256_set1_ps(W[2 * i] * scale);
+    const __m256 v_W_imag = _mm256_set1_ps(W[2 * i + 1] * scale);
+    const size_t offset = i * 4 * gap;
+    const float* X_op = operand + offset;
+    const float* Y_op = X_op + 2 * gap;
+    float* X_r = result + offset;
+    float* Y_r = X_r + 2 * gap;
+    for (size_t j = 0; j < 2 * gap; j += 8) {
+      __m256 v_X = _mm256_loadu_ps(X_op + j);
+      __m256 v_Y = _mm256_loadu_ps(Y_op + j);
+      __m256 v_X_out = _mm256_add_ps(v_X, v_Y);
+      if (scalar != nullptr) {
+        v_X_out = _mm256_mul_ps(v_X_out, v_scalar);
+      }
+      _mm256_storeu_ps(X_r + j, v_X_out);
+      _mm256_storeu_ps(Y_r + j, MultiplyComplexAVX2(_mm256_sub_ps(v_X, v_Y),
+                                                    v_W_real, v_W_imag));
+    }
+  }
+}
+
+// Inverse stage with butterfly distance Gap < 4
+template <size_t Gap>
+void InvFloatStageNarrowAVX2(float* result, const float* operand,
+                             const float* W, uint64_t n) {
+  for (size_t c = 0; c < n; c += 8) {
+    __m256 v_X;
+    __m256 v_Y;
+    SplitNarrowAVX2<Gap>(_mm256_loadu_ps(operand + 2 * c),
+                         _mm256_loadu_ps(operand + 2 * c + 8), &v_X, &v_Y);
+    __m256 v_W = LoadNarrowRootsAVX2<Gap>(W + c / Gap);
+    __m256 v_Y_out =
+        MultiplyComplexAVX2(_mm256_sub_ps(v_X, v_Y), _mm256_moveldup_ps(v_W),
+                            _mm256_movehdup_ps(v_W));
+    __m256 v_lo;
+    __m256 v_hi;
+    MergeNarrowAVX2<Gap>(_mm256_add_ps(v_X, v_Y), v_Y_out, &v_lo, &v_hi);
+    _mm256_storeu_ps(result + 2 * c, v_lo);
+    _mm256_storeu_ps(result + 2 * c + 8, v_hi);
+  }
+}
+
+}  // namespace
+
+void BuildFloatingPointsAVX2(double* res_cmplx_intrlvd, const uint64_t* plain,
+                             const uint64_t* threshold,
+                             const uint64_t* decryption_modulus,
+                             const double inv_scale, const size_t mod_size,
+                             const size_t coeff_count) {
+  const size_t vector_count = coeff_count - coeff_count % 4;
+  const __m256i v_ones = _mm256_set1_epi64x(-1);
+  const __m256d v_zeros = _mm256_setzero_pd();
+  const __m256d v_sign_bit = _mm256_set1_pd(-0.0);
+  double* res_pt = res_cmplx_intrlvd;
+  double two_pow_64 = std::pow(2.0, 64);
+
+  for (size_t i = 0; i < vector_count; i += 4) {
+    const uint64_t* coeffs = plain + i * mod_size;
+
+    // Compare against the threshold from the most significant word down,
+    // stopping once every lane differs from it
+    __m256i v_eq_thr = v_ones;
+    __m256i v_lt_thr = _mm256_setzero_si256();
+    for (size_t j = mod_size;
+         j-- > 0 && !_mm256_testz_si256(v_eq_thr, v_eq_thr);) {
+      __m256i v_plain = LoadStrided(coeffs + j, mod_size);
+      __m256i v_thrld =
+          _mm256_set1_epi64x(static_cast<int64_t>(threshold[j]));
+      v_lt_thr = _mm256_or_si256(
+          v_lt_thr, _mm256_and_si256(v_eq_thr, CmpGtEpu64(v_thrld, v_plain)));
+      v_eq_thr =
+          _mm256_and_si256(v_eq_thr, _mm256_cmpeq_epi64(v_plain, v_thrld));
+    }
+
+    double scaled_two_pow_64 = inv_scale;
+    __m256d v_res_real = _mm256_setzero_pd();
+    for (size_t j = 0; j < mod_size; j++, scaled_two_pow_64 *= two_pow_64) {
+      __m256i v_curr_coeff = LoadStrided(coeffs + j, mod_size);
+      __m256i v_dec_moduli =
+          _mm256_set1_epi64x(static_cast<int64_t>(decryption_modulus[j]));
+
+      // Lanes at or above the threshold take |coeff - decryption_modulus|,
+      // which is subtracted where coeff <= decryption_modulus
+      __m256i v_gt_dec_mod = CmpGtEpu64(v_curr_coeff, v_dec_moduli);
+      __m256i v_diff = _mm256_blendv_epi8(
+          _mm256_sub_epi64(v_dec_moduli, v_curr_coeff),
+          _mm256_sub_epi64(v_curr_coeff, v_dec_moduli), v_gt_dec_mod);
+      v_diff = _mm256_blendv_epi8(v_diff, v_curr_coeff, v_lt_thr);
+      __m256i v_subtract =
+          _mm256_andnot_si256(_mm256_or_si256(v_lt_thr, v_gt_dec_mod), v_ones);
+
+      uint64_t tmp_v_ui[4];
+      double tmp_v_pd[4];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_v_ui), v_diff);
+      for (size_t t = 0; t < 4; t++) {
+        tmp_v_pd[t] = static_cast<double>(tmp_v_ui[t]);
+      }
+      __m256d v_casted_diff = _mm256_loadu_pd(tmp_v_pd);
+
+      // This mask avoids multiplying by inf when diff is already zero
+      __m256d v_no_zero = _mm256_cmp_pd(v_casted_diff, v_zeros, _CMP_NEQ_OQ);
+      __m256d v_scaled_diff = _mm256_and_pd(
+          _mm256_mul_pd(v_casted_diff, _mm256_set1_pd(scaled_two_pow_64)),
+          v_no_zero);
+      // Adding the negation is exact, so this matches a subtraction
+      v_scaled_diff = _mm256_xor_pd(
+          v_scaled_diff,
+          _mm256_and_pd(_mm256_castsi256_pd(v_subtract), v_sign_bit));
+      v_res_real = _mm256_add_pd(v_res_real, v_scaled_diff);
+    }
+
+    // Make res 1 complex interleaved
+    __m256d v_res_lo = _mm256_unpacklo_pd(v_res_real, v_zeros);
+    __m256d v_res_hi = _mm256_unpackhi_pd(v_res_real, v_zeros);
+    _mm256_storeu_pd(res_pt, _mm256_permute2f128_pd(v_res_lo, v_res_hi, 0x20));
+    _mm256_storeu_pd(res_pt + 4,
+                     _mm256_permute2f128_pd(v_res_lo, v_res_hi, 0x31));
+    res_pt += 8;
+  }
+
+  if (vector_count < coeff_count) {
+    BuildFloatingPointsNative(
+        reinterpret_cast<std::complex<double>*>(res_cmplx_intrlvd +
+                                                2 * vector_count),
+        plain + vector_count * mod_size, threshold, decryption_modulus,
+        inv_scale, mod_size, coeff_count - vector_count);
+  }
+}
+
+void Forward_FFTLike_ToBitReverseFloatAVX2(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 8, "n " << n << " is less than 8");
+  HEXL_CHECK(roots_of_unity_cmplx_intrlvd != nullptr,
+             "roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+
+  // The first pass is out of place and the final stage, with gap 1, applies
+  // the scale
+  const uint64_t num_stages = Log2(n) - (skip_final_stage ? 1 : 0);
+  const float* input = operand_cmplx_intrlvd;
+  size_t gap = n >> 1;
+  for (size_t m = 1; m < (1ULL << num_stages); m <<= 1, gap >>= 1) {
+    const float* W = roots_of_unity_cmplx_intrlvd + 2 * m;
+    switch (gap) {
+      case 1:
+        FwdFloatStageNarrowAVX2<1>(result_cmplx_intrlvd, input, W, n, scale);
+        break;
+      case 2:
+        FwdFloatStageNarrowAVX2<2>(result_cmplx_intrlvd, input, W, n,
+                                   nullptr);
+        break;
+      default:
+        FwdFloatStageWideAVX2(result_cmplx_intrlvd, input, W, m, gap);
+    }
+    input = result_cmplx_intrlvd;
+  }
+}
+
+void Inverse_FFTLike_FromBitReverseFloatAVX2(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 8, "n " << n << " is less than 8");
+  HEXL_CHECK(inv_roots_of_unity_cmplx_intrlvd != nullptr,
+             "inv_roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+
+  // The first pass is out of place and the final stage, with m 1, applies
+  // the scale
+  const uint64_t num_stages = Log2(n) - (skip_final_stage ? 1 : 0);
+  const float* input = operand_cmplx_intrlvd;
+  size_t m = n >> 1;
+  size_t root_index = 1;
+  for (size_t gap = 1; gap < (1ULL << num_stages);
+       root_index += m, m >>= 1, gap <<= 1) {
+    const float* W = inv_roots_of_unity_cmplx_intrlvd + 2 * root_index;
+    switch (gap) {
+      case 1:
+        InvFloatStageNarrowAVX2<1>(result_cmplx_intrlvd, input, W, n);
+        break;
+      case 2:
+        InvFloatStageNarrowAVX2<2>(result_cmplx_intrlvd, input, W, n);
+        break;
+      default:
+        InvFloatStageWideAVX2(result_cmplx_intrlvd, input, W, m, gap,
+                              m == 1 ? scale : nullptr);
+    }
+    input = result_cmplx_intrlvd;
+  }
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,87 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/fft-like-cache.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "hexl/experimental/seal/locks.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Process-wide FFTLike cache. There are few distinct degrees, so it is never
+// evicted.
+class FFTLikeCache {
+ public:
+  // Never destroyed, since OpenMP worker threads may use it during static
+  // destruction
+  static FFTLikeCache& Instance() {
+    static FFTLikeCache* cache = new FFTLikeCache;
+    return *cache;
+  }
+
+  std::shared_ptr<const FFTLike> Lookup(uint64_t degree) {
+    {
+      ReadLock reader_lock(m_lock.AcquireRead());
+      auto fft_like_it = m_fft_likes.find(degree);
+      if (fft_like_it != m_fft_likes.end()) {
+        return fft_like_it->second;
+      }
+    }
+
+    // Construct without holding the lock; if another thread constructs the
+    // same FFTLike concurrently, the first one inserted wins
+    auto fft_like = std::make_shared<const FFTLike>(degree);
+
+    WriteLock write_lock(m_lock.AcquireWrite());
+    return m_fft_likes.emplace(degree, std::move(fft_like)).first->second;
+  }
+
+  void Clear() {
+    WriteLock write_lock(m_lock.AcquireWrite());
+    m_fft_likes.clear();
+  }
+
+  size_t Size() {
+    ReadLock reader_lock(m_lock.AcquireRead());
+    return m_fft_likes.size();
+  }
+
+ private:
+  FFTLikeCache() = default;
+
+  RWLock m_lock;
+  std::unordered_map<uint64_t, std::shared_ptr<const FFTLike>> m_fft_likes;
+};
+
+}  // namespace
+
+const FFTLike& GetFFTLike(uint64_t degree) {
+  return *FFTLikeCache::Instance().Lookup(degree);
+}
+
+std::shared_ptr<const FFTLike> GetFFTLikeShared(uint64_t degree) {
+  return FFTLikeCache::Instance().Lookup(degree);
+}
+
+void PrewarmFFTLikeCache(const std::vector<uint64_t>& degrees) {
+  FFTLikeCache& cache = FFTLikeCache::Instance();
+  const int64_t num_degrees = static_cast<int64_t>(degrees.size());
+#pragma omp parallel for num_threads(GetOmpNumThreads(0)) if (num_degrees > 1)
+  for (int64_t i = 0; i < num_degrees; ++i) {
+    cache.Lookup(degrees[i]);
+  }
+}
+
+void ClearFFTLikeCache() { FFTLikeCache::Instance().Clear(); }
+
+size_t GetFFTLikeCacheSize() { return FFTLikeCache::Instance().Size(); }
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,564 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/fft-like-float-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "hexl/logging/logging.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+namespace {
+
+// Loads 8 complex values with interleaved real and imaginary parts, rounding
+// double precision values to float
+inline __m512 LoadComplex8(const float* values) {
+  return _mm512_loadu_ps(values);
+}
+
+inline __m512 LoadComplex8(const double* values) {
+  __m256 v_lo = _mm512_cvtpd_ps(_mm512_loadu_pd(values));
+  __m256 v_hi = _mm512_cvtpd_ps(_mm512_loadu_pd(values + 8));
+  return _mm512_insertf32x8(_mm512_castps256_ps512(v_lo), v_hi, 1);
+}
+
+// Returns y * w on 8 complex values with interleaved real and imaginary
+// parts. w_real and w_imag hold the real and imaginary parts of w in both
+// lanes of each complex value.
+inline __m512 MultiplyComplexAVX512(__m512 y, __m512 w_real, __m512 w_imag) {
+  __m512 y_swapped = _mm512_permute_ps(y, 0xB1);
+  return _mm512_fmaddsub_ps(y, w_real, _mm512_mul_ps(y_swapped, w_imag));
+}
+
+// Same as above on 4 double precision complex values
+inline __m512d MultiplyComplexAVX512(__m512d y, __m512d w_real,
+                                     __m512d w_imag) {
+  __m512d y_swapped = _mm512_permute_pd(y, 0x55);
+  return _mm512_fmaddsub_pd(y, w_real, _mm512_mul_pd(y_swapped, w_imag));
+}
+
+// Returns i * x on 8 complex values
+inline __m512 MultiplyByIAVX512(__m512 x) {
+  __m512 x_swapped = _mm512_permute_ps(x, 0xB1);
+  return _mm512_mask_sub_ps(x_swapped, 0x5555, _mm512_setzero_ps(), x_swapped);
+}
+
+// Broadcasts the real and imaginary parts of the complex value W
+inline void BroadcastComplex(const float* W, __m512* v_W_real,
+                             __m512* v_W_imag) {
+  *v_W_real = _mm512_set1_ps(W[0]);
+  *v_W_imag = _mm512_set1_ps(W[1]);
+}
+
+// Permutations for stages with butterfly distance gap < 8, which process 16
+// complex values held in two registers at a time. Butterfly k of the 8 in a
+// register pair has X at position (k / gap) * 2 * gap + k % gap and Y at
+// gap positions further, and uses root of unity power k / gap of the pair.
+struct NarrowStageIndices {
+  explicit NarrowStageIndices(size_t gap);
+
+  __m512i x;        // X inputs of the 8 butterflies from the register pair
+  __m512i y;        // Y inputs of the 8 butterflies from the register pair
+  __m512i out_lo;   // First output register from the X and Y outputs
+  __m512i out_hi;   // Second output register from the X and Y outputs
+  __m512i w;        // Root of unity power of each butterfly
+  __mmask16 w_mask;  // Roots of unity to load for a register pair
+};
+
+NarrowStageIndices::NarrowStageIndices(size_t gap) {
+  alignas(64) int32_t x_idx[16];
+  alignas(64) int32_t y_idx[16];
+  alignas(64) int32_t out_idx[32];
+  alignas(64) int32_t w_idx[16];
+  const int32_t g = static_cast<int32_t>(gap);
+  for (int32_t k = 0; k < 8; ++k) {
+    int32_t pos = (k / g) * 2 * g + k % g;
+    for (int32_t r = 0; r < 2; ++r) {
+      x_idx[2 * k + r] = 2 * pos + r;
+      y_idx[2 * k + r] = 2 * (pos + g) + r;
+      out_idx[2 * pos + r] = 2 * k + r;
+      out_idx[2 * (pos + g) + r] = 16 + 2 * k + r;
+      w_idx[2 * k + r] = 2 * (k / g) + r;
+    }
+  }
+  x = _mm512_load_si512(x_idx);
+  y = _mm512_load_si512(y_idx);
+  out_lo = _mm512_load_si512(out_idx);
+  out_hi = _mm512_load_si512(out_idx + 16);
+  w = _mm512_load_si512(w_idx);
+  w_mask = static_cast<__mmask16>((1U << (16 / gap)) - 1);
+}
+
+// Loads the root of unity power of each butterfly of the register pair
+// starting at complex value c, where W points to the root of unity power of
+// the first block of the stage
+inline __m512 LoadNarrowRoots(const float* W, size_t c, size_t gap,
+                              const NarrowStageIndices& indices) {
+  __m512 v_W = _mm512_maskz_loadu_ps(indices.w_mask, W + c / gap);
+  return _mm512_permutexvar_ps(indices.w, v_W);
+}
+
+// Forward butterflies with distance gap < 8 on the register pair lo, hi
+inline void FwdNarrowButterflies(__m512* v_lo, __m512* v_hi, __m512 v_W,
+                                 const NarrowStageIndices& indices) {
+  __m512 v_X = _mm512_permutex2var_ps(*v_lo, indices.x, *v_hi);
+  __m512 v_Y = _mm512_permutex2var_ps(*v_lo, indices.y, *v_hi);
+  __m512 v_V = MultiplyComplexAVX512(v_Y, _mm512_moveldup_ps(v_W),
+                                     _mm512_movehdup_ps(v_W));
+  __m512 v_X_out = _mm512_add_ps(v_X, v_V);
+  __m512 v_Y_out = _mm512_sub_ps(v_X, v_V);
+  *v_lo = _mm512_permutex2var_ps(v_X_out, indices.out_lo, v_Y_out);
+  *v_hi = _mm512_permutex2var_ps(v_X_out, indices.out_hi, v_Y_out);
+}
+
+// Inverse butterflies with distance gap < 8 on the register pair lo, hi
+inline void InvNarrowButterflies(__m512* v_lo, __m512* v_hi, __m512 v_W,
+                                 const NarrowStageIndices& indices) {
+  __m512 v_X = _mm512_permutex2var_ps(*v_lo, indices.x, *v_hi);
+  __m512 v_Y = _mm512_permutex2var_ps(*v_lo, indices.y, *v_hi);
+  __m512 v_X_out = _mm512_add_ps(v_X, v_Y);
+  __m512 v_Y_out =
+      MultiplyComplexAVX512(_mm512_sub_ps(v_X, v_Y), _mm512_moveldup_ps(v_W),
+                            _mm512_movehdup_ps(v_W));
+  *v_lo = _mm512_permutex2var_ps(v_X_out, indices.out_lo, v_Y_out);
+  *v_hi = _mm512_permutex2var_ps(v_X_out, indices.out_hi, v_Y_out);
+}
+
+// Forward stage m with butterfly distance gap >= 8
+template <typename Input>
+void FwdFloatRadix2StageAVX512(float* result, const Input* operand,
+                               const float* roots, size_t m, size_t gap) {
+  for (size_t i = 0; i < m; i++) {
+    __m512 v_W_real;
+    __m512 v_W_imag;
+    BroadcastComplex(roots + 2 * (m + i), &v_W_real, &v_W_imag);
+    const size_t offset = i * 4 * gap;
+    const Input* X_op = operand + offset;
+    const Input* Y_op = X_op + 2 * gap;
+    float* X_r = result + offset;
+    float* Y_r = X_r + 2 * gap;
+    for (size_t j = 0; j < 2 * gap; j += 16) {
+      __m512 v_X = LoadComplex8(X_op + j);
+      __m512 v_V =
+          MultiplyComplexAVX512(LoadComplex8(Y_op + j), v_W_real, v_W_imag);
+      _mm512_storeu_ps(X_r + j, _mm512_add_ps(v_X, v_V));
+      _mm512_storeu_ps(Y_r + j, _mm512_sub_ps(v_X, v_V));
+    }
+  }
+}
+
+// Forward stages m and 2m in one pass, as ForwardFFTLikeRadix4Stage, with
+// quarter >= 8
+template <typename Input>
+void FwdFloatRadix4StageAVX512(float* result, const Input* operand,
+                               const float* roots, size_t m, size_t quarter) {
+  for (size_t i = 0; i < m; i++) {
+    const float* W1 = roots + 2 * (m + i);
+    const float* W2 = roots + 4 * (m + i);
+    const float W3[2] = {W1[0] * W2[0] - W1[1] * W2[1],
+                         W1[0] * W2[1] + W1[1] * W2[0]};
+    __m512 v_W1_real, v_W1_imag, v_W2_real, v_W2_imag, v_W3_real, v_W3_imag;
+    BroadcastComplex(W1, &v_W1_real, &v_W1_imag);
+    BroadcastComplex(W2, &v_W2_real, &v_W2_imag);
+    BroadcastComplex(W3, &v_W3_real, &v_W3_imag);
+    const size_t offset = i * 8 * quarter;
+    const Input* X_op = operand + offset;
+    float* X_r = result + offset;
+    for (size_t j = 0; j < 2 * quarter; j += 16) {
+      __m512 v_A = LoadComplex8(X_op + j);
+      __m512 v_B = MultiplyComplexAVX512(LoadComplex8(X_op + j + 2 * quarter),
+                                         v_W2_real, v_W2_imag);
+      __m512 v_C = MultiplyComplexAVX512(LoadComplex8(X_op + j + 4 * quarter),
+                                         v_W1_real, v_W1_imag);
+      __m512 v_D = MultiplyComplexAVX512(LoadComplex8(X_op + j + 6 * quarter),
+                                         v_W3_real, v_W3_imag);
+      __m512 v_T0 = _mm512_add_ps(v_A, v_C);
+      __m512 v_T1 = _mm512_sub_ps(v_A, v_C);
+      __m512 v_T2 = _mm512_add_ps(v_B, v_D);
+      __m512 v_T3 = MultiplyByIAVX512(_mm512_sub_ps(v_B, v_D));
+      _mm512_storeu_ps(X_r + j, _mm512_add_ps(v_T0, v_T2));
+      _mm512_storeu_ps(X_r + j + 2 * quarter, _mm512_sub_ps(v_T0, v_T2));
+      _mm512_storeu_ps(X_r + j + 4 * quarter, _mm512_add_ps(v_T1, v_T3));
+      _mm512_storeu_ps(X_r + j + 6 * quarter, _mm512_sub_ps(v_T1, v_T3));
+    }
+  }
+}
+
+// Forward stages with butterfly distance n / 2 down to 16, reading from
+// operand and writing to result
+template <typename Input>
+void FwdFloatWideStagesAVX512(float* result, const Input* operand,
+                              const float* roots, uint64_t n) {
+  const uint64_t num_stages = Log2(n) - 4;
+  size_t m = 1;
+  if (num_stages % 2 == 1) {
+    FwdFloatRadix2StageAVX512(result, operand, roots, 1, n >> 1);
+    m = 2;
+  } else {
+    FwdFloatRadix4StageAVX512(result, operand, roots, 1, n >> 2);
+    m = 4;
+  }
+  for (; m < (n >> 4); m <<= 2) {
+    FwdFloatRadix4StageAVX512(result, result, roots, m, n / (m << 2));
+  }
+}
+
+// Forward stages with butterfly distance 8, 4 and 2 on the register pair
+// starting at complex value c
+struct FwdTailIndices {
+  FwdTailIndices() : gap4(4), gap2(2), gap1(1) {}
+  NarrowStageIndices gap4;
+  NarrowStageIndices gap2;
+  NarrowStageIndices gap1;
+};
+
+inline void FwdTailStagesAVX512(__m512* v_lo, __m512* v_hi, const float* roots,
+                                uint64_t n, size_t c,
+                                const FwdTailIndices& indices) {
+  __m512 v_W_real;
+  __m512 v_W_imag;
+  BroadcastComplex(roots + 2 * (n / 16 + c / 16), &v_W_real, &v_W_imag);
+  __m512 v_V = MultiplyComplexAVX512(*v_hi, v_W_real, v_W_imag);
+  __m512 v_X = *v_lo;
+  *v_lo = _mm512_add_ps(v_X, v_V);
+  *v_hi = _mm512_sub_ps(v_X, v_V);
+  FwdNarrowButterflies(v_lo, v_hi,
+                       LoadNarrowRoots(roots + n / 4, c, 4, indices.gap4),
+                       indices.gap4);
+  FwdNarrowButterflies(v_lo, v_hi,
+                       LoadNarrowRoots(roots + n / 2, c, 2, indices.gap2),
+                       indices.gap2);
+}
+
+// Forward stages with butterfly distance 8 down to 1, in place, in one pass
+// over the data
+void FwdFloatTailAVX512(float* result, const float* roots, uint64_t n,
+                        const float* scalar, bool skip_final_stage) {
+  const FwdTailIndices indices;
+  for (size_t c = 0; c < n; c += 16) {
+    __m512 v_lo = _mm512_loadu_ps(result + 2 * c);
+    __m512 v_hi = _mm512_loadu_ps(result + 2 * c + 16);
+    FwdTailStagesAVX512(&v_lo, &v_hi, roots, n, c, indices);
+    if (!skip_final_stage) {
+      if (scalar != nullptr) {
+        const __m512 v_scalar = _mm512_set1_ps(*scalar);
+        v_lo = _mm512_mul_ps(v_lo, v_scalar);
+        v_hi = _mm512_mul_ps(v_hi, v_scalar);
+      }
+      FwdNarrowButterflies(&v_lo, &v_hi,
+                           LoadNarrowRoots(roots + n, c, 1, indices.gap1),
+                           indices.gap1);
+    }
+    _mm512_storeu_ps(result + 2 * c, v_lo);
+    _mm512_storeu_ps(result + 2 * c + 16, v_hi);
+  }
+}
+
+// As FwdFloatTailAVX512, with the final stage in double precision, writing
+// to result
+void FwdMixedTailAVX512(double* result, const float* operand,
+                        const float* roots, const double* roots_double,
+                        uint64_t n, const double* scalar) {
+  const FwdTailIndices indices;
+  // Interleave the X and Y outputs of 4 butterflies
+  const __m512i v_out_lo = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+  const __m512i v_out_hi = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+  const double scale = scalar != nullptr ? *scalar : 1.0;
+  const __m512d v_scalar = _mm512_set1_pd(scale);
+  for (size_t c = 0; c < n; c += 16) {
+    __m512 v_lo = _mm512_loadu_ps(operand + 2 * c);
+    __m512 v_hi = _mm512_loadu_ps(operand + 2 * c + 16);
+    FwdTailStagesAVX512(&v_lo, &v_hi, roots, n, c, indices);
+    __m512 v_X = _mm512_permutex2var_ps(v_lo, indices.gap1.x, v_hi);
+    __m512 v_Y = _mm512_permutex2var_ps(v_lo, indices.gap1.y, v_hi);
+    for (size_t h = 0; h < 2; ++h) {
+      __m512d v_X_h =
+          _mm512_cvtps_pd(h == 0 ? _mm512_castps512_ps256(v_X)
+                                 : _mm512_extractf32x8_ps(v_X, 1));
+      __m512d v_Y_h =
+          _mm512_cvtps_pd(h == 0 ? _mm512_castps512_ps256(v_Y)
+                                 : _mm512_extractf32x8_ps(v_Y, 1));
+      // Butterflies 4h to 4h + 3 of the register pair
+      __m512d v_W = _mm512_loadu_pd(roots_double + n + c + 8 * h);
+      if (scalar != nullptr) {
+        v_X_h = _mm512_mul_pd(v_X_h, v_scalar);
+        v_W = _mm512_mul_pd(v_W, v_scalar);
+      }
+      __m512d v_V = MultiplyComplexAVX512(v_Y_h, _mm512_movedup_pd(v_W),
+                                          _mm512_permute_pd(v_W, 0xFF));
+      __m512d v_X_out = _mm512_add_pd(v_X_h, v_V);
+      __m512d v_Y_out = _mm512_sub_pd(v_X_h, v_V);
+      double* out = result + 2 * (c + 8 * h);
+      _mm512_storeu_pd(out, _mm512_permutex2var_pd(v_X_out, v_out_lo, v_Y_out));
+      _mm512_storeu_pd(out + 8,
+                       _mm512_permutex2var_pd(v_X_out, v_out_hi, v_Y_out));
+    }
+  }
+}
+
+// Inverse stages with butterfly distance 1 up to 8 in one pass over the data,
+// reading from operand and writing to result
+template <typename Input>
+void InvFloatHeadAVX512(float* result, const Input* operand,
+                        const float* inv_roots, uint64_t n) {
+  const NarrowStageIndices gap1(1);
+  const NarrowStageIndices gap2(2);
+  const NarrowStageIndices gap4(4);
+  // Roots of unity of the stages with distance 1, 2, 4 and 8 start at
+  // indices 1, 1 + n / 2, 1 + 3n / 4 and 1 + 7n / 8
+  const float* W1 = inv_roots + 2;
+  const float* W2 = W1 + n;
+  const float* W4 = W2 + n / 2;
+  const float* W8 = W4 + n / 4;
+  for (size_t c = 0; c < n; c += 16) {
+    __m512 v_lo = LoadComplex8(operand + 2 * c);
+    __m512 v_hi = LoadComplex8(operand + 2 * c + 16);
+    InvNarrowButterflies(&v_lo, &v_hi, LoadNarrowRoots(W1, c, 1, gap1), gap1);
+    InvNarrowButterflies(&v_lo, &v_hi, LoadNarrowRoots(W2, c, 2, gap2), gap2);
+    InvNarrowButterflies(&v_lo, &v_hi, LoadNarrowRoots(W4, c, 4, gap4), gap4);
+    __m512 v_W_real;
+    __m512 v_W_imag;
+    BroadcastComplex(W8 + c / 8, &v_W_real, &v_W_imag);
+    __m512 v_X = v_lo;
+    v_lo = _mm512_add_ps(v_X, v_hi);
+    v_hi = MultiplyComplexAVX512(_mm512_sub_ps(v_X, v_hi), v_W_real, v_W_imag);
+    _mm512_storeu_ps(result + 2 * c, v_lo);
+    _mm512_storeu_ps(result + 2 * c + 16, v_hi);
+  }
+}
+
+// Inverse stage with m blocks and butterfly distance gap >= 8, where W points
+// to the root of unity power of the first block
+void InvFloatRadix2StageAVX512(float* result, const float* W, size_t m,
+                               size_t gap, const float* scalar) {
+  const float scale = scalar != nullptr ? *scalar : 1.0f;
+  const __m512 v_scalar = _mm512_set1_ps(scale);
+  for (size_t i = 0; i < m; i++) {
+    const float W_scaled[2] = {W[2 * i] * scale, W[2 * i + 1] * scale};
+    __m512 v_W_real;
+    __m512 v_W_imag;
+    BroadcastComplex(W_scaled, &v_W_real, &v_W_imag);
+    float* X_r = result + i * 4 * gap;
+    float* Y_r = X_r + 2 * gap;
+    for (size_t j = 0; j < 2 * gap; j += 16) {
+      __m512 v_X = _mm512_loadu_ps(X_r + j);
+      __m512 v_Y = _mm512_loadu_ps(Y_r + j);
+      __m512 v_X_out = _mm512_add_ps(v_X, v_Y);
+      if (scalar != nullptr) {
+        v_X_out = _mm512_mul_ps(v_X_out, v_scalar);
+      }
+      _mm512_storeu_ps(X_r + j, v_X_out);
+      _mm512_storeu_ps(Y_r + j,
+                       MultiplyComplexAVX512(_mm512_sub_ps(v_X, v_Y), v_W_real,
+                                             v_W_imag));
+    }
+  }
+}
+
+// Inverse stages 2m and m in one pass, as InverseFFTLikeRadix4Stage, with
+// quarter >= 8
+void InvFloatRadix4StageAVX512(float* result, const float* inv_roots,
+                               size_t m, size_t quarter, size_t root_index,
+                               const float* scalar) {
+  const float scale = scalar != nullptr ? *scalar : 1.0f;
+  const __m512 v_scalar = _mm512_set1_ps(scale);
+  for (size_t i = 0; i < m; i++) {
+    const float* W1 = inv_roots + 2 * (root_index + 2 * i);
+    const float* W2 = inv_roots + 2 * (root_index + 2 * m + i);
+    const float W1_scaled[2] = {W1[0] * scale, W1[1] * scale};
+    const float W2_scaled[2] = {W2[0] * scale, W2[1] * scale};
+    const float W3_scaled[2] = {(W1[0] * W2[0] - W1[1] * W2[1]) * scale,
+                                (W1[0] * W2[1] + W1[1] * W2[0]) * scale};
+    __m512 v_W1_real, v_W1_imag, v_W2_real, v_W2_imag, v_W3_real, v_W3_imag;
+    BroadcastComplex(W1_scaled, &v_W1_real, &v_W1_imag);
+    BroadcastComplex(W2_scaled, &v_W2_real, &v_W2_imag);
+    BroadcastComplex(W3_scaled, &v_W3_real, &v_W3_imag);
+    float* X_r = result + i * 8 * quarter;
+    for (size_t j = 0; j < 2 * quarter; j += 16) {
+      __m512 v_A = _mm512_loadu_ps(X_r + j);
+      __m512 v_B = _mm512_loadu_ps(X_r + j + 2 * quarter);
+      __m512 v_C = _mm512_loadu_ps(X_r + j + 4 * quarter);
+      __m512 v_D = _mm512_loadu_ps(X_r + j + 6 * quarter);
+      __m512 v_T0 = _mm512_add_ps(v_A, v_B);
+      __m512 v_T1 = _mm512_sub_ps(v_A, v_B);
+      __m512 v_T2 = _mm512_add_ps(v_C, v_D);
+      __m512 v_T3 = MultiplyByIAVX512(_mm512_sub_ps(v_C, v_D));
+      __m512 v_out = _mm512_add_ps(v_T0, v_T2);
+      if (scalar != nullptr) {
+        v_out = _mm512_mul_ps(v_out, v_scalar);
+      }
+      _mm512_storeu_ps(X_r + j, v_out);
+      _mm512_storeu_ps(X_r + j + 2 * quarter,
+                       MultiplyComplexAVX512(_mm512_sub_ps(v_T1, v_T3),
+                                             v_W1_real, v_W1_imag));
+      _mm512_storeu_ps(X_r + j + 4 * quarter,
+                       MultiplyComplexAVX512(_mm512_sub_ps(v_T0, v_T2),
+                                             v_W2_real, v_W2_imag));
+      _mm512_storeu_ps(X_r + j + 6 * quarter,
+                       MultiplyComplexAVX512(_mm512_add_ps(v_T1, v_T3),
+                                             v_W3_real, v_W3_imag));
+    }
+  }
+}
+
+// The first num_stages inverse stages with butterfly distance 16 up to
+// n / 2, in place. The final stage of the transform, if run, applies the
+// scale.
+void InvFloatWideStagesAVX512(float* result, const float* inv_roots,
+                              uint64_t n, uint64_t num_stages,
+                              const float* scalar) {
+  size_t quarter = 16;
+  size_t root_index = 1 + n - n / 16;
+  if (num_stages % 2 == 1) {
+    const size_t m = n >> 5;
+    InvFloatRadix2StageAVX512(result, inv_roots + 2 * root_index, m, 16,
+                              m == 1 ? scalar : nullptr);
+    quarter = 32;
+    root_index += m;
+  }
+  for (size_t m = n / (quarter << 2); quarter < (16ULL << num_stages);
+       root_index += 3 * m, m >>= 2, quarter <<= 2) {
+    InvFloatRadix4StageAVX512(result, inv_roots, m, quarter, root_index,
+                              m == 1 ? scalar : nullptr);
+  }
+}
+
+// Final inverse stage in double precision, reading the float values from
+// operand and writing to result
+void InvMixedFinalStageAVX512(double* result, const float* operand,
+                              const double* inv_roots_double, uint64_t n,
+                              const double* scalar) {
+  const size_t gap = n >> 1;
+  const double scale = scalar != nullptr ? *scalar : 1.0;
+  const __m512d v_scalar = _mm512_set1_pd(scale);
+  const double* W = inv_roots_double + 2 * (n - 1);
+  const __m512d v_W_real = _mm512_set1_pd(W[0] * scale);
+  const __m512d v_W_imag = _mm512_set1_pd(W[1] * scale);
+  const float* X_op = operand;
+  const float* Y_op = operand + 2 * gap;
+  double* X_r = result;
+  double* Y_r = result + 2 * gap;
+  for (size_t j = 0; j < 2 * gap; j += 16) {
+    __m512 v_X = _mm512_loadu_ps(X_op + j);
+    __m512 v_Y = _mm512_loadu_ps(Y_op + j);
+    for (size_t h = 0; h < 2; ++h) {
+      __m512d v_X_h =
+          _mm512_cvtps_pd(h == 0 ? _mm512_castps512_ps256(v_X)
+                                 : _mm512_extractf32x8_ps(v_X, 1));
+      __m512d v_Y_h =
+          _mm512_cvtps_pd(h == 0 ? _mm512_castps512_ps256(v_Y)
+                                 : _mm512_extractf32x8_ps(v_Y, 1));
+      __m512d v_X_out = _mm512_add_pd(v_X_h, v_Y_h);
+      if (scalar != nullptr) {
+        v_X_out = _mm512_mul_pd(v_X_out, v_scalar);
+      }
+      _mm512_storeu_pd(X_r + j + 8 * h, v_X_out);
+      _mm512_storeu_pd(Y_r + j + 8 * h,
+                       MultiplyComplexAVX512(_mm512_sub_pd(v_X_h, v_Y_h),
+                                             v_W_real, v_W_imag));
+    }
+  }
+}
+
+}  // namespace
+
+void Forward_FFTLike_ToBitReverseFloatAVX512(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "n " << n << " is less than 32");
+  HEXL_CHECK(roots_of_unity_cmplx_intrlvd != nullptr,
+             "roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+
+  FwdFloatWideStagesAVX512(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                           roots_of_unity_cmplx_intrlvd, n);
+  FwdFloatTailAVX512(result_cmplx_intrlvd, roots_of_unity_cmplx_intrlvd, n,
+                     scale, skip_final_stage);
+}
+
+void Inverse_FFTLike_FromBitReverseFloatAVX512(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "n " << n << " is less than 32");
+  HEXL_CHECK(inv_roots_of_unity_cmplx_intrlvd != nullptr,
+             "inv_roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+
+  InvFloatHeadAVX512(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                     inv_roots_of_unity_cmplx_intrlvd, n);
+  InvFloatWideStagesAVX512(result_cmplx_intrlvd,
+                           inv_roots_of_unity_cmplx_intrlvd, n,
+                           Log2(n) - 4 - (skip_final_stage ? 1 : 0), scale);
+}
+
+void Forward_FFTLike_ToBitReverseMixedAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd,
+    const double* roots_of_unity_double_cmplx_intrlvd, const uint64_t n,
+    const double* scale, float* buffer_cmplx_intrlvd) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "n " << n << " is less than 32");
+  HEXL_CHECK(roots_of_unity_cmplx_intrlvd != nullptr,
+             "roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(roots_of_unity_double_cmplx_intrlvd != nullptr,
+             "roots_of_unity_double_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(buffer_cmplx_intrlvd != nullptr,
+             "buffer_cmplx_intrlvd == nullptr");
+
+  FwdFloatWideStagesAVX512(buffer_cmplx_intrlvd, operand_cmplx_intrlvd,
+                           roots_of_unity_cmplx_intrlvd, n);
+  FwdMixedTailAVX512(result_cmplx_intrlvd, buffer_cmplx_intrlvd,
+                     roots_of_unity_cmplx_intrlvd,
+                     roots_of_unity_double_cmplx_intrlvd, n, scale);
+}
+
+void Inverse_FFTLike_FromBitReverseMixedAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd,
+    const double* inv_roots_of_unity_double_cmplx_intrlvd, const uint64_t n,
+    const double* scale, float* buffer_cmplx_intrlvd) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "n " << n << " is less than 32");
+  HEXL_CHECK(inv_roots_of_unity_cmplx_intrlvd != nullptr,
+             "inv_roots_of_unity_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(inv_roots_of_unity_double_cmplx_intrlvd != nullptr,
+             "inv_roots_of_unity_double_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(operand_cmplx_intrlvd != nullptr,
+             "operand_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(result_cmplx_intrlvd != nullptr,
+             "result_cmplx_intrlvd == nullptr");
+  HEXL_CHECK(buffer_cmplx_intrlvd != nullptr,
+             "buffer_cmplx_intrlvd == nullptr");
+
+  InvFloatHeadAVX512(buffer_cmplx_intrlvd, operand_cmplx_intrlvd,
+                     inv_roots_of_unity_cmplx_intrlvd, n);
+  InvFloatWideStagesAVX512(buffer_cmplx_intrlvd,
+                           inv_roots_of_unity_cmplx_intrlvd, n, Log2(n) - 5,
+                           nullptr);
+  InvMixedFinalStageAVX512(result_cmplx_intrlvd, buffer_cmplx_intrlvd,
+                           inv_roots_of_unity_double_cmplx_intrlvd, n, scale);
+}
+
+#endif  // HEXL_HAS_AVX512DQ
+
+}  // namespace hexl
+}  // namespace intel
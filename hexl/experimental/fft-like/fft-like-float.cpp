@@ -0,0 +1,187 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/fft-like-float.hpp"
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+#include "hexl/experimental/fft-like/fft-like-float-avx512.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/logging/logging.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+FFTLikeFloat::FFTLikeFloat(uint64_t degree,
+                           std::shared_ptr<AllocatorBase> alloc_ptr)
+    : m_fft_like(degree, alloc_ptr),
+      m_aligned_alloc(AlignedAllocator<std::complex<float>, 64>(alloc_ptr)),
+      m_complex_roots_of_unity(m_aligned_alloc),
+      m_inv_complex_roots_of_unity(m_aligned_alloc) {
+  // Rounding the double precision roots gives correctly rounded floats
+  const auto& roots = m_fft_like.GetComplexRootsOfUnity();
+  const auto& inv_roots = m_fft_like.GetInvComplexRootsOfUnity();
+  m_complex_roots_of_unity.assign(roots.begin(), roots.end());
+  m_inv_complex_roots_of_unity.assign(inv_roots.begin(), inv_roots.end());
+}
+
+void FFTLikeFloat::ForwardFloat(std::complex<float>* result,
+                                const std::complex<float>* operand,
+                                const float* in_scale,
+                                bool skip_final_stage) const {
+  const uint64_t degree = GetDegree();
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && degree >= 32) {
+    HEXL_VLOG(3, "Calling 32-bit AVX512-DQ FwdFFTLikeFloat");
+    Forward_FFTLike_ToBitReverseFloatAVX512(
+        &(reinterpret_cast<float(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(m_complex_roots_of_unity[0]))[0],
+        degree, in_scale, skip_final_stage);
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    HEXL_VLOG(3, "Calling 32-bit AVX2 FwdFFTLikeFloat");
+    Forward_FFTLike_ToBitReverseFloatAVX2(
+        &(reinterpret_cast<float(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(m_complex_roots_of_unity[0]))[0],
+        degree, in_scale, skip_final_stage);
+    return;
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling Native FwdFFTLikeFloat");
+  Forward_FFTLike_ToBitReverseFloat(result, operand,
+                                    m_complex_roots_of_unity.data(), degree,
+                                    in_scale, skip_final_stage);
+}
+
+void FFTLikeFloat::InverseFloat(std::complex<float>* result,
+                                const std::complex<float>* operand,
+                                const float* in_scale,
+                                bool skip_final_stage) const {
+  const uint64_t degree = GetDegree();
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && degree >= 32) {
+    HEXL_VLOG(3, "Calling 32-bit AVX512-DQ InvFFTLikeFloat");
+    Inverse_FFTLike_FromBitReverseFloatAVX512(
+        &(reinterpret_cast<float(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(
+            m_inv_complex_roots_of_unity[0]))[0],
+        degree, in_scale, skip_final_stage);
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    HEXL_VLOG(3, "Calling 32-bit AVX2 InvFFTLikeFloat");
+    Inverse_FFTLike_FromBitReverseFloatAVX2(
+        &(reinterpret_cast<float(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(
+            m_inv_complex_roots_of_unity[0]))[0],
+        degree, in_scale, skip_final_stage);
+    return;
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling Native InvFFTLikeFloat");
+  Inverse_FFTLike_FromBitReverseFloat(result, operand,
+                                      m_inv_complex_roots_of_unity.data(),
+                                      degree, in_scale, skip_final_stage);
+}
+
+void FFTLikeFloat::ComputeForwardFFTLike(std::complex<float>* result,
+                                         const std::complex<float>* operand,
+                                         const float* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  ForwardFloat(result, operand, in_scale, false);
+}
+
+void FFTLikeFloat::ComputeInverseFFTLike(std::complex<float>* result,
+                                         const std::complex<float>* operand,
+                                         const float* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  InverseFloat(result, operand, in_scale, false);
+}
+
+void FFTLikeFloat::ComputeForwardFFTLikeMixed(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const double* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+
+  const uint64_t degree = GetDegree();
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && degree >= 32) {
+    HEXL_VLOG(3, "Calling AVX512-DQ FwdFFTLikeMixed");
+    AlignedVector64<std::complex<float>> buffer(degree, m_aligned_alloc);
+    Forward_FFTLike_ToBitReverseMixedAVX512(
+        &(reinterpret_cast<double(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(m_complex_roots_of_unity[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(
+            m_fft_like.GetComplexRootsOfUnity()[0]))[0],
+        degree, in_scale, &(reinterpret_cast<float(&)[2]>(buffer[0]))[0]);
+    return;
+  }
+#endif
+
+  // Single precision stages on a rounded copy of the operand
+  AlignedVector64<std::complex<float>> buffer(operand, operand + degree,
+                                              m_aligned_alloc);
+  ForwardFloat(buffer.data(), buffer.data(), nullptr, true);
+  HEXL_VLOG(3, "Calling Native FwdFFTLikeMixed final stage");
+  Forward_FFTLike_FinalStageMixed(result, buffer.data(),
+                                  m_fft_like.GetComplexRootsOfUnity().data(),
+                                  degree, in_scale);
+}
+
+void FFTLikeFloat::ComputeInverseFFTLikeMixed(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const double* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+
+  const uint64_t degree = GetDegree();
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && degree >= 32) {
+    HEXL_VLOG(3, "Calling AVX512-DQ InvFFTLikeMixed");
+    AlignedVector64<std::complex<float>> buffer(degree, m_aligned_alloc);
+    Inverse_FFTLike_FromBitReverseMixedAVX512(
+        &(reinterpret_cast<double(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const float(&)[2]>(
+            m_inv_complex_roots_of_unity[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(
+            m_fft_like.GetInvComplexRootsOfUnity()[0]))[0],
+        degree, in_scale, &(reinterpret_cast<float(&)[2]>(buffer[0]))[0]);
+    return;
+  }
+#endif
+
+  // Single precision stages on a rounded copy of the operand
+  AlignedVector64<std::complex<float>> buffer(operand, operand + degree,
+                                              m_aligned_alloc);
+  InverseFloat(buffer.data(), buffer.data(), nullptr, true);
+  HEXL_VLOG(3, "Calling Native InvFFTLikeMixed final stage");
+  Inverse_FFTLike_FinalStageMixed(
+      result, buffer.data(), m_fft_like.GetInvComplexRootsOfUnity().data(),
+      degree, in_scale);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,35 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <complex>
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+/// @brief Runs the in-place butterfly stages of
+/// Forward_FFTLike_ToBitReverseRadix2 after the first one, which combines
+/// result[j] and result[j + n / 2] with root of unity power 1
+/// @param[in] scalar Scale applied to output values; may be nullptr
+void Forward_FFTLike_ToBitReverseRadix2Stages(
+    std::complex<double>* result,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scalar);
+
+/// @brief Runs the butterfly stages of Inverse_FFTLike_FromBitReverseRadix2
+/// without any scaling
+/// @param[in] skip_final_stage If true, stops before the final stage, which
+/// combines result[j] and result[j + n / 2] with inverse root of unity power
+/// n - 1. Callers then fuse their own work into that stage.
+void Inverse_FFTLike_FromBitReverseRadix2Stages(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    bool skip_final_stage);
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
@@ -3,8 +3,10 @@
 
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 
+#include <cmath>
 #include <cstring>
 
+#include "experimental/fft-like/fft-like-native-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "util/util-internal.hpp"
 
@@ -121,7 +123,18 @@ void Forward_FFTLike_ToBitReverseRadix2(
     gap >>= 1;
   }
 
-  // Continue with in-place operation
+  internal::Forward_FFTLike_ToBitReverseRadix2Stages(
+      result, root_of_unity_powers, n, scalar);
+}
+
+namespace internal {
+
+void Forward_FFTLike_ToBitReverseRadix2Stages(
+    std::complex<double>* result,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  size_t gap = (n >> 2);
+
   for (size_t m = 2; m < n; m <<= 1) {
     size_t offset = 0;
     switch (gap) {
@@ -236,21 +249,15 @@ void Forward_FFTLike_ToBitReverseRadix2(
   }
 }
 
-void Inverse_FFTLike_FromBitReverseRadix2(
+void Inverse_FFTLike_FromBitReverseRadix2Stages(
     std::complex<double>* result, const std::complex<double>* operand,
     const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
-    const double* scalar) {
-  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
-  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
-             "inv_root_of_unity_powers == nullptr");
-  HEXL_CHECK(operand != nullptr, "operand == nullptr");
-  HEXL_CHECK(result != nullptr, "result == nullptr");
-
+    bool skip_final_stage) {
   uint64_t n_div_2 = (n >> 1);
   size_t gap = 1;
   size_t root_index = 1;
 
-  size_t stop_loop = (scalar == nullptr) ? 0 : 1;
+  size_t stop_loop = skip_final_stage ? 1 : 0;
   size_t m = n_div_2;
   for (; m > stop_loop; m >>= 1) {
     size_t offset = 0;
@@ -351,8 +358,26 @@ void Inverse_FFTLike_FromBitReverseRadix2(
     }
     gap <<= 1;
   }
+}
+
+}  // namespace internal
+
+void Inverse_FFTLike_FromBitReverseRadix2(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  internal::Inverse_FFTLike_FromBitReverseRadix2Stages(
+      result, operand, inv_root_of_unity_powers, n, scalar != nullptr);
 
-  if (m > 0) {
+  if (scalar != nullptr && n > 1) {
+    size_t gap = (n >> 1);
+    size_t root_index = n - 1;
     const std::complex<double> W =
         *scalar * inv_root_of_unity_powers[root_index];
     std::complex<double>* X_r = result;
@@ -419,5 +444,600 @@ void Inverse_FFTLike_FromBitReverseRadix2(
   }
 }
 
+// Complex product without the inf and NaN handling of std::complex, which
+// the compiler may otherwise call out of line on every iteration
+template <typename T>
+inline std::complex<T> MultiplyComplex(const std::complex<T>& x,
+                                       const std::complex<T>& y) {
+  return std::complex<T>(x.real() * y.real() - x.imag() * y.imag(),
+                         x.real() * y.imag() + x.imag() * y.real());
+}
+
+// The stage templates below take the complex type as Complex, so the double
+// transforms and the single precision ones share them.
+
+// One stage of Forward_FFTLike_ToBitReverseRadix2Batch, reading from operand
+// and writing to result. Gap > 0 fixes the distance between butterfly inputs
+// at compile time so the short inner loops are unrolled; Gap == 0 uses gap.
+template <size_t Gap, typename Complex>
+void ForwardFFTLikeBatchStage(Complex* result, const Complex* operand,
+                              const Complex* root_of_unity_powers, uint64_t n,
+                              uint64_t batch_size, size_t m, size_t gap,
+                              const typename Complex::value_type* scalar) {
+  gap = Gap > 0 ? Gap : gap;
+  for (size_t i = 0; i < m; i++) {
+    const size_t offset = i * (gap << 1);
+    const Complex W = scalar != nullptr ? *scalar * root_of_unity_powers[m + i]
+                                        : root_of_unity_powers[m + i];
+    for (size_t b = 0; b < batch_size; b++) {
+      Complex* X_r = result + b * n + offset;
+      Complex* Y_r = X_r + gap;
+      const Complex* X_op = operand + b * n + offset;
+      const Complex* Y_op = X_op + gap;
+      for (size_t j = 0; j < gap; j++) {
+        Complex U = scalar != nullptr ? (*scalar) * X_op[j] : X_op[j];
+        Complex V = MultiplyComplex(Y_op[j], W);
+        X_r[j] = U + V;
+        Y_r[j] = U - V;
+      }
+    }
+  }
+}
+
+void Forward_FFTLike_ToBitReverseRadix2Batch(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const uint64_t batch_size, const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  // Same butterflies as Forward_FFTLike_ToBitReverseRadix2, with the loop
+  // over the batch inside the loop over the root of unity powers. The first
+  // stage is out of place and the last one applies the scale.
+  ForwardFFTLikeBatchStage<0>(result, operand, root_of_unity_powers, n,
+                              batch_size, 1, n >> 1, nullptr);
+  size_t gap = (n >> 2);
+  for (size_t m = 2; m < n; m <<= 1, gap >>= 1) {
+    switch (gap) {
+      case 1:
+        ForwardFFTLikeBatchStage<1>(result, result, root_of_unity_powers, n,
+                                    batch_size, m, gap, scalar);
+        break;
+      case 2:
+        ForwardFFTLikeBatchStage<2>(result, result, root_of_unity_powers, n,
+                                    batch_size, m, gap, nullptr);
+        break;
+      case 4:
+        ForwardFFTLikeBatchStage<4>(result, result, root_of_unity_powers, n,
+                                    batch_size, m, gap, nullptr);
+        break;
+      default:
+        ForwardFFTLikeBatchStage<0>(result, result, root_of_unity_powers, n,
+                                    batch_size, m, gap, nullptr);
+    }
+  }
+}
+
+// One stage of Inverse_FFTLike_FromBitReverseRadix2Batch, reading from
+// operand and writing to result. Gap > 0 fixes the distance between butterfly
+// inputs at compile time so the short inner loops are unrolled; Gap == 0 uses
+// gap.
+template <size_t Gap, typename Complex>
+void InverseFFTLikeBatchStage(Complex* result, const Complex* operand,
+                              const Complex* inv_root_of_unity_powers,
+                              uint64_t n, uint64_t batch_size, size_t m,
+                              size_t gap, size_t root_index,
+                              const typename Complex::value_type* scalar) {
+  gap = Gap > 0 ? Gap : gap;
+  for (size_t i = 0; i < m; i++, root_index++) {
+    const size_t offset = i * (gap << 1);
+    const Complex W = scalar != nullptr
+                          ? *scalar * inv_root_of_unity_powers[root_index]
+                          : inv_root_of_unity_powers[root_index];
+    for (size_t b = 0; b < batch_size; b++) {
+      Complex* X_r = result + b * n + offset;
+      Complex* Y_r = X_r + gap;
+      const Complex* X_op = operand + b * n + offset;
+      const Complex* Y_op = X_op + gap;
+      for (size_t j = 0; j < gap; j++) {
+        Complex U = X_op[j];
+        Complex V = Y_op[j];
+        X_r[j] = scalar != nullptr ? (U + V) * (*scalar) : U + V;
+        Y_r[j] = MultiplyComplex(U - V, W);
+      }
+    }
+  }
+}
+
+void Inverse_FFTLike_FromBitReverseRadix2Batch(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const uint64_t batch_size, const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  // Same butterflies as Inverse_FFTLike_FromBitReverseRadix2, with the loop
+  // over the batch inside the loop over the root of unity powers. The first
+  // stage is out of place and the last one applies the scale.
+  InverseFFTLikeBatchStage<1>(result, operand, inv_root_of_unity_powers, n,
+                              batch_size, n >> 1, 1, 1, nullptr);
+  size_t gap = 2;
+  size_t root_index = 1 + (n >> 1);
+  for (size_t m = (n >> 2); m > 0; root_index += m, m >>= 1, gap <<= 1) {
+    const double* stage_scalar = (m == 1) ? scalar : nullptr;
+    switch (gap) {
+      case 2:
+        InverseFFTLikeBatchStage<2>(result, result, inv_root_of_unity_powers,
+                                    n, batch_size, m, gap, root_index,
+                                    stage_scalar);
+        break;
+      case 4:
+        InverseFFTLikeBatchStage<4>(result, result, inv_root_of_unity_powers,
+                                    n, batch_size, m, gap, root_index,
+                                    stage_scalar);
+        break;
+      default:
+        InverseFFTLikeBatchStage<0>(result, result, inv_root_of_unity_powers,
+                                    n, batch_size, m, gap, root_index,
+                                    stage_scalar);
+    }
+  }
+}
+
+// Multiplies x by the imaginary unit
+template <typename T>
+inline std::complex<T> MultiplyByI(const std::complex<T>& x) {
+  return std::complex<T>(-x.imag(), x.real());
+}
+
+// Radix-2 stages m and 2m of Forward_FFTLike_ToBitReverseRadix2 in a single
+// pass, reading from operand and writing to result. Stage m has butterflies
+// with distance 2 * quarter and stage 2m with distance quarter. The root of
+// stage 2m on the odd block, root_of_unity_powers[2 * (m + i) + 1], equals
+// i * root_of_unity_powers[2 * (m + i)], so each group of four values takes
+// three complex multiplications. Quarter > 0 fixes quarter at compile time.
+template <size_t Quarter, typename Complex>
+void ForwardFFTLikeRadix4Stage(Complex* result, const Complex* operand,
+                               const Complex* root_of_unity_powers, size_t m,
+                               size_t quarter,
+                               const typename Complex::value_type* scalar) {
+  quarter = Quarter > 0 ? Quarter : quarter;
+  for (size_t i = 0; i < m; i++) {
+    const size_t offset = i * (quarter << 2);
+    Complex W1 = root_of_unity_powers[m + i];
+    Complex W2 = root_of_unity_powers[(m + i) << 1];
+    Complex W3 = MultiplyComplex(W1, W2);
+    if (scalar != nullptr) {
+      W1 *= *scalar;
+      W2 *= *scalar;
+      W3 *= *scalar;
+    }
+    Complex* X_r = result + offset;
+    const Complex* X_op = operand + offset;
+    for (size_t j = 0; j < quarter; j++) {
+      Complex A = scalar != nullptr ? (*scalar) * X_op[j] : X_op[j];
+      Complex B = MultiplyComplex(X_op[j + quarter], W2);
+      Complex C = MultiplyComplex(X_op[j + 2 * quarter], W1);
+      Complex D = MultiplyComplex(X_op[j + 3 * quarter], W3);
+      Complex T0 = A + C;
+      Complex T1 = A - C;
+      Complex T2 = B + D;
+      Complex T3 = MultiplyByI(B - D);
+      X_r[j] = T0 + T2;
+      X_r[j + quarter] = T0 - T2;
+      X_r[j + 2 * quarter] = T1 + T3;
+      X_r[j + 3 * quarter] = T1 - T3;
+    }
+  }
+}
+
+// Runs the first num_stages radix-2 stages of the forward transform, merged
+// in pairs by ForwardFFTLikeRadix4Stage. With an odd number of stages, the
+// first one stays radix-2. The first pass is out of place and the final stage
+// of the transform, if run, applies the scale.
+template <typename Complex>
+void ForwardFFTLikeRadix4Stages(Complex* result, const Complex* operand,
+                                const Complex* root_of_unity_powers,
+                                const uint64_t n, uint64_t num_stages,
+                                const typename Complex::value_type* scalar) {
+  const Complex* input = operand;
+  size_t m = 1;
+  if (num_stages % 2 == 1) {
+    ForwardFFTLikeBatchStage<0>(result, operand, root_of_unity_powers, n, 1, 1,
+                                n >> 1, nullptr);
+    input = result;
+    m = 2;
+  }
+  for (size_t quarter = n / (m << 2); m < (1ULL << num_stages);
+       m <<= 2, quarter >>= 2) {
+    const typename Complex::value_type* stage_scalar =
+        (quarter == 1) ? scalar : nullptr;
+    switch (quarter) {
+      case 1:
+        ForwardFFTLikeRadix4Stage<1>(result, input, root_of_unity_powers, m,
+                                     quarter, stage_scalar);
+        break;
+      case 2:
+        ForwardFFTLikeRadix4Stage<2>(result, input, root_of_unity_powers, m,
+                                     quarter, stage_scalar);
+        break;
+      default:
+        ForwardFFTLikeRadix4Stage<0>(result, input, root_of_unity_powers, m,
+                                     quarter, stage_scalar);
+    }
+    input = result;
+  }
+}
+
+void Forward_FFTLike_ToBitReverseRadix4(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  ForwardFFTLikeRadix4Stages(result, operand, root_of_unity_powers, n,
+                             Log2(n), scalar);
+}
+
+// Radix-2 stages 2m and m of Inverse_FFTLike_FromBitReverseRadix2 in a single
+// pass, reading from operand and writing to result. Stage 2m has butterflies
+// with distance quarter and roots starting at root_index, stage m has
+// distance 2 * quarter. The root of stage 2m on the odd block,
+// inv_root_of_unity_powers[root_index + 2 * i + 1], equals
+// -i * inv_root_of_unity_powers[root_index + 2 * i], so each group of four
+// values takes three complex multiplications. Quarter > 0 fixes quarter at
+// compile time.
+template <size_t Quarter, typename Complex>
+void InverseFFTLikeRadix4Stage(Complex* result, const Complex* operand,
+                               const Complex* inv_root_of_unity_powers,
+                               size_t m, size_t quarter, size_t root_index,
+                               const typename Complex::value_type* scalar) {
+  quarter = Quarter > 0 ? Quarter : quarter;
+  for (size_t i = 0; i < m; i++) {
+    const size_t offset = i * (quarter << 2);
+    Complex W1 = inv_root_of_unity_powers[root_index + 2 * i];
+    Complex W2 = inv_root_of_unity_powers[root_index + 2 * m + i];
+    Complex W3 = MultiplyComplex(W1, W2);
+    if (scalar != nullptr) {
+      W1 *= *scalar;
+      W2 *= *scalar;
+      W3 *= *scalar;
+    }
+    Complex* X_r = result + offset;
+    const Complex* X_op = operand + offset;
+    for (size_t j = 0; j < quarter; j++) {
+      Complex A = X_op[j];
+      Complex B = X_op[j + quarter];
+      Complex C = X_op[j + 2 * quarter];
+      Complex D = X_op[j + 3 * quarter];
+      Complex T0 = A + B;
+      Complex T1 = A - B;
+      Complex T2 = C + D;
+      Complex T3 = MultiplyByI(C - D);
+      X_r[j] = scalar != nullptr ? (T0 + T2) * (*scalar) : T0 + T2;
+      X_r[j + quarter] = MultiplyComplex(T1 - T3, W1);
+      X_r[j + 2 * quarter] = MultiplyComplex(T0 - T2, W2);
+      X_r[j + 3 * quarter] = MultiplyComplex(T1 + T3, W3);
+    }
+  }
+}
+
+// Runs the first num_stages radix-2 stages of the inverse transform, merged
+// in pairs by InverseFFTLikeRadix4Stage. With an odd number of stages, the
+// first one stays radix-2. The first pass is out of place and the final stage
+// of the transform, if run, applies the scale.
+template <typename Complex>
+void InverseFFTLikeRadix4Stages(Complex* result, const Complex* operand,
+                                const Complex* inv_root_of_unity_powers,
+                                const uint64_t n, uint64_t num_stages,
+                                const typename Complex::value_type* scalar) {
+  const Complex* input = operand;
+  size_t quarter = 1;
+  size_t root_index = 1;
+  if (num_stages % 2 == 1) {
+    InverseFFTLikeBatchStage<1>(result, operand, inv_root_of_unity_powers, n,
+                                1, n >> 1, 1, 1, nullptr);
+    input = result;
+    quarter = 2;
+    root_index += n >> 1;
+  }
+  for (size_t m = n / (quarter << 2); quarter < (1ULL << num_stages);
+       root_index += 3 * m, m >>= 2, quarter <<= 2) {
+    const typename Complex::value_type* stage_scalar =
+        (m == 1) ? scalar : nullptr;
+    switch (quarter) {
+      case 1:
+        InverseFFTLikeRadix4Stage<1>(result, input, inv_root_of_unity_powers,
+                                     m, quarter, root_index, stage_scalar);
+        break;
+      case 2:
+        InverseFFTLikeRadix4Stage<2>(result, input, inv_root_of_unity_powers,
+                                     m, quarter, root_index, stage_scalar);
+        break;
+      default:
+        InverseFFTLikeRadix4Stage<0>(result, input, inv_root_of_unity_powers,
+                                     m, quarter, root_index, stage_scalar);
+    }
+    input = result;
+  }
+}
+
+void Inverse_FFTLike_FromBitReverseRadix4(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  InverseFFTLikeRadix4Stages(result, operand, inv_root_of_unity_powers, n,
+                             Log2(n), scalar);
+}
+
+void Forward_FFTLike_ToSlots(std::complex<double>* slots,
+                             const std::complex<double>* operand,
+                             const std::complex<double>* root_of_unity_powers,
+                             const uint64_t* slot_positions, const uint64_t n,
+                             const double* scalar,
+                             std::complex<double>* buffer) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16, "degree " << n << " is less than 16");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(slot_positions != nullptr, "slot_positions == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(slots != nullptr, "slots == nullptr");
+  HEXL_CHECK(buffer != nullptr, "buffer == nullptr");
+
+  const size_t half_n = n >> 1;
+
+  // First stage, keeping only the outputs in the first half
+  const std::complex<double> W = root_of_unity_powers[1];
+  for (size_t j = 0; j < half_n; j++) {
+    buffer[j] = operand[j] + MultiplyComplex(operand[j + half_n], W);
+  }
+
+  // Stage m of the transform has m / 2 blocks in the first half, with roots
+  // root_of_unity_powers[m + i], so the stages run on root_of_unity_powers
+  // offset by m / 2
+  size_t gap = n >> 2;
+  for (size_t m = 2; gap > 0; m <<= 1, gap >>= 1) {
+    const std::complex<double>* roots = root_of_unity_powers + (m >> 1);
+    switch (gap) {
+      case 1:
+        ForwardFFTLikeBatchStage<1>(buffer, buffer, roots, half_n, 1, m >> 1,
+                                    gap, scalar);
+        break;
+      case 2:
+        ForwardFFTLikeBatchStage<2>(buffer, buffer, roots, half_n, 1, m >> 1,
+                                    gap, nullptr);
+        break;
+      case 4:
+        ForwardFFTLikeBatchStage<4>(buffer, buffer, roots, half_n, 1, m >> 1,
+                                    gap, nullptr);
+        break;
+      default:
+        ForwardFFTLikeBatchStage<0>(buffer, buffer, roots, half_n, 1, m >> 1,
+                                    gap, nullptr);
+    }
+  }
+
+  for (size_t i = 0; i < half_n; i++) {
+    slots[i] = buffer[slot_positions[i]];
+  }
+}
+
+void Inverse_FFTLike_FromSlots(
+    std::complex<double>* result, const std::complex<double>* slots,
+    const std::complex<double>* inv_root_of_unity_powers,
+    const uint64_t* slot_index, const uint64_t n, const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16, "degree " << n << " is less than 16");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(slot_index != nullptr, "slot_index == nullptr");
+  HEXL_CHECK(slots != nullptr, "slots == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  const size_t half_n = n >> 1;
+  const size_t quarter_n = n >> 2;
+
+  // First stage, reading each input from its slot
+  for (size_t i = 0; i < quarter_n; i++) {
+    std::complex<double> U = slots[slot_index[2 * i]];
+    std::complex<double> V = slots[slot_index[2 * i + 1]];
+    result[2 * i] = U + V;
+    result[2 * i + 1] =
+        MultiplyComplex(U - V, inv_root_of_unity_powers[1 + i]);
+  }
+
+  // Stage m of the transform has m / 2 blocks in the first half, whose roots
+  // are the first m / 2 of the stage
+  size_t root_index = 1 + half_n;
+  size_t gap = 2;
+  for (size_t m = quarter_n; m > 2; root_index += m, m >>= 1, gap <<= 1) {
+    switch (gap) {
+      case 2:
+        InverseFFTLikeBatchStage<2>(result, result, inv_root_of_unity_powers,
+                                    half_n, 1, m >> 1, gap, root_index,
+                                    nullptr);
+        break;
+      case 4:
+        InverseFFTLikeBatchStage<4>(result, result, inv_root_of_unity_powers,
+                                    half_n, 1, m >> 1, gap, root_index,
+                                    nullptr);
+        break;
+      default:
+        InverseFFTLikeBatchStage<0>(result, result, inv_root_of_unity_powers,
+                                    half_n, 1, m >> 1, gap, root_index,
+                                    nullptr);
+    }
+  }
+
+  // Last stage of the first half, fused with the final stage of the
+  // transform. Its outputs are real, 2 * Re(X[j]) and 2 * Im(X[j]) for the
+  // output X[j] of the first half.
+  const std::complex<double> W = inv_root_of_unity_powers[root_index];
+  const double factor = 2.0 * (scalar != nullptr ? *scalar : 1.0);
+  for (size_t j = 0; j < quarter_n; j++) {
+    std::complex<double> U = result[j];
+    std::complex<double> V = result[j + quarter_n];
+    std::complex<double> X0 = U + V;
+    std::complex<double> X1 = MultiplyComplex(U - V, W);
+    result[j] = std::complex<double>(factor * X0.real(), 0.0);
+    result[j + quarter_n] = std::complex<double>(factor * X1.real(), 0.0);
+    result[j + half_n] = std::complex<double>(factor * X0.imag(), 0.0);
+    result[j + half_n + quarter_n] =
+        std::complex<double>(factor * X1.imag(), 0.0);
+  }
+}
+
+void Forward_FFTLike_ToBitReverseFloat(
+    std::complex<float>* result, const std::complex<float>* operand,
+    const std::complex<float>* root_of_unity_powers, const uint64_t n,
+    const float* scalar, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  ForwardFFTLikeRadix4Stages(result, operand, root_of_unity_powers, n,
+                             Log2(n) - (skip_final_stage ? 1 : 0), scalar);
+}
+
+void Inverse_FFTLike_FromBitReverseFloat(
+    std::complex<float>* result, const std::complex<float>* operand,
+    const std::complex<float>* inv_root_of_unity_powers, const uint64_t n,
+    const float* scalar, bool skip_final_stage) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  InverseFFTLikeRadix4Stages(result, operand, inv_root_of_unity_powers, n,
+                             Log2(n) - (skip_final_stage ? 1 : 0), scalar);
+}
+
+void Forward_FFTLike_FinalStageMixed(
+    std::complex<double>* result, const std::complex<float>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  // Stage m = n / 2 of the forward transform, with distance 1
+  const size_t m = n >> 1;
+  for (size_t i = 0; i < m; i++) {
+    std::complex<double> W = root_of_unity_powers[m + i];
+    std::complex<double> U(operand[2 * i]);
+    std::complex<double> Y(operand[2 * i + 1]);
+    if (scalar != nullptr) {
+      W *= *scalar;
+      U *= *scalar;
+    }
+    std::complex<double> V = MultiplyComplex(Y, W);
+    result[2 * i] = U + V;
+    result[2 * i + 1] = U - V;
+  }
+}
+
+void Inverse_FFTLike_FinalStageMixed(
+    std::complex<double>* result, const std::complex<float>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 4, "degree " << n << " is less than 4");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+
+  // Stage m = 1 of the inverse transform, with distance n / 2
+  const size_t gap = n >> 1;
+  std::complex<double> W = inv_root_of_unity_powers[n - 1];
+  double scale = 1.0;
+  if (scalar != nullptr) {
+    W *= *scalar;
+    scale = *scalar;
+  }
+  for (size_t j = 0; j < gap; j++) {
+    std::complex<double> U(operand[j]);
+    std::complex<double> V(operand[j + gap]);
+    result[j] = (U + V) * scale;
+    result[j + gap] = MultiplyComplex(U - V, W);
+  }
+}
+
+void BuildFloatingPointsNative(std::complex<double>* res,
+                               const uint64_t* plain,
+                               const uint64_t* threshold,
+                               const uint64_t* decryption_modulus,
+                               const double inv_scale, const size_t mod_size,
+                               const size_t coeff_count) {
+  const double two_pow_64 = std::pow(2.0, 64);
+
+  for (size_t i = 0; i < coeff_count; i++) {
+    const uint64_t* coeff = plain + i * mod_size;
+
+    // Compare against the threshold from the most significant word down
+    bool is_negative = true;
+    for (size_t j = mod_size; j-- > 0;) {
+      if (coeff[j] != threshold[j]) {
+        is_negative = coeff[j] > threshold[j];
+        break;
+      }
+    }
+
+    // Accumulate in the same order as BuildFloatingPointsAVX512, so both give
+    // bit-identical results
+    double res_real = 0.0;
+    double scaled_two_pow_64 = inv_scale;
+    for (size_t j = 0; j < mod_size; j++, scaled_two_pow_64 *= two_pow_64) {
+      uint64_t curr_coeff = coeff[j];
+      bool subtract = false;
+      uint64_t diff = curr_coeff;
+      if (is_negative) {
+        if (curr_coeff > decryption_modulus[j]) {
+          diff = curr_coeff - decryption_modulus[j];
+        } else {
+          diff = decryption_modulus[j] - curr_coeff;
+          subtract = true;
+        }
+      }
+      // Skipping zero words avoids multiplying by inf for large mod_size
+      if (diff == 0) {
+        continue;
+      }
+      double scaled_diff = static_cast<double>(diff) * scaled_two_pow_64;
+      res_real = subtract ? res_real - scaled_diff : res_real + scaled_diff;
+    }
+    res[i] = std::complex<double>(res_real, 0.0);
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -3,30 +3,51 @@
 
 #include "hexl/experimental/fft-like/fft-like.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/logging/logging.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
 
-FFTLike::FFTLike(uint64_t degree, double* in_scalar,
-                 std::shared_ptr<AllocatorBase> alloc_ptr)
+namespace {
+
+std::atomic<uint64_t> fft_like_num_threads{0};
+
+// Number of complex values the native batched transforms process at a time.
+// Keeps each group of vectors in the L2 cache.
+constexpr uint64_t kFFTLikeBatchGroupSize = 1ULL << 14;
+
+// Degree from which a single AVX512 transform is split across threads.
+// Smaller transforms fit in the L2 cache, so threading does not pay off.
+constexpr uint64_t kFFTLikeParallelDegree = 1ULL << 15;
+
+}  // namespace
+
+void SetFFTLikeNumThreads(uint64_t num_threads) {
+  fft_like_num_threads.store(num_threads);
+}
+
+uint64_t GetFFTLikeNumThreads() { return fft_like_num_threads.load(); }
+
+FFTLike::FFTLike(uint64_t degree, std::shared_ptr<AllocatorBase> alloc_ptr)
     : m_degree(degree),
-      scalar(in_scalar),
       m_alloc(alloc_ptr),
       m_aligned_alloc(AlignedAllocator<double, 64>(m_alloc)),
-      m_complex_roots_of_unity(m_aligned_alloc) {
+      m_complex_roots_of_unity(m_aligned_alloc),
+      m_slot_index(m_aligned_alloc),
+      m_slot_positions(m_aligned_alloc) {
   HEXL_CHECK(IsPowerOfTwo(degree),
              "degree " << degree << " is not a power of 2");
   HEXL_CHECK(degree > 8, "degree should be bigger than 8");
 
   m_degree_bits = Log2(m_degree);
   ComputeComplexRootsOfUnity();
-
-  if (scalar != nullptr) {
-    scale = *scalar / static_cast<double>(degree);
-    inv_scale = 1.0 / *scalar;
-  }
+  ComputeSlotIndex();
 }
 
 inline std::complex<double> swap_real_imag(std::complex<double> c) {
@@ -70,91 +91,234 @@ void FFTLike::ComputeComplexRootsOfUnity() {
   m_inv_complex_roots_of_unity = inv_roots_in_bit_reverse;
 }
 
+void FFTLike::ComputeSlotIndex() {
+  // Slot i is at the bit-reversed position of (5^i mod 2n - 1) / 2. As
+  // 5^i = 1 mod 4, that position is even, so its bit reversal is below n / 2.
+  const uint64_t half_n = m_degree >> 1;
+  const uint64_t mask = (m_degree << 1) - 1;
+  m_slot_index.assign(half_n, 0);
+  m_slot_positions.assign(half_n, 0);
+  uint64_t power = 1;
+  for (uint64_t i = 0; i < half_n; i++) {
+    m_slot_positions[i] = ReverseBits((power - 1) >> 1, m_degree_bits);
+    m_slot_index[m_slot_positions[i]] = i;
+    power = (power * 5) & mask;
+  }
+}
+
 void FFTLike::ComputeForwardFFTLike(std::complex<double>* result,
                                     const std::complex<double>* operand,
-                                    const double* in_scale) {
+                                    const double* in_scale) const {
   HEXL_CHECK(result != nullptr, "result == nullptr");
   HEXL_CHECK(operand != nullptr, "operand == nullptr");
 
-  const double* out_scale = nullptr;
-  if (scalar != nullptr) {
-    out_scale = &inv_scale;
-  } else if (in_scale != nullptr) {
-    out_scale = in_scale;
-  }
-
 #ifdef HEXL_HAS_AVX512DQ
   HEXL_VLOG(3, "Calling 64-bit AVX512-DQ FwdFFTLike");
 
-  Forward_FFTLike_ToBitReverseAVX512(
+  const uint64_t num_threads =
+      m_degree >= kFFTLikeParallelDegree ? GetFFTLikeNumThreads() : 1;
+  Forward_FFTLike_ToBitReverseRadix4ParallelAVX512(
       &(reinterpret_cast<double(&)[2]>(result[0]))[0],
       &(reinterpret_cast<const double(&)[2]>(operand[0]))[0],
       &(reinterpret_cast<const double(&)[2]>(m_complex_roots_of_unity[0]))[0],
-      m_degree, out_scale);
+      m_degree, in_scale, num_threads);
   return;
 #else
   HEXL_VLOG(3, "Calling Native FwdFFTLike");
-  Forward_FFTLike_ToBitReverseRadix2(
-      result, operand, m_complex_roots_of_unity.data(), m_degree, out_scale);
+  Forward_FFTLike_ToBitReverseRadix4(
+      result, operand, m_complex_roots_of_unity.data(), m_degree, in_scale);
   return;
 #endif
 }
 
 void FFTLike::ComputeInverseFFTLike(std::complex<double>* result,
                                     const std::complex<double>* operand,
-                                    const double* in_scale) {
+                                    const double* in_scale) const {
   HEXL_CHECK(result != nullptr, "result==nullptr");
   HEXL_CHECK(operand != nullptr, "operand==nullptr");
 
-  const double* out_scale = nullptr;
-  if (scalar != nullptr) {
-    out_scale = &scale;
-  } else if (in_scale != nullptr) {
-    out_scale = in_scale;
-  }
-
 #ifdef HEXL_HAS_AVX512DQ
   HEXL_VLOG(3, "Calling 64-bit AVX512-DQ InvFFTLike");
 
-  Inverse_FFTLike_FromBitReverseAVX512(
+  const uint64_t num_threads =
+      m_degree >= kFFTLikeParallelDegree ? GetFFTLikeNumThreads() : 1;
+  Inverse_FFTLike_FromBitReverseRadix4ParallelAVX512(
       &(reinterpret_cast<double(&)[2]>(result[0]))[0],
       &(reinterpret_cast<const double(&)[2]>(operand[0]))[0],
       &(reinterpret_cast<const double(&)[2]>(
           m_inv_complex_roots_of_unity[0]))[0],
-      m_degree, out_scale);
+      m_degree, in_scale, num_threads);
 
   return;
 #else
   HEXL_VLOG(3, "Calling Native InvFFTLike");
-  Inverse_FFTLike_FromBitReverseRadix2(result, operand,
+  Inverse_FFTLike_FromBitReverseRadix4(result, operand,
                                        m_inv_complex_roots_of_unity.data(),
-                                       m_degree, out_scale);
+                                       m_degree, in_scale);
   return;
 #endif
 }
 
+void FFTLike::ComputeForwardFFTLikeToSlots(std::complex<double>* slots,
+                                           const std::complex<double>* operand,
+                                           const double* in_scale) const {
+  HEXL_CHECK(slots != nullptr, "slots == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+
+  AlignedVector64<std::complex<double>> buffer(m_degree / 2, m_aligned_alloc);
+#ifdef HEXL_HAS_AVX512DQ
+  if (m_degree >= 32) {
+    HEXL_VLOG(3, "Calling 64-bit AVX512-DQ FwdFFTLikeToSlots");
+    Forward_FFTLike_ToSlotsAVX512(
+        &(reinterpret_cast<double(&)[2]>(slots[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(operand[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(m_complex_roots_of_unity[0]))[0],
+        m_slot_positions.data(), m_degree, in_scale,
+        &(reinterpret_cast<double(&)[2]>(buffer[0]))[0]);
+    return;
+  }
+#endif
+  HEXL_VLOG(3, "Calling Native FwdFFTLikeToSlots");
+  Forward_FFTLike_ToSlots(slots, operand, m_complex_roots_of_unity.data(),
+                          m_slot_positions.data(), m_degree, in_scale,
+                          buffer.data());
+}
+
+void FFTLike::ComputeInverseFFTLikeFromSlots(
+    std::complex<double>* result, const std::complex<double>* slots,
+    const double* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(slots != nullptr, "slots == nullptr");
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (m_degree >= 32) {
+    HEXL_VLOG(3, "Calling 64-bit AVX512-DQ InvFFTLikeFromSlots");
+    Inverse_FFTLike_FromSlotsAVX512(
+        &(reinterpret_cast<double(&)[2]>(result[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(slots[0]))[0],
+        &(reinterpret_cast<const double(&)[2]>(
+            m_inv_complex_roots_of_unity[0]))[0],
+        m_slot_index.data(), m_degree, in_scale);
+    return;
+  }
+#endif
+  HEXL_VLOG(3, "Calling Native InvFFTLikeFromSlots");
+  Inverse_FFTLike_FromSlots(result, slots, m_inv_complex_roots_of_unity.data(),
+                            m_slot_index.data(), m_degree, in_scale);
+}
+
+void FFTLike::ComputeForwardFFTLikeBatch(std::complex<double>* result,
+                                         const std::complex<double>* operand,
+                                         uint64_t batch_size,
+                                         const double* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  const int num_threads = GetOmpNumThreads(GetFFTLikeNumThreads());
+
+#ifdef HEXL_HAS_AVX512DQ
+  HEXL_VLOG(3, "Calling 64-bit AVX512-DQ FwdFFTLikeBatch");
+  // Each thread transforms whole vectors serially; the roots of unity stay in
+  // its cache from one vector to the next
+  const double* roots =
+      &(reinterpret_cast<const double(&)[2]>(
+          m_complex_roots_of_unity[0]))[0];
+#pragma omp parallel for num_threads(num_threads) if (batch_size > 1)
+  for (int64_t b = 0; b < static_cast<int64_t>(batch_size); ++b) {
+    uint64_t offset = static_cast<uint64_t>(b) * m_degree;
+    Forward_FFTLike_ToBitReverseRadix4AVX512(
+        &(reinterpret_cast<double(&)[2]>(result[offset]))[0],
+        &(reinterpret_cast<const double(&)[2]>(operand[offset]))[0], roots,
+        m_degree, in_scale);
+  }
+#else
+  HEXL_VLOG(3, "Calling Native FwdFFTLikeBatch");
+  const uint64_t group_size =
+      std::max(uint64_t(1), kFFTLikeBatchGroupSize / m_degree);
+  const int64_t num_groups =
+      static_cast<int64_t>((batch_size + group_size - 1) / group_size);
+#pragma omp parallel for num_threads(num_threads) if (num_groups > 1)
+  for (int64_t g = 0; g < num_groups; ++g) {
+    uint64_t first = static_cast<uint64_t>(g) * group_size;
+    Forward_FFTLike_ToBitReverseRadix2Batch(
+        result + first * m_degree, operand + first * m_degree,
+        m_complex_roots_of_unity.data(), m_degree,
+        std::min(group_size, batch_size - first), in_scale);
+  }
+#endif
+}
+
+void FFTLike::ComputeInverseFFTLikeBatch(std::complex<double>* result,
+                                         const std::complex<double>* operand,
+                                         uint64_t batch_size,
+                                         const double* in_scale) const {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  const int num_threads = GetOmpNumThreads(GetFFTLikeNumThreads());
+
+#ifdef HEXL_HAS_AVX512DQ
+  HEXL_VLOG(3, "Calling 64-bit AVX512-DQ InvFFTLikeBatch");
+  // Each thread transforms whole vectors serially; the roots of unity stay in
+  // its cache from one vector to the next
+  const double* roots =
+      &(reinterpret_cast<const double(&)[2]>(
+          m_inv_complex_roots_of_unity[0]))[0];
+#pragma omp parallel for num_threads(num_threads) if (batch_size > 1)
+  for (int64_t b = 0; b < static_cast<int64_t>(batch_size); ++b) {
+    uint64_t offset = static_cast<uint64_t>(b) * m_degree;
+    Inverse_FFTLike_FromBitReverseRadix4AVX512(
+        &(reinterpret_cast<double(&)[2]>(result[offset]))[0],
+        &(reinterpret_cast<const double(&)[2]>(operand[offset]))[0], roots,
+        m_degree, in_scale);
+  }
+#else
+  HEXL_VLOG(3, "Calling Native InvFFTLikeBatch");
+  const uint64_t group_size =
+      std::max(uint64_t(1), kFFTLikeBatchGroupSize / m_degree);
+  const int64_t num_groups =
+      static_cast<int64_t>((batch_size + group_size - 1) / group_size);
+#pragma omp parallel for num_threads(num_threads) if (num_groups > 1)
+  for (int64_t g = 0; g < num_groups; ++g) {
+    uint64_t first = static_cast<uint64_t>(g) * group_size;
+    Inverse_FFTLike_FromBitReverseRadix2Batch(
+        result + first * m_degree, operand + first * m_degree,
+        m_inv_complex_roots_of_unity.data(), m_degree,
+        std::min(group_size, batch_size - first), in_scale);
+  }
+#endif
+}
+
 void FFTLike::BuildFloatingPoints(std::complex<double>* res,
                                   const uint64_t* plain,
                                   const uint64_t* threshold,
                                   const uint64_t* decryption_modulus,
                                   const double in_inv_scale, size_t mod_size,
-                                  size_t coeff_count) {
-  HEXL_UNUSED(res);
-  HEXL_UNUSED(plain);
-  HEXL_UNUSED(threshold);
-  HEXL_UNUSED(decryption_modulus);
-  HEXL_UNUSED(in_inv_scale);
-  HEXL_UNUSED(mod_size);
-  HEXL_UNUSED(coeff_count);
+                                  size_t coeff_count) const {
+  HEXL_CHECK(res != nullptr, "res == nullptr");
+  HEXL_CHECK(plain != nullptr, "plain == nullptr");
 
 #ifdef HEXL_HAS_AVX512DQ
-  HEXL_VLOG(3, "Calling 64-bit AVX512-DQ BuildFloatingPoints");
+  if (has_avx512dq && coeff_count % 8 == 0) {
+    HEXL_VLOG(3, "Calling 64-bit AVX512-DQ BuildFloatingPoints");
+    BuildFloatingPointsAVX512(&(reinterpret_cast<double(&)[2]>(res[0]))[0],
+                              plain, threshold, decryption_modulus,
+                              in_inv_scale, mod_size, coeff_count);
+    return;
+  }
+#endif
 
-  BuildFloatingPointsAVX512(&(reinterpret_cast<double(&)[2]>(res[0]))[0], plain,
-                            threshold, decryption_modulus, in_inv_scale,
-                            mod_size, coeff_count);
-  return;
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    HEXL_VLOG(3, "Calling 64-bit AVX2 BuildFloatingPoints");
+    BuildFloatingPointsAVX2(&(reinterpret_cast<double(&)[2]>(res[0]))[0],
+                            plain, threshold, decryption_modulus,
+                            in_inv_scale, mod_size, coeff_count);
+    return;
+  }
 #endif
+
+  HEXL_VLOG(3, "Calling Native BuildFloatingPoints");
+  BuildFloatingPointsNative(res, plain, threshold, decryption_modulus,
+                            in_inv_scale, mod_size, coeff_count);
 }
 
 }  // namespace hexl
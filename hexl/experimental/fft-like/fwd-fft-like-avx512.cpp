@@ -5,6 +5,7 @@
 
 #include "hexl/experimental/fft-like/fft-like-avx512-util.hpp"
 #include "hexl/logging/logging.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -243,6 +244,61 @@ void ComplexFwdT8(double* operand_8C_intrlvd, const double* W_1C_intrlvd,
   }
 }
 
+// First pass butterflies on the columns [begin, end) of one block; begin and
+// end are multiples of 16
+void ComplexStartFwdT8Span(double* result_8C_intrlvd,
+                           const double* operand_1C_intrlvd,
+                           const double* W_1C_intrlvd, uint64_t gap,
+                           uint64_t begin, uint64_t end) {
+  // Referencing operand
+  const double* X_op = operand_1C_intrlvd + begin;
+  const double* Y_op = X_op + gap;
+  const __m512d* v_X_op_pt = reinterpret_cast<const __m512d*>(X_op);
+  const __m512d* v_Y_op_pt = reinterpret_cast<const __m512d*>(Y_op);
+
+  // Referencing result
+  double* X_r_real = result_8C_intrlvd + begin;
+  double* X_r_imag = X_r_real + 8;
+  double* Y_r_real = X_r_real + gap;
+  double* Y_r_imag = X_r_imag + gap;
+  __m512d* v_X_r_pt_real = reinterpret_cast<__m512d*>(X_r_real);
+  __m512d* v_X_r_pt_imag = reinterpret_cast<__m512d*>(X_r_imag);
+  __m512d* v_Y_r_pt_real = reinterpret_cast<__m512d*>(Y_r_real);
+  __m512d* v_Y_r_pt_imag = reinterpret_cast<__m512d*>(Y_r_imag);
+
+  // Weights
+  __m512d v_W_real = _mm512_set1_pd(W_1C_intrlvd[0]);
+  __m512d v_W_imag = _mm512_set1_pd(W_1C_intrlvd[1]);
+
+  // assume 8 | t
+  for (size_t j = begin; j < end; j += 16) {
+    __m512d v_X_real;
+    __m512d v_X_imag;
+    __m512d v_Y_real;
+    __m512d v_Y_imag;
+
+    ComplexLoadFwdInterleavedT8(v_X_op_pt, v_Y_op_pt, &v_X_real, &v_X_imag,
+                                &v_Y_real, &v_Y_imag);
+
+    ComplexFwdButterfly(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag, v_W_real,
+                        v_W_imag);
+
+    _mm512_storeu_pd(v_X_r_pt_real, v_X_real);
+    _mm512_storeu_pd(v_X_r_pt_imag, v_X_imag);
+
+    _mm512_storeu_pd(v_Y_r_pt_real, v_Y_real);
+    _mm512_storeu_pd(v_Y_r_pt_imag, v_Y_imag);
+
+    // Increase operand & result pointers
+    v_X_op_pt += 2;
+    v_Y_op_pt += 2;
+    v_X_r_pt_real += 2;
+    v_X_r_pt_imag += 2;
+    v_Y_r_pt_real += 2;
+    v_Y_r_pt_imag += 2;
+  }
+}
+
 void ComplexStartFwdT8(double* result_8C_intrlvd,
                        const double* operand_1C_intrlvd,
                        const double* W_1C_intrlvd, uint64_t gap, uint64_t m) {
@@ -250,53 +306,88 @@ void ComplexStartFwdT8(double* result_8C_intrlvd,
 
   HEXL_LOOP_UNROLL_4
   for (size_t i = 0; i < (m >> 1); i++) {
-    // Referencing operand
-    const double* X_op = operand_1C_intrlvd + offset;
-    const double* Y_op = X_op + gap;
-    const __m512d* v_X_op_pt = reinterpret_cast<const __m512d*>(X_op);
-    const __m512d* v_Y_op_pt = reinterpret_cast<const __m512d*>(Y_op);
-
-    // Referencing result
-    double* X_r_real = result_8C_intrlvd + offset;
-    double* X_r_imag = X_r_real + 8;
-    double* Y_r_real = X_r_real + gap;
-    double* Y_r_imag = X_r_imag + gap;
-    __m512d* v_X_r_pt_real = reinterpret_cast<__m512d*>(X_r_real);
-    __m512d* v_X_r_pt_imag = reinterpret_cast<__m512d*>(X_r_imag);
-    __m512d* v_Y_r_pt_real = reinterpret_cast<__m512d*>(Y_r_real);
-    __m512d* v_Y_r_pt_imag = reinterpret_cast<__m512d*>(Y_r_imag);
-
-    // Weights
-    __m512d v_W_real = _mm512_set1_pd(*W_1C_intrlvd++);
-    __m512d v_W_imag = _mm512_set1_pd(*W_1C_intrlvd++);
-
-    // assume 8 | t
-    for (size_t j = 0; j < gap; j += 16) {
-      __m512d v_X_real;
-      __m512d v_X_imag;
-      __m512d v_Y_real;
-      __m512d v_Y_imag;
-
-      ComplexLoadFwdInterleavedT8(v_X_op_pt, v_Y_op_pt, &v_X_real, &v_X_imag,
-                                  &v_Y_real, &v_Y_imag);
-
-      ComplexFwdButterfly(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag, v_W_real,
-                          v_W_imag);
+    ComplexStartFwdT8Span(result_8C_intrlvd + offset,
+                          operand_1C_intrlvd + offset, W_1C_intrlvd + 2 * i,
+                          gap, 0, gap);
+    offset += (gap << 1);
+  }
+}
 
-      _mm512_storeu_pd(v_X_r_pt_real, v_X_real);
-      _mm512_storeu_pd(v_X_r_pt_imag, v_X_imag);
+// Radix-4 pass butterflies on the columns [begin, end) of one block, with
+// roots W1_1C_intrlvd[0..1] and W2_1C_intrlvd[0..1]; begin and end are
+// multiples of 16 in [0, gap / 2]
+void ComplexFwdRadix4T8Span(double* operand_8C_intrlvd,
+                            const double* W1_1C_intrlvd,
+                            const double* W2_1C_intrlvd, uint64_t gap,
+                            uint64_t begin, uint64_t end) {
+  const size_t quarter = gap >> 1;
+  double* A_real = operand_8C_intrlvd;
+  double* B_real = A_real + quarter;
+  double* C_real = B_real + quarter;
+  double* D_real = C_real + quarter;
+
+  // Weights
+  const double W1_real = W1_1C_intrlvd[0];
+  const double W1_imag = W1_1C_intrlvd[1];
+  const double W2_real = W2_1C_intrlvd[0];
+  const double W2_imag = W2_1C_intrlvd[1];
+  __m512d v_W1_real = _mm512_set1_pd(W1_real);
+  __m512d v_W1_imag = _mm512_set1_pd(W1_imag);
+  __m512d v_W2_real = _mm512_set1_pd(W2_real);
+  __m512d v_W2_imag = _mm512_set1_pd(W2_imag);
+  __m512d v_W3_real = _mm512_set1_pd(W1_real * W2_real - W1_imag * W2_imag);
+  __m512d v_W3_imag = _mm512_set1_pd(W1_real * W2_imag + W1_imag * W2_real);
+
+  // assume 16 | quarter
+  for (size_t j = begin; j < end; j += 16) {
+    __m512d v_A_real = _mm512_loadu_pd(A_real + j);
+    __m512d v_A_imag = _mm512_loadu_pd(A_real + j + 8);
+    __m512d v_B_real = _mm512_loadu_pd(B_real + j);
+    __m512d v_B_imag = _mm512_loadu_pd(B_real + j + 8);
+    __m512d v_C_real = _mm512_loadu_pd(C_real + j);
+    __m512d v_C_imag = _mm512_loadu_pd(C_real + j + 8);
+    __m512d v_D_real = _mm512_loadu_pd(D_real + j);
+    __m512d v_D_imag = _mm512_loadu_pd(D_real + j + 8);
+
+    ComplexMultiply(&v_B_real, &v_B_imag, v_W2_real, v_W2_imag);
+    ComplexMultiply(&v_C_real, &v_C_imag, v_W1_real, v_W1_imag);
+    ComplexMultiply(&v_D_real, &v_D_imag, v_W3_real, v_W3_imag);
+
+    // T0 = A + C, T1 = A - C, T2 = B + D, T3 = i(B - D)
+    __m512d v_T0_real = _mm512_add_pd(v_A_real, v_C_real);
+    __m512d v_T0_imag = _mm512_add_pd(v_A_imag, v_C_imag);
+    __m512d v_T1_real = _mm512_sub_pd(v_A_real, v_C_real);
+    __m512d v_T1_imag = _mm512_sub_pd(v_A_imag, v_C_imag);
+    __m512d v_T2_real = _mm512_add_pd(v_B_real, v_D_real);
+    __m512d v_T2_imag = _mm512_add_pd(v_B_imag, v_D_imag);
+    __m512d v_T3_real = _mm512_sub_pd(v_D_imag, v_B_imag);
+    __m512d v_T3_imag = _mm512_sub_pd(v_B_real, v_D_real);
+
+    _mm512_storeu_pd(A_real + j, _mm512_add_pd(v_T0_real, v_T2_real));
+    _mm512_storeu_pd(A_real + j + 8, _mm512_add_pd(v_T0_imag, v_T2_imag));
+    _mm512_storeu_pd(B_real + j, _mm512_sub_pd(v_T0_real, v_T2_real));
+    _mm512_storeu_pd(B_real + j + 8, _mm512_sub_pd(v_T0_imag, v_T2_imag));
+    _mm512_storeu_pd(C_real + j, _mm512_add_pd(v_T1_real, v_T3_real));
+    _mm512_storeu_pd(C_real + j + 8, _mm512_add_pd(v_T1_imag, v_T3_imag));
+    _mm512_storeu_pd(D_real + j, _mm512_sub_pd(v_T1_real, v_T3_real));
+    _mm512_storeu_pd(D_real + j + 8, _mm512_sub_pd(v_T1_imag, v_T3_imag));
+  }
+}
 
-      _mm512_storeu_pd(v_Y_r_pt_real, v_Y_real);
-      _mm512_storeu_pd(v_Y_r_pt_imag, v_Y_imag);
+// Radix-2 stages (gap, m) and (gap / 2, 2 * m) in a single pass; requires
+// gap >= 32. W1_1C_intrlvd holds the roots of the first stage and
+// W2_1C_intrlvd those of the second. The root of the second stage on an odd
+// block is i times the root on the even block before it, so each group of four
+// values takes three complex multiplications.
+void ComplexFwdRadix4T8(double* operand_8C_intrlvd,
+                        const double* W1_1C_intrlvd,
+                        const double* W2_1C_intrlvd, uint64_t gap,
+                        uint64_t m) {
+  size_t offset = 0;
 
-      // Increase operand & result pointers
-      v_X_op_pt += 2;
-      v_Y_op_pt += 2;
-      v_X_r_pt_real += 2;
-      v_X_r_pt_imag += 2;
-      v_Y_r_pt_real += 2;
-      v_Y_r_pt_imag += 2;
-    }
+  for (size_t i = 0; i < (m >> 1); i++) {
+    ComplexFwdRadix4T8Span(operand_8C_intrlvd + offset, W1_1C_intrlvd + 2 * i,
+                           W2_1C_intrlvd + 4 * i, gap, 0, gap >> 1);
     offset += (gap << 1);
   }
 }
@@ -392,6 +483,222 @@ void Forward_FFTLike_ToBitReverseAVX512(
   }
 }
 
+void Forward_FFTLike_ToBitReverseRadix4AVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* root_of_unity_powers_cmplx_intrlvd, const uint64_t n,
+    const double* scale, uint64_t recursion_depth, uint64_t recursion_half) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16,
+             "Don't support small transforms. Need n >= 16, got n = " << n);
+
+  static const size_t base_fft_like_size = 1024;
+
+  if (n <= base_fft_like_size) {  // Perform breadth-first FFT like
+    size_t gap = n;
+    size_t m = 2;
+    size_t W_idx = (m << recursion_depth) + (recursion_half * m);
+
+    // First pass in case of out of place
+    if (recursion_depth == 0) {
+      const double* W_cmplx_intrlvd =
+          &root_of_unity_powers_cmplx_intrlvd[W_idx];
+      ComplexStartFwdT8(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                        W_cmplx_intrlvd, gap, m);
+      m <<= 1;
+      W_idx <<= 1;
+      gap >>= 1;
+    }
+
+    for (; gap >= 32; gap >>= 2) {
+      ComplexFwdRadix4T8(result_cmplx_intrlvd,
+                         &root_of_unity_powers_cmplx_intrlvd[W_idx],
+                         &root_of_unity_powers_cmplx_intrlvd[W_idx << 1], gap,
+                         m);
+      m <<= 2;
+      W_idx <<= 2;
+    }
+
+    if (gap == 16) {
+      const double* W_cmplx_intrlvd =
+          &root_of_unity_powers_cmplx_intrlvd[W_idx];
+      ComplexFwdT8(result_cmplx_intrlvd, W_cmplx_intrlvd, gap, m);
+      m <<= 1;
+      W_idx <<= 1;
+    }
+
+    {
+      // T4
+      const double* W_cmplx_intrlvd =
+          &root_of_unity_powers_cmplx_intrlvd[W_idx];
+      ComplexFwdT4(result_cmplx_intrlvd, W_cmplx_intrlvd, m);
+      m <<= 1;
+      W_idx <<= 1;
+
+      // T2
+      W_cmplx_intrlvd = &root_of_unity_powers_cmplx_intrlvd[W_idx];
+      ComplexFwdT2(result_cmplx_intrlvd, W_cmplx_intrlvd, m);
+      m <<= 1;
+      W_idx <<= 1;
+
+      // T1
+      W_cmplx_intrlvd = &root_of_unity_powers_cmplx_intrlvd[W_idx];
+      ComplexFwdT1(result_cmplx_intrlvd, W_cmplx_intrlvd, m, scale);
+    }
+  } else if (recursion_depth == 0) {
+    // The first pass converts to the 8 complex interleaved layout, so it
+    // stays radix-2
+    size_t gap = n;
+    const double* W_cmplx_intrlvd = &root_of_unity_powers_cmplx_intrlvd[2];
+    ComplexStartFwdT8(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                      W_cmplx_intrlvd, gap, 2);
+
+    Forward_FFTLike_ToBitReverseRadix4AVX512(
+        result_cmplx_intrlvd, result_cmplx_intrlvd,
+        root_of_unity_powers_cmplx_intrlvd, n / 2, scale, 1, 0);
+    Forward_FFTLike_ToBitReverseRadix4AVX512(
+        &result_cmplx_intrlvd[n], &result_cmplx_intrlvd[n],
+        root_of_unity_powers_cmplx_intrlvd, n / 2, scale, 1, 1);
+  } else {
+    // Perform depth-first FFT like via recursive call on the four quarters
+    size_t gap = n;
+    size_t W_idx = (2ULL << recursion_depth) + (recursion_half << 1);
+    ComplexFwdRadix4T8(result_cmplx_intrlvd,
+                       &root_of_unity_powers_cmplx_intrlvd[W_idx],
+                       &root_of_unity_powers_cmplx_intrlvd[W_idx << 1], gap,
+                       2);
+
+    for (uint64_t k = 0; k < 4; k++) {
+      Forward_FFTLike_ToBitReverseRadix4AVX512(
+          &result_cmplx_intrlvd[k * (n / 2)],
+          &result_cmplx_intrlvd[k * (n / 2)],
+          root_of_unity_powers_cmplx_intrlvd, n / 4, scale,
+          recursion_depth + 2, recursion_half * 4 + k);
+    }
+  }
+}
+
+void Forward_FFTLike_ToBitReverseRadix4ParallelAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* root_of_unity_powers_cmplx_intrlvd, const uint64_t n,
+    const double* scale, uint64_t num_threads) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16,
+             "Don't support small transforms. Need n >= 16, got n = " << n);
+
+  static const size_t base_fft_like_size = 1024;
+
+  const int threads = GetOmpNumThreads(num_threads);
+  if (threads <= 1 || n <= base_fft_like_size) {
+    Forward_FFTLike_ToBitReverseRadix4AVX512(
+        result_cmplx_intrlvd, operand_cmplx_intrlvd,
+        root_of_unity_powers_cmplx_intrlvd, n, scale);
+    return;
+  }
+
+  // The recursion of Forward_FFTLike_ToBitReverseRadix4AVX512 has 2
+  // sub-transforms of n / 2 values at depth 1, each of which splits into 4 at
+  // the next radix-4 pass. Pick the first depth with a sub-transform per
+  // thread, or with base case sub-transforms.
+  uint64_t leaf_depth = 1;
+  uint64_t leaf_size = n / 2;
+  while (leaf_size > base_fft_like_size &&
+         (1ULL << leaf_depth) < static_cast<uint64_t>(threads)) {
+    leaf_depth += 2;
+    leaf_size >>= 2;
+  }
+  const int64_t num_leaves = 1LL << leaf_depth;
+
+  // The passes above the leaves are split into column spans, so each
+  // butterfly is computed as in the serial transform
+#pragma omp parallel num_threads(threads)
+  {
+#pragma omp for
+    for (int64_t s = 0; s < threads; ++s) {
+      uint64_t begin;
+      uint64_t end;
+      GetColumnSpan(n, threads, s, &begin, &end);
+      ComplexStartFwdT8Span(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                            &root_of_unity_powers_cmplx_intrlvd[2], n, begin,
+                            end);
+    }
+
+    uint64_t size = n / 2;
+    for (uint64_t depth = 1; depth < leaf_depth; depth += 2, size >>= 2) {
+      const int64_t num_halves = 1LL << depth;
+      const int64_t spans_per_half = (threads + num_halves - 1) / num_halves;
+#pragma omp for
+      for (int64_t t = 0; t < num_halves * spans_per_half; ++t) {
+        const uint64_t half = static_cast<uint64_t>(t / spans_per_half);
+        const size_t W_idx = (2ULL << depth) + (half << 1);
+        uint64_t begin;
+        uint64_t end;
+        GetColumnSpan(size / 2, spans_per_half, t % spans_per_half, &begin,
+                      &end);
+        ComplexFwdRadix4T8Span(&result_cmplx_intrlvd[half * 2 * size],
+                               &root_of_unity_powers_cmplx_intrlvd[W_idx],
+                               &root_of_unity_powers_cmplx_intrlvd[W_idx << 1],
+                               size, begin, end);
+      }
+    }
+
+#pragma omp for
+    for (int64_t half = 0; half < num_leaves; ++half) {
+      double* leaf = &result_cmplx_intrlvd[half * 2 * leaf_size];
+      Forward_FFTLike_ToBitReverseRadix4AVX512(
+          leaf, leaf, root_of_unity_powers_cmplx_intrlvd, leaf_size, scale,
+          leaf_depth, static_cast<uint64_t>(half));
+    }
+  }
+}
+
+void Forward_FFTLike_ToSlotsAVX512(double* slots_cmplx_intrlvd,
+                                   const double* operand_cmplx_intrlvd,
+                                   const double* roots_of_unity_cmplx_intrlvd,
+                                   const uint64_t* slot_positions,
+                                   const uint64_t n, const double* scale,
+                                   double* buffer_cmplx_intrlvd) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "Need n >= 32, got n = " << n);
+  const uint64_t half_n = n / 2;
+
+  // First stage, keeping only the outputs X + Y * W in the first half
+  const __m512d* v_X_op_pt =
+      reinterpret_cast<const __m512d*>(operand_cmplx_intrlvd);
+  const __m512d* v_Y_op_pt =
+      reinterpret_cast<const __m512d*>(operand_cmplx_intrlvd + n);
+  __m512d* v_X_r_pt = reinterpret_cast<__m512d*>(buffer_cmplx_intrlvd);
+  const __m512d v_W_real = _mm512_set1_pd(roots_of_unity_cmplx_intrlvd[2]);
+  const __m512d v_W_imag = _mm512_set1_pd(roots_of_unity_cmplx_intrlvd[3]);
+  for (uint64_t j = 0; j < half_n; j += 8) {
+    __m512d v_X_real;
+    __m512d v_X_imag;
+    __m512d v_Y_real;
+    __m512d v_Y_imag;
+    ComplexLoadFwdInterleavedT8(v_X_op_pt, v_Y_op_pt, &v_X_real, &v_X_imag,
+                                &v_Y_real, &v_Y_imag);
+
+    __m512d v_V_real = _mm512_sub_pd(_mm512_mul_pd(v_Y_real, v_W_real),
+                                     _mm512_mul_pd(v_Y_imag, v_W_imag));
+    __m512d v_V_imag = _mm512_add_pd(_mm512_mul_pd(v_Y_real, v_W_imag),
+                                     _mm512_mul_pd(v_Y_imag, v_W_real));
+    _mm512_storeu_pd(v_X_r_pt++, _mm512_add_pd(v_X_real, v_V_real));
+    _mm512_storeu_pd(v_X_r_pt++, _mm512_add_pd(v_X_imag, v_V_imag));
+
+    v_X_op_pt += 2;
+    v_Y_op_pt += 2;
+  }
+
+  Forward_FFTLike_ToBitReverseRadix4AVX512(
+      buffer_cmplx_intrlvd, buffer_cmplx_intrlvd, roots_of_unity_cmplx_intrlvd,
+      half_n, scale, 1, 0);
+
+  for (uint64_t i = 0; i < half_n; ++i) {
+    const double* value = buffer_cmplx_intrlvd + 2 * slot_positions[i];
+    slots_cmplx_intrlvd[2 * i] = value[0];
+    slots_cmplx_intrlvd[2 * i + 1] = value[1];
+  }
+}
+
 void BuildFloatingPointsAVX512(double* res_cmplx_intrlvd, const uint64_t* plain,
                                const uint64_t* threshold,
                                const uint64_t* decryption_modulus,
@@ -4,6 +4,7 @@
 
 #include "hexl/experimental/fft-like/fft-like-avx512-util.hpp"
 #include "hexl/logging/logging.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -244,63 +245,156 @@ void ComplexInvT8(double* operand_8C_intrlvd, const double* W_1C_intrlvd,
   }
 }
 
-// Takes operand as 8 complex interleaved: This is 8 real parts followed by
-// its 8 imaginary parts.
-// Returns operand as 1 complex interleaved: One real part followed by its
-// imaginary part.
-void ComplexFinalInvT8(double* operand_8C_intrlvd, const double* W_1C_intrlvd,
-                       uint64_t gap, uint64_t m,
-                       const double* scalar = nullptr) {
+// Radix-4 pass butterflies on the columns [begin, end) of one group, with
+// roots W1_1C_intrlvd[0..1] and W2_1C_intrlvd[0..1]; begin and end are
+// multiples of 16 in [0, gap]
+void ComplexInvRadix4T8Span(double* operand_8C_intrlvd,
+                            const double* W1_1C_intrlvd,
+                            const double* W2_1C_intrlvd, uint64_t gap,
+                            uint64_t begin, uint64_t end) {
+  double* A_real = operand_8C_intrlvd;
+  double* B_real = A_real + gap;
+  double* C_real = B_real + gap;
+  double* D_real = C_real + gap;
+
+  // Weights
+  const double W1_real = W1_1C_intrlvd[0];
+  const double W1_imag = W1_1C_intrlvd[1];
+  const double W2_real = W2_1C_intrlvd[0];
+  const double W2_imag = W2_1C_intrlvd[1];
+  __m512d v_W1_real = _mm512_set1_pd(W1_real);
+  __m512d v_W1_imag = _mm512_set1_pd(W1_imag);
+  __m512d v_W2_real = _mm512_set1_pd(W2_real);
+  __m512d v_W2_imag = _mm512_set1_pd(W2_imag);
+  __m512d v_W3_real = _mm512_set1_pd(W1_real * W2_real - W1_imag * W2_imag);
+  __m512d v_W3_imag = _mm512_set1_pd(W1_real * W2_imag + W1_imag * W2_real);
+
+  // assume 16 | gap
+  for (size_t j = begin; j < end; j += 16) {
+    __m512d v_A_real = _mm512_loadu_pd(A_real + j);
+    __m512d v_A_imag = _mm512_loadu_pd(A_real + j + 8);
+    __m512d v_B_real = _mm512_loadu_pd(B_real + j);
+    __m512d v_B_imag = _mm512_loadu_pd(B_real + j + 8);
+    __m512d v_C_real = _mm512_loadu_pd(C_real + j);
+    __m512d v_C_imag = _mm512_loadu_pd(C_real + j + 8);
+    __m512d v_D_real = _mm512_loadu_pd(D_real + j);
+    __m512d v_D_imag = _mm512_loadu_pd(D_real + j + 8);
+
+    // T0 = A + B, T1 = A - B, T2 = C + D, T3 = i(C - D)
+    __m512d v_T0_real = _mm512_add_pd(v_A_real, v_B_real);
+    __m512d v_T0_imag = _mm512_add_pd(v_A_imag, v_B_imag);
+    __m512d v_T1_real = _mm512_sub_pd(v_A_real, v_B_real);
+    __m512d v_T1_imag = _mm512_sub_pd(v_A_imag, v_B_imag);
+    __m512d v_T2_real = _mm512_add_pd(v_C_real, v_D_real);
+    __m512d v_T2_imag = _mm512_add_pd(v_C_imag, v_D_imag);
+    __m512d v_T3_real = _mm512_sub_pd(v_D_imag, v_C_imag);
+    __m512d v_T3_imag = _mm512_sub_pd(v_C_real, v_D_real);
+
+    v_A_real = _mm512_add_pd(v_T0_real, v_T2_real);
+    v_A_imag = _mm512_add_pd(v_T0_imag, v_T2_imag);
+    v_B_real = _mm512_sub_pd(v_T1_real, v_T3_real);
+    v_B_imag = _mm512_sub_pd(v_T1_imag, v_T3_imag);
+    v_C_real = _mm512_sub_pd(v_T0_real, v_T2_real);
+    v_C_imag = _mm512_sub_pd(v_T0_imag, v_T2_imag);
+    v_D_real = _mm512_add_pd(v_T1_real, v_T3_real);
+    v_D_imag = _mm512_add_pd(v_T1_imag, v_T3_imag);
+
+    ComplexMultiply(&v_B_real, &v_B_imag, v_W1_real, v_W1_imag);
+    ComplexMultiply(&v_C_real, &v_C_imag, v_W2_real, v_W2_imag);
+    ComplexMultiply(&v_D_real, &v_D_imag, v_W3_real, v_W3_imag);
+
+    _mm512_storeu_pd(A_real + j, v_A_real);
+    _mm512_storeu_pd(A_real + j + 8, v_A_imag);
+    _mm512_storeu_pd(B_real + j, v_B_real);
+    _mm512_storeu_pd(B_real + j + 8, v_B_imag);
+    _mm512_storeu_pd(C_real + j, v_C_real);
+    _mm512_storeu_pd(C_real + j + 8, v_C_imag);
+    _mm512_storeu_pd(D_real + j, v_D_real);
+    _mm512_storeu_pd(D_real + j + 8, v_D_imag);
+  }
+}
+
+// Radix-2 stages (gap, m) and (2 * gap, m / 2) in a single pass; requires
+// gap >= 16 and 4 | m. W1_1C_intrlvd holds the roots of the first stage and
+// W2_1C_intrlvd those of the second. The root of the first stage on an odd
+// block is -i times the root on the even block before it, so each group of
+// four values takes three complex multiplications.
+void ComplexInvRadix4T8(double* operand_8C_intrlvd,
+                        const double* W1_1C_intrlvd,
+                        const double* W2_1C_intrlvd, uint64_t gap,
+                        uint64_t m) {
   size_t offset = 0;
 
-  __m512d v_scalar;
-  if (scalar != nullptr) {
-    v_scalar = _mm512_set1_pd(*scalar);
+  for (size_t i = 0; i < (m >> 2); i++) {
+    ComplexInvRadix4T8Span(operand_8C_intrlvd + offset, W1_1C_intrlvd + 4 * i,
+                           W2_1C_intrlvd + 2 * i, gap, 0, gap);
+    offset += (gap << 2);
   }
+}
 
-  HEXL_LOOP_UNROLL_4
-  for (size_t i = 0; i < (m >> 1); i++, offset += (gap << 1)) {
-    // Referencing operand
-    double* X_real = operand_8C_intrlvd + offset;
-    double* X_imag = X_real + 8;
+// Last pass on the columns [begin, end) of one block; begin and end are
+// multiples of 16
+void ComplexFinalInvT8Span(double* operand_8C_intrlvd,
+                           const double* W_1C_intrlvd, uint64_t gap,
+                           uint64_t begin, uint64_t end,
+                           const double* scalar = nullptr) {
+  // Referencing operand
+  double* X_real = operand_8C_intrlvd + begin;
+  double* X_imag = X_real + 8;
 
-    double* Y_real = X_real + gap;
-    double* Y_imag = X_imag + gap;
+  double* Y_real = X_real + gap;
+  double* Y_imag = X_imag + gap;
 
-    __m512d* v_X_pt_real = reinterpret_cast<__m512d*>(X_real);
-    __m512d* v_X_pt_imag = reinterpret_cast<__m512d*>(X_imag);
+  __m512d* v_X_pt_real = reinterpret_cast<__m512d*>(X_real);
+  __m512d* v_X_pt_imag = reinterpret_cast<__m512d*>(X_imag);
 
-    __m512d* v_Y_pt_real = reinterpret_cast<__m512d*>(Y_real);
-    __m512d* v_Y_pt_imag = reinterpret_cast<__m512d*>(Y_imag);
+  __m512d* v_Y_pt_real = reinterpret_cast<__m512d*>(Y_real);
+  __m512d* v_Y_pt_imag = reinterpret_cast<__m512d*>(Y_imag);
 
-    // Weights
-    __m512d v_W_real = _mm512_set1_pd(*W_1C_intrlvd++);
-    __m512d v_W_imag = _mm512_set1_pd(*W_1C_intrlvd++);
+  // Weights
+  __m512d v_W_real = _mm512_set1_pd(W_1C_intrlvd[0]);
+  __m512d v_W_imag = _mm512_set1_pd(W_1C_intrlvd[1]);
 
-    if (scalar != nullptr) {
-      v_W_real = _mm512_mul_pd(v_W_real, v_scalar);
-      v_W_imag = _mm512_mul_pd(v_W_imag, v_scalar);
-    }
+  if (scalar != nullptr) {
+    __m512d v_scalar = _mm512_set1_pd(*scalar);
+    v_W_real = _mm512_mul_pd(v_W_real, v_scalar);
+    v_W_imag = _mm512_mul_pd(v_W_imag, v_scalar);
+  }
 
-    // assume 8 | t
-    for (size_t j = 0; j < gap; j += 16) {
-      __m512d v_X_real = _mm512_loadu_pd(v_X_pt_real);
-      __m512d v_X_imag = _mm512_loadu_pd(v_X_pt_imag);
-      __m512d v_Y_real = _mm512_loadu_pd(v_Y_pt_real);
-      __m512d v_Y_imag = _mm512_loadu_pd(v_Y_pt_imag);
+  // assume 8 | t
+  for (size_t j = begin; j < end; j += 16) {
+    __m512d v_X_real = _mm512_loadu_pd(v_X_pt_real);
+    __m512d v_X_imag = _mm512_loadu_pd(v_X_pt_imag);
+    __m512d v_Y_real = _mm512_loadu_pd(v_Y_pt_real);
+    __m512d v_Y_imag = _mm512_loadu_pd(v_Y_pt_imag);
 
-      ComplexInvButterfly(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag, v_W_real,
-                          v_W_imag, scalar);
+    ComplexInvButterfly(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag, v_W_real,
+                        v_W_imag, scalar);
 
-      ComplexWriteInvInterleavedT8(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag,
-                                   v_X_pt_real, v_Y_pt_real);
+    ComplexWriteInvInterleavedT8(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag,
+                                 v_X_pt_real, v_Y_pt_real);
 
-      // Increase operand & result pointers
-      v_X_pt_real += 2;
-      v_X_pt_imag += 2;
-      v_Y_pt_real += 2;
-      v_Y_pt_imag += 2;
-    }
+    // Increase operand & result pointers
+    v_X_pt_real += 2;
+    v_X_pt_imag += 2;
+    v_Y_pt_real += 2;
+    v_Y_pt_imag += 2;
+  }
+}
+
+// Takes operand as 8 complex interleaved: This is 8 real parts followed by
+// its 8 imaginary parts.
+// Returns operand as 1 complex interleaved: One real part followed by its
+// imaginary part.
+void ComplexFinalInvT8(double* operand_8C_intrlvd, const double* W_1C_intrlvd,
+                       uint64_t gap, uint64_t m,
+                       const double* scalar = nullptr) {
+  size_t offset = 0;
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < (m >> 1); i++, offset += (gap << 1)) {
+    ComplexFinalInvT8Span(operand_8C_intrlvd + offset, W_1C_intrlvd + 2 * i,
+                          gap, 0, gap, scalar);
   }
 }
 
@@ -405,6 +499,220 @@ void Inverse_FFTLike_FromBitReverseAVX512(
   }
 }
 
+// Index in the 1 complex interleaved inverse roots of the root used by the
+// last stage of the sub-transform at recursion_depth, recursion_half
+inline size_t InvLastStageWIdx(uint64_t degree, uint64_t recursion_depth,
+                               uint64_t recursion_half) {
+  return 2 * (degree - (2ULL << recursion_depth) + 1 + recursion_half);
+}
+
+void Inverse_FFTLike_FromBitReverseRadix4AVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplx_intrlvd, const uint64_t n,
+    const double* scale, uint64_t recursion_depth, uint64_t recursion_half) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16,
+             "Don't support small transforms. Need n >= 16, got n = " << n);
+
+  const uint64_t degree = n << recursion_depth;
+
+  static const size_t base_fft_like_size = 1024;
+
+  if (n <= base_fft_like_size) {  // Perform breadth-first InvFFT like
+    size_t gap = 2;
+    size_t m = n;
+    size_t W_idx = 2 + m * recursion_half;
+    const uint64_t W_idx_factor =
+        (1ULL << (recursion_depth + 1)) - recursion_half;
+
+    // T1
+    ComplexInvT1(result_cmplx_intrlvd, operand_cmplx_intrlvd,
+                 &inv_root_of_unity_cmplx_intrlvd[W_idx], m);
+    gap <<= 1;
+    m >>= 1;
+    W_idx += m * W_idx_factor;
+
+    // T2
+    ComplexInvT2(result_cmplx_intrlvd, &inv_root_of_unity_cmplx_intrlvd[W_idx],
+                 m);
+    gap <<= 1;
+    m >>= 1;
+    W_idx += m * W_idx_factor;
+
+    // T4
+    ComplexInvT4(result_cmplx_intrlvd, &inv_root_of_unity_cmplx_intrlvd[W_idx],
+                 m);
+    gap <<= 1;
+    m >>= 1;
+    W_idx += m * W_idx_factor;
+
+    for (; m > 4; m >>= 2, gap <<= 2) {
+      const size_t W2_idx = W_idx + (m >> 1) * W_idx_factor;
+      ComplexInvRadix4T8(result_cmplx_intrlvd,
+                         &inv_root_of_unity_cmplx_intrlvd[W_idx],
+                         &inv_root_of_unity_cmplx_intrlvd[W2_idx], gap, m);
+      W_idx = W2_idx + (m >> 2) * W_idx_factor;
+    }
+
+    if (m > 2) {
+      ComplexInvT8(result_cmplx_intrlvd,
+                   &inv_root_of_unity_cmplx_intrlvd[W_idx], gap, m);
+      gap <<= 1;
+      m >>= 1;
+      W_idx += m * W_idx_factor;
+    }
+
+    const double* W_cmplx_intrlvd = &inv_root_of_unity_cmplx_intrlvd[W_idx];
+    if (recursion_depth == 0) {
+      ComplexFinalInvT8(result_cmplx_intrlvd, W_cmplx_intrlvd, gap, m, scale);
+    } else {
+      ComplexInvT8(result_cmplx_intrlvd, W_cmplx_intrlvd, gap, m);
+    }
+  } else if (recursion_depth == 0) {
+    // The last pass converts back to the 1 complex interleaved layout, so it
+    // stays radix-2
+    Inverse_FFTLike_FromBitReverseRadix4AVX512(
+        result_cmplx_intrlvd, operand_cmplx_intrlvd,
+        inv_root_of_unity_cmplx_intrlvd, n / 2, scale, 1, 0);
+    Inverse_FFTLike_FromBitReverseRadix4AVX512(
+        &result_cmplx_intrlvd[n], &operand_cmplx_intrlvd[n],
+        inv_root_of_unity_cmplx_intrlvd, n / 2, scale, 1, 1);
+    const double* W_cmplx_intrlvd =
+        &inv_root_of_unity_cmplx_intrlvd[InvLastStageWIdx(degree, 0, 0)];
+    ComplexFinalInvT8(result_cmplx_intrlvd, W_cmplx_intrlvd, n, 2, scale);
+  } else {
+    // Perform depth-first InvFFT like via recursive call on the four quarters
+    for (uint64_t k = 0; k < 4; k++) {
+      Inverse_FFTLike_FromBitReverseRadix4AVX512(
+          &result_cmplx_intrlvd[k * (n / 2)],
+          &operand_cmplx_intrlvd[k * (n / 2)], inv_root_of_unity_cmplx_intrlvd,
+          n / 4, scale, recursion_depth + 2, recursion_half * 4 + k);
+    }
+    // Last stages of the two halves, then of this sub-transform
+    const size_t W1_idx =
+        InvLastStageWIdx(degree, recursion_depth + 1, recursion_half * 2);
+    const size_t W2_idx =
+        InvLastStageWIdx(degree, recursion_depth, recursion_half);
+    ComplexInvRadix4T8(result_cmplx_intrlvd,
+                       &inv_root_of_unity_cmplx_intrlvd[W1_idx],
+                       &inv_root_of_unity_cmplx_intrlvd[W2_idx], n / 2, 4);
+  }
+}
+
+void Inverse_FFTLike_FromBitReverseRadix4ParallelAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplx_intrlvd, const uint64_t n,
+    const double* scale, uint64_t num_threads) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 16,
+             "Don't support small transforms. Need n >= 16, got n = " << n);
+
+  static const size_t base_fft_like_size = 1024;
+
+  const int threads = GetOmpNumThreads(num_threads);
+  if (threads <= 1 || n <= base_fft_like_size) {
+    Inverse_FFTLike_FromBitReverseRadix4AVX512(
+        result_cmplx_intrlvd, operand_cmplx_intrlvd,
+        inv_root_of_unity_cmplx_intrlvd, n, scale);
+    return;
+  }
+
+  // Same sub-transforms as Forward_FFTLike_ToBitReverseRadix4ParallelAVX512
+  uint64_t leaf_depth = 1;
+  uint64_t leaf_size = n / 2;
+  while (leaf_size > base_fft_like_size &&
+         (1ULL << leaf_depth) < static_cast<uint64_t>(threads)) {
+    leaf_depth += 2;
+    leaf_size >>= 2;
+  }
+  const int64_t num_leaves = 1LL << leaf_depth;
+
+#pragma omp parallel num_threads(threads)
+  {
+#pragma omp for
+    for (int64_t half = 0; half < num_leaves; ++half) {
+      const uint64_t offset = static_cast<uint64_t>(half) * 2 * leaf_size;
+      Inverse_FFTLike_FromBitReverseRadix4AVX512(
+          &result_cmplx_intrlvd[offset], &operand_cmplx_intrlvd[offset],
+          inv_root_of_unity_cmplx_intrlvd, leaf_size, scale, leaf_depth,
+          static_cast<uint64_t>(half));
+    }
+
+    // The passes above the leaves are split into column spans, so each
+    // butterfly is computed as in the serial transform
+    uint64_t size = leaf_size;
+    for (uint64_t depth = leaf_depth; depth > 1;) {
+      depth -= 2;
+      size <<= 2;
+      const int64_t num_halves = 1LL << depth;
+      const int64_t spans_per_half = (threads + num_halves - 1) / num_halves;
+#pragma omp for
+      for (int64_t t = 0; t < num_halves * spans_per_half; ++t) {
+        const uint64_t half = static_cast<uint64_t>(t / spans_per_half);
+        const size_t W1_idx = InvLastStageWIdx(n, depth + 1, half * 2);
+        const size_t W2_idx = InvLastStageWIdx(n, depth, half);
+        uint64_t begin;
+        uint64_t end;
+        GetColumnSpan(size / 2, spans_per_half, t % spans_per_half, &begin,
+                      &end);
+        ComplexInvRadix4T8Span(&result_cmplx_intrlvd[half * 2 * size],
+                               &inv_root_of_unity_cmplx_intrlvd[W1_idx],
+                               &inv_root_of_unity_cmplx_intrlvd[W2_idx],
+                               size / 2, begin, end);
+      }
+    }
+
+    const double* W_cmplx_intrlvd =
+        &inv_root_of_unity_cmplx_intrlvd[InvLastStageWIdx(n, 0, 0)];
+#pragma omp for
+    for (int64_t s = 0; s < threads; ++s) {
+      uint64_t begin;
+      uint64_t end;
+      GetColumnSpan(n, threads, s, &begin, &end);
+      ComplexFinalInvT8Span(result_cmplx_intrlvd, W_cmplx_intrlvd, n, begin,
+                            end, scale);
+    }
+  }
+}
+
+void Inverse_FFTLike_FromSlotsAVX512(
+    double* result_cmplx_intrlvd, const double* slots_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplx_intrlvd, const uint64_t* slot_index,
+    const uint64_t n, const double* scale) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n >= 32, "Need n >= 32, got n = " << n);
+  const uint64_t half_n = n / 2;
+
+  for (uint64_t j = 0; j < half_n; ++j) {
+    const double* slot = slots_cmplx_intrlvd + 2 * slot_index[j];
+    result_cmplx_intrlvd[2 * j] = slot[0];
+    result_cmplx_intrlvd[2 * j + 1] = slot[1];
+  }
+
+  // The sub-transform of the first half leaves its outputs X in the 8 complex
+  // interleaved layout
+  Inverse_FFTLike_FromBitReverseRadix4AVX512(
+      result_cmplx_intrlvd, result_cmplx_intrlvd,
+      inv_root_of_unity_cmplx_intrlvd, half_n, nullptr, 1, 0);
+
+  // The final stage has real outputs 2 * Re(X[j]) and 2 * Im(X[j]), written
+  // to j and j + n / 2
+  const __m512d v_factor =
+      _mm512_set1_pd(2.0 * (scale != nullptr ? *scale : 1.0));
+  __m512d* v_X_pt = reinterpret_cast<__m512d*>(result_cmplx_intrlvd);
+  __m512d* v_Y_pt = reinterpret_cast<__m512d*>(result_cmplx_intrlvd + n);
+  for (uint64_t j = 0; j < half_n; j += 8) {
+    __m512d v_X_real = _mm512_mul_pd(_mm512_loadu_pd(v_X_pt), v_factor);
+    __m512d v_Y_real = _mm512_mul_pd(_mm512_loadu_pd(v_X_pt + 1), v_factor);
+    __m512d v_X_imag = _mm512_setzero_pd();
+    __m512d v_Y_imag = _mm512_setzero_pd();
+    ComplexWriteInvInterleavedT8(&v_X_real, &v_X_imag, &v_Y_real, &v_Y_imag,
+                                 v_X_pt, v_Y_pt);
+    v_X_pt += 2;
+    v_Y_pt += 2;
+  }
+}
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
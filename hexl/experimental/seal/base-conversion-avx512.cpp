@@ -0,0 +1,118 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "experimental/seal/base-conversion-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512IFMA
+void FastBaseConversionAVX512IFMA(uint64_t* result, const uint64_t* y,
+                                  uint64_t n, uint64_t num_in_moduli,
+                                  const uint64_t* out_moduli,
+                                  uint64_t num_out_moduli,
+                                  const uint64_t* q_hat_mod_p,
+                                  const double* inv_q) {
+  HEXL_CHECK(num_in_moduli <= kMaxBaseConversionIFMAInputModuli,
+             "Too many input moduli " << num_in_moduli);
+
+  // Each term y_i * c_ij < 2^100, so its high 52-bit part is < 2^48. With at
+  // most 16 terms (including the overflow correction), the high accumulator
+  // stays below 2^52.
+  const uint64_t num_terms = num_in_moduli + (inv_q ? 1 : 0);
+  const uint64_t row_size = num_in_moduli + 1;
+
+  // Per output modulus constants for reducing acc_hi * 2^52 + acc_lo mod p_j
+  struct OutModulusConstants {
+    uint64_t modulus;
+    uint64_t two_pow_52;         // 2^52 mod p_j
+    uint64_t two_pow_52_precon;  // floor(2^52 * (2^52 mod p_j) / p_j)
+    uint64_t barrett_factor;     // floor(2^52 / p_j)
+  };
+  AlignedVector64<OutModulusConstants> constants(num_out_moduli);
+  for (size_t j = 0; j < num_out_moduli; ++j) {
+    uint64_t pj = out_moduli[j];
+    uint64_t two_pow_52 = (1ULL << 52) % pj;
+    constants[j] = {pj, two_pow_52,
+                    MultiplyFactor(two_pow_52, 52, pj).BarrettFactor(),
+                    MultiplyFactor(1, 52, pj).BarrettFactor()};
+  }
+
+  __m512i v_y[kMaxBaseConversionIFMAInputModuli + 1];
+  const __m512i v_zero = _mm512_setzero_si512();
+
+  for (size_t l = 0; l < n; l += 8) {
+    __mmask8 mask =
+        (n - l >= 8) ? 0xFF : static_cast<__mmask8>((1U << (n - l)) - 1);
+
+    for (size_t i = 0; i < num_in_moduli; ++i) {
+      v_y[i] = _mm512_maskz_loadu_epi64(mask, &y[i * n + l]);
+    }
+
+    if (inv_q) {
+      __m512d v_sum = _mm512_setzero_pd();
+      for (size_t i = 0; i < num_in_moduli; ++i) {
+        v_sum = _mm512_fmadd_pd(_mm512_cvtepu64_pd(v_y[i]),
+                                _mm512_set1_pd(inv_q[i]), v_sum);
+      }
+      v_y[num_in_moduli] = _mm512_cvt_roundpd_epu64(
+          v_sum, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    for (size_t j = 0; j < num_out_moduli; ++j) {
+      const uint64_t* row = &q_hat_mod_p[j * row_size];
+      const OutModulusConstants& c = constants[j];
+
+      __m512i v_acc_lo = v_zero;
+      __m512i v_acc_hi = v_zero;
+      for (size_t t = 0; t < num_terms; ++t) {
+        __m512i v_c = _mm512_set1_epi64(static_cast<int64_t>(row[t]));
+        v_acc_lo = _mm512_madd52lo_epu64(v_acc_lo, v_y[t], v_c);
+        v_acc_hi = _mm512_madd52hi_epu64(v_acc_hi, v_y[t], v_c);
+      }
+
+      // Move the carries out of the low 52 bits into the high accumulator
+      v_acc_hi = _mm512_add_epi64(v_acc_hi, _mm512_srli_epi64(v_acc_lo, 52));
+      v_acc_lo = ClearTopBits64<52>(v_acc_lo);
+
+      __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(c.modulus));
+      __m512i v_neg_modulus =
+          _mm512_set1_epi64(-static_cast<int64_t>(c.modulus));
+      __m512i v_twice_modulus =
+          _mm512_set1_epi64(static_cast<int64_t>(2 * c.modulus));
+
+      // acc_hi * 2^52 mod p_j in [0, 2 p_j), via Shoup's multiplication
+      __m512i v_two_pow_52 =
+          _mm512_set1_epi64(static_cast<int64_t>(c.two_pow_52));
+      __m512i v_two_pow_52_precon =
+          _mm512_set1_epi64(static_cast<int64_t>(c.two_pow_52_precon));
+      __m512i v_q_hat =
+          _mm512_hexl_mulhi_epi<52>(v_acc_hi, v_two_pow_52_precon);
+      __m512i v_hi_mod = _mm512_hexl_mullo_add_lo_epi<52>(
+          _mm512_hexl_mullo_epi<52>(v_acc_hi, v_two_pow_52), v_q_hat,
+          v_neg_modulus);
+
+      // acc_lo mod p_j in [0, 2 p_j), via Barrett reduction
+      __m512i v_barrett =
+          _mm512_set1_epi64(static_cast<int64_t>(c.barrett_factor));
+      v_q_hat = _mm512_hexl_mulhi_epi<52>(v_acc_lo, v_barrett);
+      __m512i v_lo_mod =
+          _mm512_hexl_mullo_add_lo_epi<52>(v_acc_lo, v_q_hat, v_neg_modulus);
+
+      __m512i v_result = _mm512_hexl_small_mod_epu64<4>(
+          _mm512_add_epi64(v_hi_mod, v_lo_mod), v_modulus, &v_twice_modulus);
+      _mm512_mask_storeu_epi64(&result[j * n + l], mask, v_result);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,31 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief Maximum number of input moduli supported by
+/// FastBaseConversionAVX512IFMA
+constexpr uint64_t kMaxBaseConversionIFMAInputModuli = 15;
+
+/// @brief Computes the matrix product step of the fast base conversion using
+/// AVX512IFMA. Each block of 8 coefficients is loaded once from every input
+/// limb and reused for all output moduli.
+/// @details Arguments are as in FastBaseConversionNative. Requires all input
+/// and output moduli to be less than 2^50 and num_in_moduli <=
+/// kMaxBaseConversionIFMAInputModuli.
+void FastBaseConversionAVX512IFMA(uint64_t* result, const uint64_t* y,
+                                  uint64_t n, uint64_t num_in_moduli,
+                                  const uint64_t* out_moduli,
+                                  uint64_t num_out_moduli,
+                                  const uint64_t* q_hat_mod_p,
+                                  const double* inv_q);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,33 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes the matrix product step of the fast base conversion,
+/// result_j = sum_i y_i * q_hat_mod_p[j][i] mod p_j, using scalar arithmetic
+/// @param[out] result Stores num_out_moduli limbs of n elements
+/// @param[in] y Scaled input limbs [x_i * (q / q_i)^{-1}]_{q_i}; stores
+/// num_in_moduli limbs of n elements
+/// @param[in] n Number of coefficients in each limb
+/// @param[in] num_in_moduli Number k of input moduli
+/// @param[in] out_moduli Array of num_out_moduli output moduli
+/// @param[in] num_out_moduli Number of output moduli
+/// @param[in] q_hat_mod_p Row-major num_out_moduli x (num_in_moduli + 1)
+/// matrix; column k holds -q mod p_j
+/// @param[in] inv_q Array of 1 / q_i. If not nullptr, the q-overflow
+/// round(sum_i y_i / q_i) is computed and corrected for using column k of
+/// \p q_hat_mod_p.
+void FastBaseConversionNative(uint64_t* result, const uint64_t* y, uint64_t n,
+                              uint64_t num_in_moduli,
+                              const uint64_t* out_moduli,
+                              uint64_t num_out_moduli,
+                              const uint64_t* q_hat_mod_p,
+                              const double* inv_q);
+
+}  // namespace hexl
+}  // namespace intel
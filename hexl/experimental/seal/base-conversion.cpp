@@ -0,0 +1,171 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/base-conversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "experimental/seal/base-conversion-avx512.hpp"
+#include "experimental/seal/base-conversion-internal.hpp"
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+BaseConverter::BaseConverter(const std::vector<uint64_t>& in_moduli,
+                             const std::vector<uint64_t>& out_moduli)
+    : m_in_moduli(in_moduli), m_out_moduli(out_moduli) {
+  HEXL_CHECK(!in_moduli.empty(), "Require at least one input modulus");
+  HEXL_CHECK(!out_moduli.empty(), "Require at least one output modulus");
+  HEXL_CHECK_BOUNDS(in_moduli.data(), in_moduli.size(), 1ULL << 62,
+                    "Input moduli must be less than 2^62");
+  HEXL_CHECK_BOUNDS(out_moduli.data(), out_moduli.size(), 1ULL << 62,
+                    "Output moduli must be less than 2^62");
+
+  size_t num_in = in_moduli.size();
+  size_t num_out = out_moduli.size();
+
+  // (q / q_i)^{-1} mod q_i
+  m_q_hat_inv_mod_q.resize(num_in);
+  for (size_t i = 0; i < num_in; ++i) {
+    uint64_t q_hat_mod_qi = 1;
+    for (size_t k = 0; k < num_in; ++k) {
+      if (k != i) {
+        q_hat_mod_qi = MultiplyMod(q_hat_mod_qi, in_moduli[k] % in_moduli[i],
+                                   in_moduli[i]);
+      }
+    }
+    m_q_hat_inv_mod_q[i] = InverseMod(q_hat_mod_qi, in_moduli[i]);
+  }
+
+  // (q / q_i) mod p_j, followed by -q mod p_j
+  m_q_hat_mod_p.resize(num_out * (num_in + 1));
+  for (size_t j = 0; j < num_out; ++j) {
+    uint64_t pj = out_moduli[j];
+    uint64_t* row = &m_q_hat_mod_p[j * (num_in + 1)];
+    uint64_t q_mod_pj = 1;
+    for (size_t i = 0; i < num_in; ++i) {
+      q_mod_pj = MultiplyMod(q_mod_pj, in_moduli[i] % pj, pj);
+      uint64_t q_hat_mod_pj = 1;
+      for (size_t k = 0; k < num_in; ++k) {
+        if (k != i) {
+          q_hat_mod_pj = MultiplyMod(q_hat_mod_pj, in_moduli[k] % pj, pj);
+        }
+      }
+      row[i] = q_hat_mod_pj;
+    }
+    row[num_in] = (q_mod_pj == 0) ? 0 : pj - q_mod_pj;
+  }
+
+  m_inv_q.resize(num_in);
+  for (size_t i = 0; i < num_in; ++i) {
+    m_inv_q[i] = 1.0 / static_cast<double>(in_moduli[i]);
+  }
+}
+
+void BaseConverter::FastBaseConversion(uint64_t* result,
+                                       const uint64_t* operand, uint64_t n,
+                                       bool exact, uint64_t* buffer) const {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(!m_in_moduli.empty(), "BaseConverter is not initialized");
+
+  size_t num_in = m_in_moduli.size();
+  size_t num_out = m_out_moduli.size();
+
+  AlignedVector64<uint64_t> allocated_buffer;
+  if (buffer == nullptr) {
+    allocated_buffer.resize(num_in * n);
+    buffer = allocated_buffer.data();
+  }
+
+  // y_i = [x_i * (q / q_i)^{-1}]_{q_i}
+  uint64_t* y = buffer;
+  for (size_t i = 0; i < num_in; ++i) {
+    EltwiseFMAMod(&y[i * n], &operand[i * n], m_q_hat_inv_mod_q[i], nullptr, n,
+                  m_in_moduli[i], 1);
+  }
+
+  const double* inv_q = exact ? m_inv_q.data() : nullptr;
+
+#ifdef HEXL_HAS_AVX512IFMA
+  uint64_t max_modulus =
+      std::max(*std::max_element(m_in_moduli.begin(), m_in_moduli.end()),
+               *std::max_element(m_out_moduli.begin(), m_out_moduli.end()));
+  if (has_avx512ifma && max_modulus < (1ULL << 50) &&
+      num_in <= kMaxBaseConversionIFMAInputModuli) {
+    HEXL_VLOG(3, "Calling FastBaseConversionAVX512IFMA");
+    FastBaseConversionAVX512IFMA(result, y, n, num_in, m_out_moduli.data(),
+                                 num_out, m_q_hat_mod_p.data(), inv_q);
+    return;
+  }
+#endif
+
+  HEXL_VLOG(3, "Calling FastBaseConversionNative");
+  FastBaseConversionNative(result, y, n, num_in, m_out_moduli.data(), num_out,
+                           m_q_hat_mod_p.data(), inv_q);
+}
+
+void FastBaseConversionNative(uint64_t* result, const uint64_t* y, uint64_t n,
+                              uint64_t num_in_moduli,
+                              const uint64_t* out_moduli,
+                              uint64_t num_out_moduli,
+                              const uint64_t* q_hat_mod_p,
+                              const double* inv_q) {
+  // Coefficients are processed in blocks, so the q-overflow of a block fits
+  // on the stack
+  constexpr size_t kBlockSize = 256;
+  uint64_t overflow[kBlockSize];
+
+  for (size_t block = 0; block < n; block += kBlockSize) {
+    const size_t block_end = std::min<size_t>(block + kBlockSize, n);
+
+    // q-overflow v = round(sum_i y_i / q_i), so that
+    // sum_i y_i * (q / q_i) - v * q is the centered representative of x. Ties
+    // round to even, as in FastBaseConversionAVX512IFMA, assuming the default
+    // rounding mode.
+    if (inv_q) {
+      for (size_t l = block; l < block_end; ++l) {
+        double sum = 0;
+        for (size_t i = 0; i < num_in_moduli; ++i) {
+          sum += static_cast<double>(y[i * n + l]) * inv_q[i];
+        }
+        overflow[l - block] = static_cast<uint64_t>(std::nearbyint(sum));
+      }
+    }
+
+    for (size_t j = 0; j < num_out_moduli; ++j) {
+      uint64_t pj = out_moduli[j];
+      const uint64_t* row = &q_hat_mod_p[j * (num_in_moduli + 1)];
+      uint64_t* result_j = &result[j * n];
+
+      for (size_t l = block; l < block_end; ++l) {
+        // Each product is < 2^64 * p_j, so its high word is < p_j
+        uint64_t acc_hi = 0;
+        uint64_t acc_lo = 0;
+        uint64_t prod_hi;
+        uint64_t prod_lo;
+        for (size_t i = 0; i < num_in_moduli; ++i) {
+          MultiplyUInt64(y[i * n + l], row[i], &prod_hi, &prod_lo);
+          AccumulateLazy128(&acc_hi, &acc_lo, prod_hi, prod_lo, pj);
+        }
+        if (inv_q) {
+          MultiplyUInt64(overflow[l - block], row[num_in_moduli], &prod_hi,
+                         &prod_lo);
+          AccumulateLazy128(&acc_hi, &acc_lo, prod_hi, prod_lo, pj);
+        }
+        result_j[l] = BarrettReduce128(acc_hi, acc_lo, pj);
+      }
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,165 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "experimental/seal/dyadic-multiply-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+namespace {
+
+// Returns x * y mod q in [0, q) for x, y < q, using Algorithm 2 from
+// https://homes.esat.kuleuven.be/~fvercaut/papers/bar_mont.pdf with
+// alpha - beta == BitShift, as in EltwiseMultModAVX512DQInt and
+// EltwiseMultModAVX512IFMAInt
+template <int BitShift>
+inline __m512i MultiplyModBarrett(__m512i x, __m512i y, __m512i v_modulus,
+                                  __m512i v_twice_mod, __m512i v_neg_mod,
+                                  __m512i v_barr_lo,
+                                  unsigned int prod_right_shift);
+
+template <>
+inline __m512i MultiplyModBarrett<64>(__m512i x, __m512i y, __m512i v_modulus,
+                                      __m512i v_twice_mod, __m512i v_neg_mod,
+                                      __m512i v_barr_lo,
+                                      unsigned int prod_right_shift) {
+  HEXL_UNUSED(v_neg_mod);
+  __m512i v_prod_hi = _mm512_hexl_mulhi_epi<64>(x, y);
+  __m512i v_prod_lo = _mm512_hexl_mullo_epi<64>(x, y);
+  __m512i c1 = _mm512_hexl_shrdi_epi64(v_prod_lo, v_prod_hi, prod_right_shift);
+  __m512i q_hat = _mm512_hexl_mulhi_approx_epi<64>(c1, v_barr_lo);
+  // Computes result in [0, 4q)
+  __m512i v_result =
+      _mm512_sub_epi64(v_prod_lo, _mm512_hexl_mullo_epi<64>(q_hat, v_modulus));
+  return _mm512_hexl_small_mod_epu64<4>(v_result, v_modulus, &v_twice_mod);
+}
+
+#ifdef HEXL_HAS_AVX512IFMA
+template <>
+inline __m512i MultiplyModBarrett<52>(__m512i x, __m512i y, __m512i v_modulus,
+                                      __m512i v_twice_mod, __m512i v_neg_mod,
+                                      __m512i v_barr_lo,
+                                      unsigned int prod_right_shift) {
+  HEXL_UNUSED(v_twice_mod);
+  __m512i v_prod_hi = _mm512_hexl_mulhi_epi<52>(x, y);
+  __m512i v_prod_lo = _mm512_hexl_mullo_epi<52>(x, y);
+  __m512i c1 = _mm512_or_epi64(
+      _mm512_srli_epi64(v_prod_lo, prod_right_shift),
+      _mm512_slli_epi64(v_prod_hi, 52 - prod_right_shift));
+  __m512i q_hat = _mm512_hexl_mulhi_epi<52>(c1, v_barr_lo);
+  // Computes result in [0, 2q)
+  __m512i v_result =
+      _mm512_hexl_mullo_add_lo_epi<52>(v_prod_lo, q_hat, v_neg_mod);
+  return _mm512_hexl_small_mod_epu64<2>(v_result, v_modulus);
+}
+#endif
+
+template <int BitShift>
+void DyadicMultiplyKaratsubaAVX512(uint64_t* result, const uint64_t* operand1,
+                                   const uint64_t* operand2, uint64_t n,
+                                   uint64_t poly_stride, uint64_t modulus) {
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    DyadicMultiplyKaratsubaNative(result, operand1, operand2, n_mod_8,
+                                  poly_stride, modulus);
+    operand1 += n_mod_8;
+    operand2 += n_mod_8;
+    result += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  constexpr int64_t beta = -2;
+  constexpr int64_t alpha = BitShift + beta;
+  const uint64_t ceil_log_mod = Log2(modulus) + 1;
+  const unsigned int prod_right_shift =
+      static_cast<unsigned int>(ceil_log_mod + beta);
+  const uint64_t barr_lo =
+      MultiplyFactor(uint64_t(1) << (ceil_log_mod + alpha - BitShift),
+                     BitShift, modulus)
+          .BarrettFactor();
+
+  const __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  const __m512i v_neg_mod = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  const __m512i v_barr_lo = _mm512_set1_epi64(static_cast<int64_t>(barr_lo));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(2 * modulus));
+
+  const __m512i* vp_x0 = reinterpret_cast<const __m512i*>(operand1);
+  const __m512i* vp_x1 =
+      reinterpret_cast<const __m512i*>(operand1 + poly_stride);
+  const __m512i* vp_y0 = reinterpret_cast<const __m512i*>(operand2);
+  const __m512i* vp_y1 =
+      reinterpret_cast<const __m512i*>(operand2 + poly_stride);
+  __m512i* vp_result0 = reinterpret_cast<__m512i*>(result);
+  __m512i* vp_result1 = reinterpret_cast<__m512i*>(result + poly_stride);
+  __m512i* vp_result2 = reinterpret_cast<__m512i*>(result + 2 * poly_stride);
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = n / 8; i > 0; --i) {
+    // Load every input before storing, so result may alias the operands
+    __m512i v_x0 = _mm512_loadu_si512(vp_x0++);
+    __m512i v_x1 = _mm512_loadu_si512(vp_x1++);
+    __m512i v_y0 = _mm512_loadu_si512(vp_y0++);
+    __m512i v_y1 = _mm512_loadu_si512(vp_y1++);
+
+    __m512i v_x_sum = _mm512_hexl_small_add_mod_epi64(v_x0, v_x1, v_modulus);
+    __m512i v_y_sum = _mm512_hexl_small_add_mod_epi64(v_y0, v_y1, v_modulus);
+
+    __m512i v_prod0 = MultiplyModBarrett<BitShift>(
+        v_x0, v_y0, v_modulus, v_twice_mod, v_neg_mod, v_barr_lo,
+        prod_right_shift);
+    __m512i v_prod2 = MultiplyModBarrett<BitShift>(
+        v_x1, v_y1, v_modulus, v_twice_mod, v_neg_mod, v_barr_lo,
+        prod_right_shift);
+    __m512i v_prod_sum = MultiplyModBarrett<BitShift>(
+        v_x_sum, v_y_sum, v_modulus, v_twice_mod, v_neg_mod, v_barr_lo,
+        prod_right_shift);
+
+    // (x0 + x1)(y0 + y1) + 2q - x0 y0 - x1 y1 is in (0, 3q)
+    __m512i v_prod1 = _mm512_sub_epi64(
+        _mm512_add_epi64(v_prod_sum, v_twice_mod),
+        _mm512_add_epi64(v_prod0, v_prod2));
+    v_prod1 = _mm512_hexl_small_mod_epu64<4>(v_prod1, v_modulus, &v_twice_mod);
+
+    _mm512_storeu_si512(vp_result0++, v_prod0);
+    _mm512_storeu_si512(vp_result1++, v_prod1);
+    _mm512_storeu_si512(vp_result2++, v_prod2);
+  }
+}
+
+}  // namespace
+
+void DyadicMultiplyKaratsubaAVX512DQ(uint64_t* result,
+                                     const uint64_t* operand1,
+                                     const uint64_t* operand2, uint64_t n,
+                                     uint64_t poly_stride, uint64_t modulus) {
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < 2^62");
+  DyadicMultiplyKaratsubaAVX512<64>(result, operand1, operand2, n, poly_stride,
+                                    modulus);
+}
+
+#ifdef HEXL_HAS_AVX512IFMA
+void DyadicMultiplyKaratsubaAVX512IFMA(uint64_t* result,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n,
+                                       uint64_t poly_stride, uint64_t modulus) {
+  HEXL_CHECK(modulus < (1ULL << 50), "Require modulus < 2^50");
+  DyadicMultiplyKaratsubaAVX512<52>(result, operand1, operand2, n, poly_stride,
+                                    modulus);
+}
+#endif
+
+#endif
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,31 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512DQ implementation of DyadicMultiplyKaratsubaNative
+void DyadicMultiplyKaratsubaAVX512DQ(uint64_t* result,
+                                     const uint64_t* operand1,
+                                     const uint64_t* operand2, uint64_t n,
+                                     uint64_t poly_stride, uint64_t modulus);
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief AVX512IFMA implementation of DyadicMultiplyKaratsubaNative;
+/// requires modulus < 2^50
+void DyadicMultiplyKaratsubaAVX512IFMA(uint64_t* result,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n,
+                                       uint64_t poly_stride, uint64_t modulus);
+#endif
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
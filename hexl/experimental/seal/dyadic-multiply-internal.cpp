@@ -3,17 +3,185 @@
 
 #include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "experimental/seal/dyadic-multiply-avx512.hpp"
 #include "hexl/eltwise/eltwise-add-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/experimental/seal/dyadic-multiply.hpp"
+#include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
+#include "hexl/util/compiler.hpp"
 #include "util/cpu-features.hpp"
+#include "util/measure-algorithm.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
+
+namespace {
+
+std::atomic<DyadicMultiplyAlgorithm> dyadic_multiply_algorithm{
+    DyadicMultiplyAlgorithm::kAuto};
+std::atomic<uint64_t> dyadic_multiply_num_threads{0};
+
+}  // namespace
+
+void SetDyadicMultiplyAlgorithm(DyadicMultiplyAlgorithm algorithm) {
+  dyadic_multiply_algorithm.store(algorithm);
+}
+
+DyadicMultiplyAlgorithm GetDyadicMultiplyAlgorithm() {
+  return dyadic_multiply_algorithm.load();
+}
+
+void SetDyadicMultiplyNumThreads(uint64_t num_threads) {
+  dyadic_multiply_num_threads.store(num_threads);
+}
+
+uint64_t GetDyadicMultiplyNumThreads() {
+  return dyadic_multiply_num_threads.load();
+}
+
 namespace internal {
 
+namespace {
+
+// Computes one tile of one modulus with four EltwiseMultMod calls and an
+// EltwiseAddMod; temp holds n elements
+void DyadicMultiplySchoolbook(uint64_t* result, const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t poly_stride, uint64_t modulus,
+                              uint64_t* temp) {
+  // Compute third output polynomial
+  // Output written directly to result rather than temporary buffer
+  // result[2] = x[1] * y[1]
+  intel::hexl::EltwiseMultMod(&result[2 * poly_stride],
+                              operand1 + poly_stride, operand2 + poly_stride,
+                              n, modulus, 1);
+
+  // Compute second output polynomial
+  // result[1] = x[1] * y[0]
+  intel::hexl::EltwiseMultMod(temp, operand1 + poly_stride, operand2, n,
+                              modulus, 1);
+  // result[1] = x[0] * y[1]
+  intel::hexl::EltwiseMultMod(&result[poly_stride], operand1,
+                              operand2 + poly_stride, n, modulus, 1);
+  // result[1] += temp_poly
+  intel::hexl::EltwiseAddMod(&result[poly_stride], temp, &result[poly_stride],
+                             n, modulus);
+
+  // Compute first output polynomial
+  // result[0] = x[0] * y[0]
+  intel::hexl::EltwiseMultMod(result, operand1, operand2, n, modulus, 1);
+}
+
+// Computes one tile of one modulus with the fused three-product kernel
+void DyadicMultiplyKaratsuba(uint64_t* result, const uint64_t* operand1,
+                             const uint64_t* operand2, uint64_t n,
+                             uint64_t poly_stride, uint64_t modulus) {
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && modulus < (1ULL << 50)) {
+    HEXL_VLOG(3, "Calling DyadicMultiplyKaratsubaAVX512IFMA");
+    DyadicMultiplyKaratsubaAVX512IFMA(result, operand1, operand2, n,
+                                      poly_stride, modulus);
+    return;
+  }
+#endif
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling DyadicMultiplyKaratsubaAVX512DQ");
+    DyadicMultiplyKaratsubaAVX512DQ(result, operand1, operand2, n, poly_stride,
+                                    modulus);
+    return;
+  }
+#endif
+  HEXL_VLOG(3, "Calling DyadicMultiplyKaratsubaNative");
+  DyadicMultiplyKaratsubaNative(result, operand1, operand2, n, poly_stride,
+                                modulus);
+}
+
+// Times both methods on a tile with the given modulus and returns the faster.
+// Ties keep kSchoolbook.
+DyadicMultiplyAlgorithm MeasureDyadicMultiplyAlgorithm(uint64_t modulus) {
+  constexpr uint64_t kNumElements = 512;
+  AlignedVector64<uint64_t> operand1(2 * kNumElements);
+  AlignedVector64<uint64_t> operand2(2 * kNumElements);
+  AlignedVector64<uint64_t> result(3 * kNumElements);
+  AlignedVector64<uint64_t> temp(kNumElements);
+  GenerateTimingOperands(operand1.data(), operand2.data(), 2 * kNumElements,
+                         modulus);
+
+  return MeasureFastestAlgorithm(
+      std::vector<DyadicMultiplyAlgorithm>{
+          DyadicMultiplyAlgorithm::kSchoolbook,
+          DyadicMultiplyAlgorithm::kKaratsuba},
+      [&](DyadicMultiplyAlgorithm algorithm) {
+        if (algorithm == DyadicMultiplyAlgorithm::kKaratsuba) {
+          DyadicMultiplyKaratsuba(result.data(), operand1.data(),
+                                  operand2.data(), kNumElements, kNumElements,
+                                  modulus);
+        } else {
+          DyadicMultiplySchoolbook(result.data(), operand1.data(),
+                                   operand2.data(), kNumElements, kNumElements,
+                                   modulus, temp.data());
+        }
+      });
+}
+
+// Returns the method DyadicMultiply uses for the given modulus. Inside an
+// OpenMP parallel region, kSchoolbook is used until the kAuto choice has been
+// measured outside one.
+DyadicMultiplyAlgorithm SelectDyadicMultiplyAlgorithm(uint64_t modulus) {
+  if (modulus >= (1ULL << 62)) {
+    return DyadicMultiplyAlgorithm::kSchoolbook;
+  }
+  DyadicMultiplyAlgorithm algorithm = GetDyadicMultiplyAlgorithm();
+  if (algorithm != DyadicMultiplyAlgorithm::kAuto) {
+    return algorithm;
+  }
+  // The EltwiseMultMod kernel, and hence the faster method, changes at 2^50
+  if (modulus < (1ULL << 50)) {
+    static MeasuredAlgorithm<DyadicMultiplyAlgorithm> small_modulus_algorithm;
+    return small_modulus_algorithm.Get(
+        DyadicMultiplyAlgorithm::kSchoolbook,
+        []() { return MeasureDyadicMultiplyAlgorithm((1ULL << 49) + 9); });
+  }
+  static MeasuredAlgorithm<DyadicMultiplyAlgorithm> large_modulus_algorithm;
+  return large_modulus_algorithm.Get(
+      DyadicMultiplyAlgorithm::kSchoolbook,
+      []() { return MeasureDyadicMultiplyAlgorithm((1ULL << 59) + 9); });
+}
+
+// Returns the number of coefficients per tile: the largest power of two for
+// which the eight tile-sized arrays of the schoolbook method (four inputs,
+// three outputs and a temporary) fit in the L1 data cache, or in half the L2
+// cache if the L1 size is unknown
+uint64_t DyadicMultiplyTileSize() {
+  static const uint64_t tile_size = []() {
+    constexpr uint64_t kBytesPerCoeff = 8 * sizeof(uint64_t);
+    uint64_t cache_size = GetDataCacheSize(1);
+    if (cache_size == 0) {
+      cache_size = GetDataCacheSize(2) / 2;
+    }
+    if (cache_size < 64 * kBytesPerCoeff) {
+      return uint64_t(512);
+    }
+    uint64_t tile = 64;
+    while (2 * tile * kBytesPerCoeff <= cache_size) {
+      tile *= 2;
+    }
+    return tile;
+  }();
+  return tile_size;
+}
+
+}  // namespace
+
 void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
                     const uint64_t* moduli, uint64_t num_moduli) {
@@ -29,50 +197,99 @@ void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
   // Output ciphertext has 3 polynomials, where x, y are the input
   // ciphertexts: (x[0] * y[0], x[0] * y[1] + x[1] * y[0], x[1] * y[1])
 
-  // TODO(fboemer): Determine based on cpu cache size
-  size_t tile_size = std::min(n, uint64_t(512));
-  size_t num_tiles = n / tile_size;
-
-  AlignedVector64<uint64_t> temp(tile_size, 0);
-
-  // Modulus by modulus
-  for (size_t i = 0; i < num_moduli; i++) {
-    // Split by tiles for better caching
-    size_t i_times_n = i * n;
-    for (size_t tile = 0; tile < num_tiles; ++tile) {
-      size_t poly0_offset = i_times_n + tile_size * tile;
-      size_t poly1_offset = poly0_offset + poly_size;
-      size_t poly2_offset = poly0_offset + 2 * poly_size;
-
-      // Compute third output polynomial
-      // Output written directly to result rather than temporary buffer
-      // result[2] = x[1] * y[1]
-      intel::hexl::EltwiseMultMod(
-          &result[poly2_offset], operand1 + poly1_offset,
-          operand2 + poly1_offset, tile_size, moduli[i], 1);
-
-      // Compute second output polynomial
-      // result[1] = x[1] * y[0]
-      intel::hexl::EltwiseMultMod(temp.data(), operand1 + poly1_offset,
-                                  operand2 + poly0_offset, tile_size, moduli[i],
-                                  1);
-      // result[1] = x[0] * y[1]
-      intel::hexl::EltwiseMultMod(
-          &result[poly1_offset], operand1 + poly0_offset,
-          operand2 + poly1_offset, tile_size, moduli[i], 1);
-      // result[1] += temp_poly
-      intel::hexl::EltwiseAddMod(&result[poly1_offset], temp.data(),
-                                 &result[poly1_offset], tile_size, moduli[i]);
-
-      // Compute first output polynomial
-      // result[0] = x[0] * y[0]
-      intel::hexl::EltwiseMultMod(
-          &result[poly0_offset], operand1 + poly0_offset,
-          operand2 + poly0_offset, tile_size, moduli[i], 1);
+  size_t tile_size = std::min(n, DyadicMultiplyTileSize());
+  size_t num_tiles = (n + tile_size - 1) / tile_size;
+
+  // Measure the kAuto choice, if not done yet, before entering the parallel
+  // region
+  for (size_t i = 0; i < num_moduli; ++i) {
+    SelectDyadicMultiplyAlgorithm(moduli[i]);
+  }
+
+  // Every (modulus, tile) pair is independent
+  const int64_t num_tasks = static_cast<int64_t>(num_moduli * num_tiles);
+  const int num_threads = GetOmpNumThreads(GetDyadicMultiplyNumThreads());
+#pragma omp parallel num_threads(num_threads) if (num_tasks > 1)
+  {
+    AlignedVector64<uint64_t> temp;
+
+#pragma omp for
+    for (int64_t task = 0; task < num_tasks; ++task) {
+      size_t i = static_cast<size_t>(task) / num_tiles;
+      size_t tile = static_cast<size_t>(task) % num_tiles;
+      size_t poly0_offset = i * n + tile_size * tile;
+      size_t coeff_count = std::min(tile_size, n - tile_size * tile);
+
+      DyadicMultiplyAlgorithm algorithm =
+          SelectDyadicMultiplyAlgorithm(moduli[i]);
+      if (algorithm == DyadicMultiplyAlgorithm::kKaratsuba) {
+        DyadicMultiplyKaratsuba(&result[poly0_offset], operand1 + poly0_offset,
+                                operand2 + poly0_offset, coeff_count,
+                                poly_size, moduli[i]);
+      } else {
+        if (temp.empty()) {
+          temp.resize(tile_size, 0);
+        }
+        DyadicMultiplySchoolbook(&result[poly0_offset],
+                                 operand1 + poly0_offset,
+                                 operand2 + poly0_offset, coeff_count,
+                                 poly_size, moduli[i], temp.data());
+      }
     }
   }
 }
 
+void DyadicMultiplyKaratsubaNative(uint64_t* result, const uint64_t* operand1,
+                                   const uint64_t* operand2, uint64_t n,
+                                   uint64_t poly_stride, uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < 2^62");
+
+  // Barrett multiplication, Algorithm 2 from
+  // https://homes.esat.kuleuven.be/~fvercaut/papers/bar_mont.pdf, with
+  // alpha = 62 and beta = -2 as in EltwiseMultModNative
+  const uint64_t ceil_log_mod = Log2(modulus) + 1;
+  const uint64_t prod_right_shift = ceil_log_mod - 2;
+  const uint64_t barr_lo =
+      MultiplyFactor(uint64_t(1) << (ceil_log_mod - 2), 64, modulus)
+          .BarrettFactor();
+  auto multiply_mod = [=](uint64_t x, uint64_t y) {
+    uint64_t prod_hi, prod_lo, c2_hi, c2_lo;
+    MultiplyUInt64(x, y, &prod_hi, &prod_lo);
+    uint64_t c1 = (prod_lo >> prod_right_shift) +
+                  (prod_hi << (64 - prod_right_shift));
+    MultiplyUInt64(c1, barr_lo, &c2_hi, &c2_lo);
+    uint64_t z = prod_lo - c2_hi * modulus;
+    return (z >= modulus) ? (z - modulus) : z;
+  };
+
+  const uint64_t twice_modulus = 2 * modulus;
+  const uint64_t* x1 = operand1 + poly_stride;
+  const uint64_t* y1 = operand2 + poly_stride;
+  uint64_t* result1 = result + poly_stride;
+  uint64_t* result2 = result + 2 * poly_stride;
+  HEXL_CHECK_BOUNDS(operand1, n, modulus, "operand1 exceeds bound " << modulus);
+  HEXL_CHECK_BOUNDS(x1, n, modulus, "operand1 exceeds bound " << modulus);
+  HEXL_CHECK_BOUNDS(operand2, n, modulus, "operand2 exceeds bound " << modulus);
+  HEXL_CHECK_BOUNDS(y1, n, modulus, "operand2 exceeds bound " << modulus);
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < n; ++i) {
+    // Read every input before writing, so result may alias the operands
+    uint64_t x_sum = AddUIntMod(operand1[i], x1[i], modulus);
+    uint64_t y_sum = AddUIntMod(operand2[i], y1[i], modulus);
+    uint64_t prod0 = multiply_mod(operand1[i], operand2[i]);
+    uint64_t prod2 = multiply_mod(x1[i], y1[i]);
+    uint64_t prod_sum = multiply_mod(x_sum, y_sum);
+
+    // (x0 + x1)(y0 + y1) + 2q - x0 y0 - x1 y1 is in (0, 3q)
+    result1[i] = ReduceMod<4>(prod_sum + twice_modulus - prod0 - prod2,
+                              modulus, &twice_modulus);
+    result[i] = prod0;
+    result2[i] = prod2;
+  }
+}
+
 }  // namespace internal
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,202 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/hybrid-key-switch.hpp"
+
+#include <algorithm>
+
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/eltwise/eltwise-sub-mod.hpp"
+#include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/experimental/seal/ntt-cache.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+HybridKeySwitcher::HybridKeySwitcher(uint64_t n,
+                                     const std::vector<uint64_t>& moduli,
+                                     uint64_t special_modulus_size,
+                                     uint64_t digit_size)
+    : m_n(n),
+      m_special_modulus_size(special_modulus_size),
+      m_digit_size(digit_size),
+      m_moduli(moduli) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of two");
+  HEXL_CHECK(special_modulus_size > 0,
+             "Require at least one special modulus");
+  HEXL_CHECK(moduli.size() > special_modulus_size,
+             "Require at least one ciphertext modulus");
+  HEXL_CHECK(digit_size > 0, "Require digit_size > 0");
+
+  for (uint64_t modulus : moduli) {
+    m_ntts.push_back(GetNTTShared(n, modulus));
+  }
+
+  size_t num_special = special_modulus_size;
+  size_t num_q = moduli.size() - num_special;
+  std::vector<uint64_t> p_moduli(moduli.begin() + num_q, moduli.end());
+
+  // Base converters for every level l + 1 = 1, ..., num_q
+  m_mod_up.resize(num_q);
+  m_mod_down.reserve(num_q);
+  for (size_t l = 0; l < num_q; ++l) {
+    size_t level_size = l + 1;
+    std::vector<uint64_t> q_moduli(moduli.begin(), moduli.begin() + level_size);
+    for (size_t begin = 0; begin < level_size; begin += digit_size) {
+      size_t end = std::min(begin + digit_size, level_size);
+      std::vector<uint64_t> digit_moduli(q_moduli.begin() + begin,
+                                         q_moduli.begin() + end);
+      std::vector<uint64_t> other_moduli(q_moduli.begin(),
+                                         q_moduli.begin() + begin);
+      other_moduli.insert(other_moduli.end(), q_moduli.begin() + end,
+                          q_moduli.end());
+      other_moduli.insert(other_moduli.end(), p_moduli.begin(),
+                          p_moduli.end());
+      m_mod_up[l].emplace_back(digit_moduli, other_moduli);
+    }
+    m_mod_down.emplace_back(p_moduli, q_moduli);
+  }
+
+  // P^{-1} mod q_i and floor(P / 2) = (P - 1) / 2 mod q_i, p_j, since P is odd
+  m_p_inv_mod_q.resize(num_q);
+  m_p_half_mod_q.resize(num_q);
+  for (size_t i = 0; i < num_q; ++i) {
+    uint64_t qi = moduli[i];
+    uint64_t p_mod_qi = 1;
+    for (uint64_t pj : p_moduli) {
+      p_mod_qi = MultiplyMod(p_mod_qi, pj % qi, qi);
+    }
+    m_p_inv_mod_q[i] = InverseMod(p_mod_qi, qi);
+    uint64_t inv_two = (qi + 1) / 2;
+    m_p_half_mod_q[i] = MultiplyMod((p_mod_qi + qi - 1) % qi, inv_two, qi);
+  }
+  m_p_half_mod_p.resize(num_special);
+  for (size_t j = 0; j < num_special; ++j) {
+    m_p_half_mod_p[j] = (p_moduli[j] - 1) / 2;
+  }
+}
+
+void HybridKeySwitcher::KeySwitch(uint64_t* result,
+                                  const uint64_t* t_target_iter_ptr,
+                                  uint64_t decomp_modulus_size,
+                                  uint64_t key_component_count,
+                                  const uint64_t** k_switch_keys) const {
+  HEXL_CHECK(!m_moduli.empty(), "HybridKeySwitcher is not initialized");
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(t_target_iter_ptr != nullptr,
+             "Require t_target_iter_ptr != nullptr");
+  HEXL_CHECK(k_switch_keys != nullptr, "Require k_switch_keys != nullptr");
+  HEXL_CHECK(decomp_modulus_size > 0 &&
+                 decomp_modulus_size <= m_mod_down.size(),
+             "Invalid decomp_modulus_size " << decomp_modulus_size);
+
+  const uint64_t n = m_n;
+  const uint64_t key_modulus_size = m_moduli.size();
+  const uint64_t num_q = key_modulus_size - m_special_modulus_size;
+  const uint64_t num_special = m_special_modulus_size;
+  // The extended basis q_0, ..., q_{decomp_modulus_size - 1}, p_0, ...
+  const uint64_t ext_modulus_size = decomp_modulus_size + num_special;
+  const int num_threads = GetOmpNumThreads(GetKeySwitchNumThreads());
+
+  // Index of extended limb i within m_moduli and each key component
+  auto key_limb = [&](uint64_t i) {
+    return i < decomp_modulus_size ? i : num_q + i - decomp_modulus_size;
+  };
+
+  // In CKKS t_target is in NTT form; switch a copy back to normal form
+  AlignedVector64<uint64_t> t_target(n * decomp_modulus_size);
+  const int64_t num_target_limbs = static_cast<int64_t>(decomp_modulus_size);
+#pragma omp parallel for num_threads(num_threads)
+  for (int64_t i = 0; i < num_target_limbs; ++i) {
+    m_ntts[i]->ComputeInverse(&t_target[i * n], &t_target_iter_ptr[i * n], 1,
+                              1);
+  }
+
+  AlignedVector64<uint64_t> t_poly_prod(
+      key_component_count * ext_modulus_size * n, 0);
+  AlignedVector64<uint64_t> t_mod_up(ext_modulus_size * n);
+  AlignedVector64<uint64_t> t_prod(ext_modulus_size * n);
+
+  const std::vector<BaseConverter>& mod_up =
+      m_mod_up[decomp_modulus_size - 1];
+  const int64_t num_ext_limbs = static_cast<int64_t>(ext_modulus_size);
+  for (uint64_t digit = 0; digit < mod_up.size(); ++digit) {
+    uint64_t begin = digit * m_digit_size;
+    uint64_t end = std::min(begin + m_digit_size, decomp_modulus_size);
+    uint64_t digit_limbs = end - begin;
+
+    // ModUp: raise the digit to the other moduli; the result is the digit
+    // plus a small multiple of its modulus, which the key's gadget factor
+    // annihilates
+    mod_up[digit].FastBaseConversion(t_mod_up.data(), &t_target[begin * n], n,
+                                     false);
+
+#pragma omp parallel for num_threads(num_threads)
+    for (int64_t ext_i = 0; ext_i < num_ext_limbs; ++ext_i) {
+      uint64_t i = static_cast<uint64_t>(ext_i);
+      uint64_t key_index = key_limb(i);
+      uint64_t modulus = m_moduli[key_index];
+      const uint64_t* t_operand;
+      if (i >= begin && i < end) {
+        t_operand = &t_target_iter_ptr[i * n];
+      } else {
+        uint64_t* t_mod_up_limb =
+            &t_mod_up[(i < begin ? i : i - digit_limbs) * n];
+        m_ntts[key_index]->ComputeForward(t_mod_up_limb, t_mod_up_limb, 1, 1);
+        t_operand = t_mod_up_limb;
+      }
+
+      // Multiply with the digit's key and accumulate
+      uint64_t* t_prod_limb = &t_prod[i * n];
+      for (uint64_t k = 0; k < key_component_count; ++k) {
+        const uint64_t* key =
+            &k_switch_keys[digit][(k * key_modulus_size + key_index) * n];
+        uint64_t* t_poly_prod_limb =
+            &t_poly_prod[(k * ext_modulus_size + i) * n];
+        EltwiseMultMod(t_prod_limb, t_operand, key, n, modulus, 1);
+        EltwiseAddMod(t_poly_prod_limb, t_poly_prod_limb, t_prod_limb, n,
+                      modulus);
+      }
+    }
+  }
+
+  // ModDown: divide by P and round, then add to the ciphertext. Adding
+  // floor(P / 2) before the exact division turns the floor into a rounding.
+  const BaseConverter& mod_down = m_mod_down[decomp_modulus_size - 1];
+  const int64_t num_special_limbs = static_cast<int64_t>(num_special);
+  for (uint64_t k = 0; k < key_component_count; ++k) {
+    uint64_t* t_poly_prod_k = &t_poly_prod[k * ext_modulus_size * n];
+    uint64_t* t_special = &t_poly_prod_k[decomp_modulus_size * n];
+
+#pragma omp parallel for num_threads(num_threads)
+    for (int64_t j = 0; j < num_special_limbs; ++j) {
+      uint64_t pj = m_moduli[num_q + j];
+      uint64_t* limb = &t_special[j * n];
+      m_ntts[num_q + j]->ComputeInverse(limb, limb, 1, 1);
+      EltwiseAddMod(limb, limb, m_p_half_mod_p[j], n, pj);
+    }
+
+    mod_down.FastBaseConversion(t_mod_up.data(), t_special, n, false);
+
+#pragma omp parallel for num_threads(num_threads)
+    for (int64_t i = 0; i < num_target_limbs; ++i) {
+      uint64_t qi = m_moduli[i];
+      uint64_t* limb = &t_mod_up[i * n];
+      EltwiseSubMod(limb, limb, m_p_half_mod_q[i], n, qi);
+      m_ntts[i]->ComputeForward(limb, limb, 1, 1);
+      EltwiseSubMod(limb, &t_poly_prod_k[i * n], limb, n, qi);
+      uint64_t* result_limb = &result[(k * decomp_modulus_size + i) * n];
+      EltwiseFMAMod(result_limb, limb, m_p_inv_mod_q[i], result_limb, n, qi,
+                    1);
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,201 +3,310 @@
 
 #include "hexl/experimental/seal/key-switch-internal.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <exception>
 #include <iostream>
+#include <memory>
 
 #include "hexl/eltwise/eltwise-add-mod.hpp"
-#include "hexl/eltwise/eltwise-fma-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
 #include "hexl/experimental/seal/ntt-cache.hpp"
+#include "hexl/experimental/seal/rns-rescale.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
-namespace internal {
 
-void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
-               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
-               uint64_t rns_modulus_size, uint64_t key_component_count,
-               const uint64_t* moduli, const uint64_t** k_switch_keys,
-               const uint64_t* modswitch_factors,
-               const uint64_t* root_of_unity_powers_ptr) {
-  if (root_of_unity_powers_ptr != nullptr) {
-    throw std::invalid_argument(
-        "Parameter root_of_unity_powers_ptr is not supported yet.");
-  }
+namespace {
+std::atomic<uint64_t> key_switch_num_threads{0};
+}  // namespace
+
+void SetKeySwitchNumThreads(uint64_t num_threads) {
+  key_switch_num_threads.store(num_threads);
+}
 
+uint64_t GetKeySwitchNumThreads() { return key_switch_num_threads.load(); }
+
+namespace internal {
+
+namespace {
+
+// Number of 128-bit accumulators per tile of coefficients, shared among the
+// key components. The key tiles for one tile of coefficients stay in cache
+// while every target of the batch is accumulated against them.
+constexpr uint64_t kKeySwitchAccumulatorSize = 512;
+
+// Key switches batch_size <= workspace.BatchSize() targets in one pass over
+// k_switch_keys. ntts holds the NTTs of the rns_modulus_size moduli, in the
+// order of the RNSRescale moduli.
+void KeySwitchBatchTile(uint64_t* const* results,
+                        const uint64_t* const* t_target_iter_ptrs,
+                        uint64_t batch_size, uint64_t n,
+                        uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                        uint64_t rns_modulus_size, uint64_t key_component_count,
+                        const uint64_t* moduli, const uint64_t** k_switch_keys,
+                        const uint64_t* modswitch_factors,
+                        KeySwitchWorkspace& workspace, NTT* const* ntts,
+                        int num_threads) {
   uint64_t coeff_count = n;
 
-  // Create a copy of target_iter
-  std::vector<uint64_t> t_target(
-      t_target_iter_ptr,
-      t_target_iter_ptr + (coeff_count * decomp_modulus_size));
-  uint64_t* t_target_ptr = t_target.data();
-
-  // Simplified implementation, where we assume no modular reduction is required
-  // for intermediate additions
-  std::vector<uint64_t> t_ntt(coeff_count, 0);
-  uint64_t* t_ntt_ptr = t_ntt.data();
-
-  // In CKKS t_target is in NTT form; switch
-  // back to normal form
-  for (size_t j = 0; j < decomp_modulus_size; ++j) {
-    GetNTT(n, moduli[j])
-        .ComputeInverse(&t_target_ptr[j * coeff_count],
-                        &t_target_ptr[j * coeff_count], 2, 1);
+  // In CKKS t_target is in NTT form; switch a copy back to normal form.
+  // t_target_ptr holds batch_size blocks of decomp_modulus_size limbs.
+  uint64_t* t_target_ptr = workspace.Target();
+  const int64_t num_target_limbs =
+      static_cast<int64_t>(batch_size * decomp_modulus_size);
+#pragma omp parallel for num_threads(num_threads)
+  for (int64_t bj = 0; bj < num_target_limbs; ++bj) {
+    size_t b = static_cast<size_t>(bj) / decomp_modulus_size;
+    size_t j = static_cast<size_t>(bj) % decomp_modulus_size;
+    ntts[j]->ComputeInverse(
+        &t_target_ptr[static_cast<size_t>(bj) * coeff_count],
+        &t_target_iter_ptrs[b][j * coeff_count], 2, 1);
   }
 
-  std::vector<uint64_t> t_poly_prod(
-      key_component_count * coeff_count * rns_modulus_size, 0);
+  uint64_t* t_poly_prod = workspace.PolyProd();
+  uint64_t* t_ntt_ptr = workspace.NTTOperand();
+  const uint64_t poly_prod_size =
+      coeff_count * key_component_count * rns_modulus_size;
+  const size_t tile_size = kKeySwitchAccumulatorSize / key_component_count;
+  const int64_t num_tiles =
+      static_cast<int64_t>((coeff_count + tile_size - 1) / tile_size);
 
   for (size_t i = 0; i < rns_modulus_size; ++i) {
     size_t key_index = (i == decomp_modulus_size ? key_modulus_size - 1 : i);
-
-    // Allocate memory for a lazy accumulator (128-bit coefficients)
-    std::vector<uint64_t> t_poly_lazy(key_component_count * coeff_count * 2, 0);
-    uint64_t* t_poly_lazy_ptr = &t_poly_lazy[0];
-    uint64_t* accumulator_ptr = &t_poly_lazy[0];
-
-    for (size_t j = 0; j < decomp_modulus_size; ++j) {
-      const uint64_t* t_operand;
-      // assume scheme == scheme_type::ckks
-      if (i == j) {
-        t_operand = &t_target_iter_ptr[j * coeff_count];
-      } else {
-        // Perform RNS-NTT conversion
-        // No need to perform RNS conversion (modular reduction)
-        if (moduli[j] <= moduli[key_index]) {
-          for (size_t l = 0; l < coeff_count; ++l) {
-            t_ntt_ptr[l] = t_target_ptr[j * coeff_count + l];
-          }
-        } else {
-          // Perform RNS conversion (modular reduction)
-          intel::hexl::EltwiseReduceMod(
-              t_ntt_ptr, &t_target_ptr[j * coeff_count], coeff_count,
-              moduli[key_index], moduli[key_index], 1);
-        }
-
+    uint64_t modulus = moduli[key_index];
+    NTT& ntt = *ntts[i];
+
+    // Perform RNS-NTT conversion of every target limb j != i
+#pragma omp parallel for num_threads(num_threads)
+    for (int64_t bj = 0; bj < num_target_limbs; ++bj) {
+      size_t j = static_cast<size_t>(bj) % decomp_modulus_size;
+      // assume scheme == scheme_type::ckks; limb i is already in NTT form
+      if (j == i) {
+        continue;
+      }
+      uint64_t* ntt_limb = &t_ntt_ptr[static_cast<size_t>(bj) * coeff_count];
+      const uint64_t* target_limb =
+          &t_target_ptr[static_cast<size_t>(bj) * coeff_count];
+      // The target limb is in [0, moduli[j]), and the NTT accepts lazy inputs
+      // in [0, 4q), so RNS conversion is only needed for moduli[j] > 4q
+      if (moduli[j] <= 4 * modulus) {
         // NTT conversion lazy outputs in [0, 4q)
-        GetNTT(n, moduli[key_index]).ComputeForward(t_ntt_ptr, t_ntt_ptr, 4, 4);
-        t_operand = t_ntt_ptr;
+        ntt.ComputeForward(ntt_limb, target_limb, 4, 4);
+        continue;
       }
-
-      // Multiply with keys and modular accumulate products in a lazy fashion
-      for (size_t k = 0; k < key_component_count; ++k) {
-        // No reduction used; assume intermediate results don't overflow
-        for (size_t l = 0; l < coeff_count; ++l) {
-          uint64_t t_poly_idx = 2 * (k * coeff_count + l);
-
-          uint64_t mult_op2_idx =
-              coeff_count * key_index + k * key_modulus_size * coeff_count + l;
-
-          uint128_t prod =
-              MultiplyUInt64(t_operand[l], k_switch_keys[j][mult_op2_idx]);
-
-          // TODO(fboemer): add uint128
-          uint128_t low = t_poly_lazy_ptr[t_poly_idx];
-          uint128_t hi = t_poly_lazy_ptr[t_poly_idx + 1];
-          uint128_t x = (hi << 64) + low;
-          uint128_t sum = prod + x;
-          uint64_t sum_hi = static_cast<uint64_t>(sum >> 64);
-          uint64_t sum_lo = static_cast<uint64_t>(sum);
-          t_poly_lazy_ptr[t_poly_idx] = sum_lo;
-          t_poly_lazy_ptr[t_poly_idx + 1] = sum_hi;
-        }
+      // Reduce lazily from the smallest power-of-two multiple of q above
+      // moduli[j]
+      uint64_t ratio = moduli[j] / modulus + (moduli[j] % modulus != 0);
+      uint64_t input_mod_factor = 8;
+      while (input_mod_factor < ratio) {
+        input_mod_factor <<= 1;
       }
+      EltwiseReduceMod(ntt_limb, target_limb, coeff_count, modulus,
+                       input_mod_factor, 4);
+      ntt.ComputeForward(ntt_limb, ntt_limb, 4, 4);
     }
 
-    // PolyIter pointing to the destination t_poly_prod, shifted to the
-    // appropriate modulus
-    uint64_t* t_poly_prod_iter_ptr = &t_poly_prod[i * coeff_count];
-
-    // Final modular reduction
-    for (size_t k = 0; k < key_component_count; ++k) {
-      for (size_t l = 0; l < coeff_count; ++l) {
-        uint64_t accumulator_idx = 2 * coeff_count * k + 2 * l;
-        uint64_t poly_iter_idx = coeff_count * rns_modulus_size * k + l;
+    // Multiply with keys and accumulate products in a lazy fashion, one tile
+    // of coefficients at a time
+#pragma omp parallel for num_threads(num_threads)
+    for (int64_t tile = 0; tile < num_tiles; ++tile) {
+      size_t l0 = static_cast<size_t>(tile) * tile_size;
+      size_t len = std::min(tile_size, coeff_count - l0);
+      // One accumulator row of tile_size coefficients per key component
+      uint128_t accumulator[kKeySwitchAccumulatorSize];
+
+      for (size_t b = 0; b < batch_size; ++b) {
+        std::fill(accumulator, accumulator + key_component_count * tile_size,
+                  0);
+        for (size_t j = 0; j < decomp_modulus_size; ++j) {
+          const uint64_t* t_operand =
+              (i == j)
+                  ? &t_target_iter_ptrs[b][j * coeff_count + l0]
+                  : &t_ntt_ptr[(b * decomp_modulus_size + j) * coeff_count +
+                               l0];
+          for (size_t k = 0; k < key_component_count; ++k) {
+            const uint64_t* key =
+                &k_switch_keys[j][coeff_count * key_index +
+                                  k * key_modulus_size * coeff_count + l0];
+            uint128_t* acc = &accumulator[k * tile_size];
+            // No reduction used; assume intermediate results don't overflow
+            for (size_t l = 0; l < len; ++l) {
+              acc[l] += MultiplyUInt64(t_operand[l], key[l]);
+            }
+          }
+        }
 
-        t_poly_prod_iter_ptr[poly_iter_idx] = BarrettReduce128(
-            accumulator_ptr[accumulator_idx + 1],
-            accumulator_ptr[accumulator_idx], moduli[key_index]);
+        // Final modular reduction into t_poly_prod, shifted to the
+        // appropriate key component and modulus
+        for (size_t k = 0; k < key_component_count; ++k) {
+          const uint128_t* acc = &accumulator[k * tile_size];
+          uint64_t* t_poly_prod_iter_ptr =
+              &t_poly_prod[b * poly_prod_size +
+                           k * coeff_count * rns_modulus_size +
+                           i * coeff_count + l0];
+          for (size_t l = 0; l < len; ++l) {
+            t_poly_prod_iter_ptr[l] =
+                BarrettReduce128(static_cast<uint64_t>(acc[l] >> 64),
+                                 static_cast<uint64_t>(acc[l]), modulus);
+          }
+        }
       }
     }
   }
 
-  uint64_t* data_array = result;
-  for (size_t key_component = 0; key_component < key_component_count;
-       ++key_component) {
-    uint64_t* t_poly_prod_it =
-        &t_poly_prod[key_component * coeff_count * rns_modulus_size];
-    uint64_t* t_last = &t_poly_prod_it[decomp_modulus_size * coeff_count];
-
-    GetNTT(n, moduli[key_modulus_size - 1])
-        .ComputeInverse(t_last, t_last, 2, 2);
-
-    uint64_t qk = moduli[key_modulus_size - 1];
-    uint64_t qk_half = qk >> 1;
-
-    for (size_t i = 0; i < coeff_count; ++i) {
-      uint64_t barrett_factor =
-          MultiplyFactor(1, 64, moduli[key_modulus_size - 1]).BarrettFactor();
-      t_last[i] = BarrettReduce64(t_last[i] + qk_half,
-                                  moduli[key_modulus_size - 1], barrett_factor);
+  // Divide by the special prime qk and round, then add to the ciphertext
+  const uint64_t* rescale_moduli = workspace.RescaleModuli();
+
+  for (size_t b = 0; b < batch_size; ++b) {
+    for (size_t key_component = 0; key_component < key_component_count;
+         ++key_component) {
+      uint64_t* t_poly_prod_it =
+          &t_poly_prod[b * poly_prod_size +
+                       key_component * coeff_count * rns_modulus_size];
+
+      // Parallel over the decomp_modulus_size output limbs
+      RNSRescale(t_poly_prod_it, t_poly_prod_it, coeff_count,
+                 rns_modulus_size, rescale_moduli, modswitch_factors, true,
+                 static_cast<uint64_t>(num_threads), workspace.Rescale(),
+                 ntts);
     }
+  }
 
-    for (size_t i = 0; i < decomp_modulus_size; ++i) {
-      // (ct mod 4qk) mod qi
-      uint64_t qi = moduli[i];
-
-      // TODO(fboemer): Use input_mod_factor != 0 when qk / qi < 4
-      // TODO(fboemer): Use output_mod_factor == 4?
-      uint64_t input_mod_factor = (qk > qi) ? moduli[i] : 2;
-      if (qk > qi) {
-        intel::hexl::EltwiseReduceMod(t_ntt_ptr, t_last, coeff_count, moduli[i],
-                                      input_mod_factor, 1);
-      } else {
-        for (size_t coeff_idx = 0; coeff_idx < coeff_count; ++coeff_idx) {
-          t_ntt_ptr[coeff_idx] = t_last[coeff_idx];
-        }
-      }
+  const int64_t num_outputs = static_cast<int64_t>(
+      batch_size * key_component_count * decomp_modulus_size);
+#pragma omp parallel for num_threads(num_threads)
+  for (int64_t output = 0; output < num_outputs; ++output) {
+    size_t b = static_cast<size_t>(output) /
+               (key_component_count * decomp_modulus_size);
+    size_t limb = static_cast<size_t>(output) %
+                  (key_component_count * decomp_modulus_size);
+    size_t key_component = limb / decomp_modulus_size;
+    size_t i = limb % decomp_modulus_size;
+    uint64_t* data_ptr =
+        &results[b][coeff_count * (decomp_modulus_size * key_component + i)];
+    EltwiseAddMod(data_ptr, data_ptr,
+                  &t_poly_prod[b * poly_prod_size +
+                               coeff_count *
+                                   (rns_modulus_size * key_component + i)],
+                  coeff_count, moduli[i]);
+  }
+}
 
-      // Lazy subtraction, results in [0, 2*qi), since fix is in [0, qi].
-      uint64_t barrett_factor =
-          MultiplyFactor(1, 64, moduli[i]).BarrettFactor();
-      uint64_t fix = qi - BarrettReduce64(qk_half, moduli[i], barrett_factor);
-      for (size_t l = 0; l < coeff_count; ++l) {
-        t_ntt_ptr[l] += fix;
-      }
+}  // namespace
 
-      uint64_t qi_lazy = qi << 1;  // some multiples of qi
-      GetNTT(n, moduli[i]).ComputeForward(t_ntt_ptr, t_ntt_ptr, 4, 4);
-      // Since SEAL uses at most 60bit moduli, 8*qi < 2^63.
-      qi_lazy = qi << 2;
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               const uint64_t* root_of_unity_powers_ptr) {
+  if (root_of_unity_powers_ptr != nullptr) {
+    throw std::invalid_argument(
+        "Parameter root_of_unity_powers_ptr is not supported; pass NTTs to "
+        "the KeySwitchWorkspace overload instead.");
+  }
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, key_component_count);
+  KeySwitch(result, t_target_iter_ptr, n, decomp_modulus_size,
+            key_modulus_size, rns_modulus_size, key_component_count, moduli,
+            k_switch_keys, modswitch_factors, workspace);
+}
 
-      // ((ct mod qi) - (ct mod qk)) mod qi
-      uint64_t* t_ith_poly = &t_poly_prod_it[i * coeff_count];
-      for (size_t k = 0; k < coeff_count; ++k) {
-        t_ith_poly[k] = t_ith_poly[k] + qi_lazy - t_ntt[k];
-      }
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace, NTT* const* ntts) {
+  KeySwitchBatch(&result, &t_target_iter_ptr, 1, n, decomp_modulus_size,
+                 key_modulus_size, rns_modulus_size, key_component_count,
+                 moduli, k_switch_keys, modswitch_factors, workspace, ntts);
+}
 
-      // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
-      intel::hexl::EltwiseFMAMod(t_ith_poly, t_ith_poly, modswitch_factors[i],
-                                 nullptr, coeff_count, moduli[i], 8);
-      uint64_t data_ptr_offset =
-          coeff_count * (decomp_modulus_size * key_component + i);
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors) {
+  // A workspace needs a batch size of at least one
+  if (batch_size == 0) {
+    return;
+  }
+  KeySwitchWorkspace workspace(
+      n, decomp_modulus_size, key_component_count,
+      std::min(batch_size, kDefaultKeySwitchBatchSize));
+  KeySwitchBatch(results, t_target_iter_ptrs, batch_size, n,
+                 decomp_modulus_size, key_modulus_size, rns_modulus_size,
+                 key_component_count, moduli, k_switch_keys, modswitch_factors,
+                 workspace);
+}
 
-      uint64_t* data_ptr = &data_array[data_ptr_offset];
-      intel::hexl::EltwiseAddMod(data_ptr, data_ptr, t_ith_poly, coeff_count,
-                                 moduli[i]);
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors,
+                    KeySwitchWorkspace& workspace, NTT* const* ntts) {
+  HEXL_CHECK(workspace.Fits(n, decomp_modulus_size, key_component_count),
+             "workspace is too small for the KeySwitch parameters");
+  HEXL_CHECK(rns_modulus_size == decomp_modulus_size + 1,
+             "Require rns_modulus_size == decomp_modulus_size + 1");
+  HEXL_CHECK(key_component_count > 0 &&
+                 key_component_count <= kKeySwitchAccumulatorSize,
+             "Invalid key_component_count " << key_component_count);
+  HEXL_CHECK(batch_size == 0 ||
+                 (results != nullptr && t_target_iter_ptrs != nullptr),
+             "Require non-null results and t_target_iter_ptrs");
+
+  // Resolve the NTT of each RNSRescale modulus once per call. NTTs from the
+  // cache are held by shared pointers, since resolving one may evict another
+  // once the cache capacity is bounded.
+  uint64_t* rescale_moduli = workspace.RescaleModuli();
+  std::copy(moduli, moduli + decomp_modulus_size, rescale_moduli);
+  rescale_moduli[decomp_modulus_size] = moduli[key_modulus_size - 1];
+  NTT** rescale_ntts = workspace.NTTs();
+  std::shared_ptr<NTT>* cached_ntts = workspace.CachedNTTs();
+  for (size_t i = 0; i < rns_modulus_size; ++i) {
+    size_t key_index = (i == decomp_modulus_size ? key_modulus_size - 1 : i);
+    if (ntts != nullptr) {
+      HEXL_CHECK(ntts[key_index] != nullptr &&
+                     ntts[key_index]->GetDegree() == n &&
+                     ntts[key_index]->GetModulus() == moduli[key_index],
+                 "NTT " << key_index << " does not match n and moduli");
+      rescale_ntts[i] = ntts[key_index];
+    } else {
+      cached_ntts[i] = GetNTTShared(n, moduli[key_index]);
+      rescale_ntts[i] = cached_ntts[i].get();
     }
   }
-  return;
+
+  const int num_threads = GetOmpNumThreads(GetKeySwitchNumThreads());
+  for (uint64_t b = 0; b < batch_size; b += workspace.BatchSize()) {
+    KeySwitchBatchTile(results + b, t_target_iter_ptrs + b,
+                       std::min(workspace.BatchSize(), batch_size - b), n,
+                       decomp_modulus_size, key_modulus_size, rns_modulus_size,
+                       key_component_count, moduli, k_switch_keys,
+                       modswitch_factors, workspace, rescale_ntts,
+                       num_threads);
+  }
+
+  // Release the cached NTTs, so evicted ones are not kept alive by the
+  // workspace
+  for (size_t i = 0; i < rns_modulus_size; ++i) {
+    cached_ntts[i].reset();
+  }
 }
 
 }  // namespace internal
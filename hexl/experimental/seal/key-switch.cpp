@@ -22,6 +22,45 @@ void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
       modswitch_factors, root_of_unity_powers_ptr);
 }
 
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace, NTT* const* ntts) {
+  intel::hexl::internal::KeySwitch(
+      result, t_target_iter_ptr, n, decomp_modulus_size, key_modulus_size,
+      rns_modulus_size, key_component_count, moduli, k_switch_keys,
+      modswitch_factors, workspace, ntts);
+}
+
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors) {
+  intel::hexl::internal::KeySwitchBatch(
+      results, t_target_iter_ptrs, batch_size, n, decomp_modulus_size,
+      key_modulus_size, rns_modulus_size, key_component_count, moduli,
+      k_switch_keys, modswitch_factors);
+}
+
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors,
+                    KeySwitchWorkspace& workspace, NTT* const* ntts) {
+  intel::hexl::internal::KeySwitchBatch(
+      results, t_target_iter_ptrs, batch_size, n, decomp_modulus_size,
+      key_modulus_size, rns_modulus_size, key_component_count, moduli,
+      k_switch_keys, modswitch_factors, workspace, ntts);
+}
+
 }  // namespace hexl
 }  // namespace intel
 #endif
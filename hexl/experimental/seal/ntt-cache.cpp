@@ -0,0 +1,237 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/ntt-cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "hexl/experimental/seal/locks.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+using NTTKey = std::pair<uint64_t, uint64_t>;
+
+class NTTCache;
+
+// One thread's view of the cache. Only the owning thread touches ntts; hits
+// is atomic so GetNTTCacheStats can read it from other threads.
+struct LocalNTTCache {
+  LocalNTTCache();
+  ~LocalNTTCache();
+
+  uint64_t generation{~0ULL};
+  std::unordered_map<NTTKey, std::shared_ptr<NTT>, HashPair> ntts;
+  std::atomic<uint64_t> hits{0};
+};
+
+// Process-wide NTT cache. The shared map is only read the first time a
+// thread looks up an NTT; evicting or clearing bumps the generation, which
+// makes every thread drop its local view on its next lookup.
+class NTTCache {
+ public:
+  // Never destroyed, since thread-local views of OpenMP worker threads may
+  // outlive static destruction
+  static NTTCache& Instance() {
+    static NTTCache* cache = new NTTCache;
+    return *cache;
+  }
+
+  std::shared_ptr<NTT>& Lookup(size_t N, uint64_t modulus) {
+    static thread_local LocalNTTCache local;
+
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+      local.ntts.clear();
+      local.generation = generation;
+    }
+
+    NTTKey key{N, modulus};
+    auto ntt_it = local.ntts.find(key);
+    if (ntt_it != local.ntts.end()) {
+      // Only this thread writes its counter, so no atomic increment is needed
+      local.hits.store(local.hits.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+      return ntt_it->second;
+    }
+
+    bool constructed = false;
+    std::shared_ptr<NTT> ntt = Fetch(key, &constructed);
+    (constructed ? m_misses : m_shared_hits)
+        .fetch_add(1, std::memory_order_relaxed);
+    return local.ntts.emplace(key, std::move(ntt)).first->second;
+  }
+
+  // Returns the NTT from the shared map, constructing it if absent
+  std::shared_ptr<NTT> Fetch(const NTTKey& key, bool* constructed) {
+    *constructed = false;
+    {
+      ReadLock reader_lock(m_lock.AcquireRead());
+      auto ntt_it = m_ntts.find(key);
+      if (ntt_it != m_ntts.end()) {
+        return ntt_it->second;
+      }
+    }
+
+    // Construct without holding the lock; if another thread constructs the
+    // same NTT concurrently, the first one inserted wins
+    auto start = std::chrono::steady_clock::now();
+    auto ntt = std::make_shared<NTT>(key.first, key.second);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    m_constructions.fetch_add(1, std::memory_order_relaxed);
+    m_construction_ns.fetch_add(static_cast<uint64_t>(elapsed.count()),
+                                std::memory_order_relaxed);
+    *constructed = true;
+
+    WriteLock write_lock(m_lock.AcquireWrite());
+    auto inserted = m_ntts.emplace(key, std::move(ntt));
+    if (inserted.second) {
+      m_insertion_order.push_back(key);
+      EvictBeyondCapacity();
+    }
+    return inserted.first->second;
+  }
+
+  void SetCapacity(size_t capacity) {
+    WriteLock write_lock(m_lock.AcquireWrite());
+    m_capacity = capacity;
+    EvictBeyondCapacity();
+  }
+
+  size_t Capacity() {
+    ReadLock reader_lock(m_lock.AcquireRead());
+    return m_capacity;
+  }
+
+  void Clear() {
+    WriteLock write_lock(m_lock.AcquireWrite());
+    m_ntts.clear();
+    m_insertion_order.clear();
+    m_generation.fetch_add(1, std::memory_order_release);
+  }
+
+  NTTCacheStats Stats() {
+    NTTCacheStats stats;
+    stats.hits = TotalHits() - m_hits_baseline.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.constructions = m_constructions.load(std::memory_order_relaxed);
+    stats.construction_ns = m_construction_ns.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    ReadLock reader_lock(m_lock.AcquireRead());
+    stats.size = m_ntts.size();
+    return stats;
+  }
+
+  void ResetStats() {
+    m_hits_baseline.store(TotalHits(), std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+    m_constructions.store(0, std::memory_order_relaxed);
+    m_construction_ns.store(0, std::memory_order_relaxed);
+    m_evictions.store(0, std::memory_order_relaxed);
+  }
+
+  void Register(LocalNTTCache* local) {
+    std::lock_guard<std::mutex> guard(m_locals_mutex);
+    m_locals.push_back(local);
+  }
+
+  // Folds the hits of an exiting thread into the retired count
+  void Unregister(LocalNTTCache* local) {
+    std::lock_guard<std::mutex> guard(m_locals_mutex);
+    m_retired_hits += local->hits.load(std::memory_order_relaxed);
+    m_locals.erase(std::find(m_locals.begin(), m_locals.end(), local));
+  }
+
+ private:
+  NTTCache() = default;
+
+  // Evicts the oldest entries beyond the capacity; requires the write lock
+  void EvictBeyondCapacity() {
+    if (m_capacity == 0 || m_ntts.size() <= m_capacity) {
+      return;
+    }
+    while (m_ntts.size() > m_capacity) {
+      m_ntts.erase(m_insertion_order.front());
+      m_insertion_order.pop_front();
+      m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_generation.fetch_add(1, std::memory_order_release);
+  }
+
+  uint64_t TotalHits() {
+    std::lock_guard<std::mutex> guard(m_locals_mutex);
+    uint64_t hits = m_retired_hits +
+                    m_shared_hits.load(std::memory_order_relaxed);
+    for (const LocalNTTCache* local : m_locals) {
+      hits += local->hits.load(std::memory_order_relaxed);
+    }
+    return hits;
+  }
+
+  RWLock m_lock;
+  std::unordered_map<NTTKey, std::shared_ptr<NTT>, HashPair> m_ntts;
+  std::deque<NTTKey> m_insertion_order;
+  size_t m_capacity{0};
+  std::atomic<uint64_t> m_generation{0};
+
+  std::mutex m_locals_mutex;
+  std::vector<LocalNTTCache*> m_locals;
+  uint64_t m_retired_hits{0};
+
+  std::atomic<uint64_t> m_shared_hits{0};
+  std::atomic<uint64_t> m_hits_baseline{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_constructions{0};
+  std::atomic<uint64_t> m_construction_ns{0};
+  std::atomic<uint64_t> m_evictions{0};
+};
+
+LocalNTTCache::LocalNTTCache() { NTTCache::Instance().Register(this); }
+
+LocalNTTCache::~LocalNTTCache() { NTTCache::Instance().Unregister(this); }
+
+}  // namespace
+
+NTT& GetNTT(size_t N, uint64_t modulus) {
+  return *NTTCache::Instance().Lookup(N, modulus);
+}
+
+std::shared_ptr<NTT> GetNTTShared(size_t N, uint64_t modulus) {
+  return NTTCache::Instance().Lookup(N, modulus);
+}
+
+void PrewarmNTTCache(size_t N, const std::vector<uint64_t>& moduli) {
+  NTTCache& cache = NTTCache::Instance();
+  const int64_t num_moduli = static_cast<int64_t>(moduli.size());
+#pragma omp parallel for num_threads(GetOmpNumThreads(0)) if (num_moduli > 1)
+  for (int64_t i = 0; i < num_moduli; ++i) {
+    bool constructed;
+    cache.Fetch(NTTKey{N, moduli[i]}, &constructed);
+  }
+}
+
+void SetNTTCacheCapacity(size_t capacity) {
+  NTTCache::Instance().SetCapacity(capacity);
+}
+
+size_t GetNTTCacheCapacity() { return NTTCache::Instance().Capacity(); }
+
+void ClearNTTCache() { NTTCache::Instance().Clear(); }
+
+NTTCacheStats GetNTTCacheStats() { return NTTCache::Instance().Stats(); }
+
+void ResetNTTCacheStats() { NTTCache::Instance().ResetStats(); }
+
+}  // namespace hexl
+}  // namespace intel
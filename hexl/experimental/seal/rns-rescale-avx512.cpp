@@ -0,0 +1,89 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "experimental/seal/rns-rescale-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "experimental/seal/rns-rescale-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+void EltwiseReduceAddLazyAVX512(uint64_t* result, const uint64_t* operand,
+                                uint64_t n, uint64_t modulus, uint64_t addend) {
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    EltwiseReduceAddLazyNative(result, operand, n_mod_8, modulus, addend);
+    operand += n_mod_8;
+    result += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  // Barrett reduction by floor(2^64 / q) leaves x mod q lazily in [0, 2q)
+  const __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  const __m512i v_barrett = _mm512_set1_epi64(
+      static_cast<int64_t>(MultiplyFactor(1, 64, modulus).BarrettFactor()));
+  const __m512i v_addend = _mm512_set1_epi64(static_cast<int64_t>(addend));
+
+  const __m512i* v_operand = reinterpret_cast<const __m512i*>(operand);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_x = _mm512_loadu_si512(v_operand);
+    __m512i v_q_hat = _mm512_hexl_mulhi_epi<64>(v_x, v_barrett);
+    __m512i v_r =
+        _mm512_sub_epi64(v_x, _mm512_hexl_mullo_epi<64>(v_q_hat, v_modulus));
+    _mm512_storeu_si512(v_result, _mm512_add_epi64(v_r, v_addend));
+    ++v_operand;
+    ++v_result;
+  }
+}
+
+void EltwiseSubScaleModAVX512(uint64_t* result, const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t scale) {
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    EltwiseSubScaleModNative(result, operand1, operand2, n_mod_8, modulus,
+                             scale);
+    operand1 += n_mod_8;
+    operand2 += n_mod_8;
+    result += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  const __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(2 * modulus));
+  const __m512i v_scale = _mm512_set1_epi64(static_cast<int64_t>(scale));
+  const __m512i v_scale_precon = _mm512_set1_epi64(
+      static_cast<int64_t>(MultiplyFactor(scale, 64, modulus).BarrettFactor()));
+
+  const __m512i* v_operand1 = reinterpret_cast<const __m512i*>(operand1);
+  const __m512i* v_operand2 = reinterpret_cast<const __m512i*>(operand2);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_x = _mm512_loadu_si512(v_operand1);
+    __m512i v_y = _mm512_loadu_si512(v_operand2);
+    v_y = _mm512_hexl_small_mod_epu64<4>(v_y, v_modulus, &v_twice_mod);
+
+    // d = x + q - y in (0, 2q); Shoup multiplication keeps d * scale lazily
+    // in [0, 2q)
+    __m512i v_d = _mm512_sub_epi64(_mm512_add_epi64(v_x, v_modulus), v_y);
+    __m512i v_q_hat = _mm512_hexl_mulhi_epi<64>(v_d, v_scale_precon);
+    __m512i v_r =
+        _mm512_sub_epi64(_mm512_hexl_mullo_epi<64>(v_d, v_scale),
+                         _mm512_hexl_mullo_epi<64>(v_q_hat, v_modulus));
+    _mm512_storeu_si512(v_result, _mm512_hexl_small_mod_epu64(v_r, v_modulus));
+    ++v_operand1;
+    ++v_operand2;
+    ++v_result;
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,23 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512 implementation of EltwiseReduceAddLazyNative
+void EltwiseReduceAddLazyAVX512(uint64_t* result, const uint64_t* operand,
+                                uint64_t n, uint64_t modulus, uint64_t addend);
+
+/// @brief AVX512 implementation of EltwiseSubScaleModNative
+void EltwiseSubScaleModAVX512(uint64_t* result, const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t scale);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
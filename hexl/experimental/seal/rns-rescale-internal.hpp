@@ -0,0 +1,34 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes result = (operand mod modulus) + addend, lazily, in
+/// [0, 4 * modulus), using scalar arithmetic
+/// @param[out] result Stores the result. May alias \p operand.
+/// @param[in] operand Vector of n elements, each less than 2^64
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus, less than 2^62
+/// @param[in] addend Scalar in [0, 2 * modulus)
+void EltwiseReduceAddLazyNative(uint64_t* result, const uint64_t* operand,
+                                uint64_t n, uint64_t modulus, uint64_t addend);
+
+/// @brief Computes result = (operand1 - operand2) * scale mod modulus, using
+/// scalar arithmetic
+/// @param[out] result Stores the result. May alias either operand.
+/// @param[in] operand1 Vector of n elements in [0, modulus)
+/// @param[in] operand2 Vector of n elements in [0, 4 * modulus)
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus, less than 2^62
+/// @param[in] scale Scalar in [0, modulus)
+void EltwiseSubScaleModNative(uint64_t* result, const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t scale);
+
+}  // namespace hexl
+}  // namespace intel
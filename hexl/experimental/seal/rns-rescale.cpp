@@ -0,0 +1,135 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/rns-rescale.hpp"
+
+#include <algorithm>
+
+#include "experimental/seal/rns-rescale-avx512.hpp"
+#include "experimental/seal/rns-rescale-internal.hpp"
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/experimental/seal/ntt-cache.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+void EltwiseReduceAddLazy(uint64_t* result, const uint64_t* operand,
+                          uint64_t n, uint64_t modulus, uint64_t addend) {
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling EltwiseReduceAddLazyAVX512");
+    EltwiseReduceAddLazyAVX512(result, operand, n, modulus, addend);
+    return;
+  }
+#endif
+  HEXL_VLOG(3, "Calling EltwiseReduceAddLazyNative");
+  EltwiseReduceAddLazyNative(result, operand, n, modulus, addend);
+}
+
+void EltwiseSubScaleMod(uint64_t* result, const uint64_t* operand1,
+                        const uint64_t* operand2, uint64_t n, uint64_t modulus,
+                        uint64_t scale) {
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq) {
+    HEXL_VLOG(3, "Calling EltwiseSubScaleModAVX512");
+    EltwiseSubScaleModAVX512(result, operand1, operand2, n, modulus, scale);
+    return;
+  }
+#endif
+  HEXL_VLOG(3, "Calling EltwiseSubScaleModNative");
+  EltwiseSubScaleModNative(result, operand1, operand2, n, modulus, scale);
+}
+
+}  // namespace
+
+void RNSRescale(uint64_t* result, const uint64_t* operand, uint64_t n,
+                uint64_t num_moduli, const uint64_t* moduli,
+                const uint64_t* inv_qk_mod_qi, bool ntt_form,
+                uint64_t num_threads, uint64_t* scratch,
+                NTT* const* ntts) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(inv_qk_mod_qi != nullptr, "Require inv_qk_mod_qi != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(num_moduli >= 2, "Require num_moduli >= 2");
+
+  const uint64_t qk = moduli[num_moduli - 1];
+  const uint64_t qk_half = qk >> 1;
+  const uint64_t num_out_moduli = num_moduli - 1;
+
+  AlignedVector64<uint64_t> owned_scratch;
+  if (scratch == nullptr) {
+    owned_scratch.resize(n * num_moduli);
+    scratch = owned_scratch.data();
+  }
+
+  // (x mod qk) + qk/2, in coefficient form. Adding qk/2 before flooring turns
+  // the division by qk into a rounding.
+  uint64_t* t_last = scratch;
+  std::copy(operand + num_out_moduli * n, operand + num_moduli * n, t_last);
+  if (ntt_form) {
+    NTT& ntt = (ntts != nullptr) ? *ntts[num_out_moduli] : GetNTT(n, qk);
+    ntt.ComputeInverse(t_last, t_last, 1, 1);
+  }
+  EltwiseAddMod(t_last, t_last, qk_half, n, qk);
+
+  // Each output limb depends only on t_last and its own input limb
+  const int64_t num_limbs = static_cast<int64_t>(num_out_moduli);
+#pragma omp parallel for num_threads(GetOmpNumThreads(num_threads)) \
+    if (num_limbs > 1)
+  for (int64_t i = 0; i < num_limbs; ++i) {
+    const uint64_t qi = moduli[i];
+    const uint64_t* operand_i = operand + i * n;
+    uint64_t* result_i = result + i * n;
+
+    // ((x mod qk) + qk/2 - qk/2) mod qi, lazily in [0, 4qi)
+    uint64_t* t_qi = scratch + (i + 1) * n;
+    EltwiseReduceAddLazy(t_qi, t_last, n, qi, qi - qk_half % qi);
+    if (ntt_form) {
+      NTT& ntt = (ntts != nullptr) ? *ntts[i] : GetNTT(n, qi);
+      ntt.ComputeForward(t_qi, t_qi, 4, 4);
+    }
+
+    // qk^{-1} * ((x mod qi) - (x mod qk)) mod qi
+    EltwiseSubScaleMod(result_i, operand_i, t_qi, n, qi, inv_qk_mod_qi[i]);
+  }
+}
+
+void EltwiseReduceAddLazyNative(uint64_t* result, const uint64_t* operand,
+                                uint64_t n, uint64_t modulus, uint64_t addend) {
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < 2^62");
+  HEXL_CHECK(addend < 2 * modulus, "Require addend < 2 * modulus");
+  // Barrett reduction by floor(2^64 / q) leaves x mod q lazily in [0, 2q)
+  uint64_t barrett_factor = MultiplyFactor(1, 64, modulus).BarrettFactor();
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t q_hat = MultiplyUInt64Hi<64>(operand[i], barrett_factor);
+    result[i] = operand[i] - q_hat * modulus + addend;
+  }
+}
+
+void EltwiseSubScaleModNative(uint64_t* result, const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t scale) {
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < 2^62");
+  HEXL_CHECK(scale < modulus, "Require scale < modulus");
+  uint64_t scale_precon = MultiplyFactor(scale, 64, modulus).BarrettFactor();
+  uint64_t twice_modulus = 2 * modulus;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t y = ReduceMod<4>(operand2[i], modulus, &twice_modulus);
+    uint64_t d = operand1[i] + modulus - y;
+    result[i] = ReduceMod<2>(
+        MultiplyModLazy<64>(d, scale, scale_precon, modulus), modulus);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
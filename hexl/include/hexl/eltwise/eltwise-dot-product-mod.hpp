@@ -0,0 +1,48 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes the modular dot product sum_i (\p operand1[i] * \p
+/// operand2[i]) mod \p modulus
+/// @param[in] operand1 Vector of elements to multiply
+/// @param[in] operand2 Vector of elements to multiply
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus with which to perform modular reduction. Must be
+/// in the range \f$ [2, 2^{62} - 1]\f$, with input_mod_factor * modulus <
+/// 2^63, i.e. modulus < 2^61 when input_mod_factor is 4
+/// @param[in] input_mod_factor Assumes input elements are in [0,
+/// input_mod_factor * modulus). Must be 1, 2 or 4.
+/// @return The dot product, in [0, modulus)
+/// @details Products are accumulated lazily in 128-bit precision; a single
+/// modular reduction is performed at the end.
+uint64_t EltwiseDotProductMod(const uint64_t* operand1,
+                              const uint64_t* operand2, uint64_t n,
+                              uint64_t modulus, uint64_t input_mod_factor);
+
+/// @brief Computes the modular dot product of each RNS limb of \p operand1
+/// and \p operand2
+/// @param[out] result Stores the num_moduli dot products; result[i] is
+/// computed modulo moduli[i]
+/// @param[in] operand1 Vector of n * num_moduli elements, stored as
+/// num_moduli contiguous limbs of n elements each
+/// @param[in] operand2 Vector of n * num_moduli elements, stored as
+/// num_moduli contiguous limbs of n elements each
+/// @param[in] n Number of elements in each limb
+/// @param[in] moduli Pointer to num_moduli moduli
+/// @param[in] num_moduli Number of moduli
+/// @param[in] input_mod_factor Assumes elements of limb i are in [0,
+/// input_mod_factor * moduli[i]). Must be 1, 2 or 4, with input_mod_factor *
+/// moduli[i] < 2^63.
+void EltwiseDotProductMod(uint64_t* result, const uint64_t* operand1,
+                          const uint64_t* operand2, uint64_t n,
+                          const uint64_t* moduli, uint64_t num_moduli,
+                          uint64_t input_mod_factor);
+
+}  // namespace hexl
+}  // namespace intel
@@ -8,6 +8,33 @@
 namespace intel {
 namespace hexl {
 
+/// @enum EltwiseMultModAlgorithm
+/// @brief Kernel used by EltwiseMultMod
+enum class EltwiseMultModAlgorithm {
+  /// Fastest supported kernel; for moduli below 2^50 the choice among the
+  /// AVX512 kernels is measured once, on first use outside an OpenMP
+  /// parallel region. Until then kAVX512Float is preferred.
+  kAuto,
+  kNative,       ///< Portable scalar kernel
+  kAVX512Float,  ///< Floating-point kernel; requires AVX512DQ, modulus < 2^50
+  kAVX512IFMA,   ///< Barrett kernel; requires AVX512IFMA, modulus < 2^50
+  kAVX512DQInt   ///< Barrett kernel; requires AVX512DQ, modulus >= 2^50
+};
+
+/// @brief Selects the kernel used by subsequent calls to EltwiseMultMod.
+/// @param[in] algorithm Kernel to use. Calls for which the kernel is not
+/// supported, see IsEltwiseMultModAlgorithmSupported, fall back to kAuto.
+/// @details Thread-safe; the default is kAuto
+void SetEltwiseMultModAlgorithm(EltwiseMultModAlgorithm algorithm);
+
+/// @brief Returns the kernel selected by SetEltwiseMultModAlgorithm
+EltwiseMultModAlgorithm GetEltwiseMultModAlgorithm();
+
+/// @brief Returns whether or not \p algorithm can run on this machine with
+/// the given modulus
+bool IsEltwiseMultModAlgorithmSupported(EltwiseMultModAlgorithm algorithm,
+                                        uint64_t modulus);
+
 /// @brief Multiplies two vectors elementwise with modular reduction
 /// @param[in] result Result of element-wise multiplication
 /// @param[in] operand1 Vector of elements to multiply. Each element must be
@@ -19,7 +46,8 @@ namespace hexl {
 /// @param[in] input_mod_factor Assumes input elements are in [0,
 /// input_mod_factor * p) Must be 1, 2 or 4.
 /// @details Computes \p result[i] = (\p operand1[i] * \p operand2[i]) mod \p
-/// modulus for i=0, ..., \p n - 1
+/// modulus for i=0, ..., \p n - 1, using the kernel chosen by
+/// SetEltwiseMultModAlgorithm
 void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n, uint64_t modulus,
                     uint64_t input_mod_factor);
@@ -0,0 +1,38 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes the modular sum sum_i \p operand[i] mod \p modulus
+/// @param[in] operand Vector of elements to sum
+/// @param[in] n Number of elements in the vector
+/// @param[in] modulus Modulus with which to perform modular reduction. Must be
+/// in the range \f$ [2, 2^{62} - 1]\f$
+/// @param[in] input_mod_factor Assumes input elements are in [0,
+/// input_mod_factor * modulus). Must be 1, 2 or 4. Since elements are only
+/// added, any modulus in the range above is supported for each factor.
+/// @return The sum, in [0, modulus)
+uint64_t EltwiseSumMod(const uint64_t* operand, uint64_t n, uint64_t modulus,
+                       uint64_t input_mod_factor);
+
+/// @brief Computes the modular sum of each RNS limb of \p operand
+/// @param[out] result Stores the num_moduli sums; result[i] is computed
+/// modulo moduli[i]
+/// @param[in] operand Vector of n * num_moduli elements, stored as num_moduli
+/// contiguous limbs of n elements each
+/// @param[in] n Number of elements in each limb
+/// @param[in] moduli Pointer to num_moduli moduli
+/// @param[in] num_moduli Number of moduli
+/// @param[in] input_mod_factor Assumes elements of limb i are in [0,
+/// input_mod_factor * moduli[i]). Must be 1, 2 or 4.
+void EltwiseSumMod(uint64_t* result, const uint64_t* operand, uint64_t n,
+                   const uint64_t* moduli, uint64_t num_moduli,
+                   uint64_t input_mod_factor);
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,64 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <complex>
+
+#include "hexl/experimental/fft-like/fft-like.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Encodes complex values into a CKKS plaintext in NTT form
+/// @param[out] result Plaintext with n * num_moduli elements. Limb k holds the
+/// NTT of the coefficients modulo moduli[k].
+/// @param[in] values n complex values in the order expected by
+/// FFTLike::ComputeInverseFFTLike, e.g. the slots and their conjugates after
+/// SEAL's index map
+/// @param[in] fft_like FFTLike of degree n
+/// @param[in] scale CKKS scale. The coefficients are the real parts of the
+/// inverse FFT like of \p values times scale / n, rounded to the nearest
+/// integer, half away from zero.
+/// @param[in] moduli Pointer to num_moduli NTT-friendly moduli for degree n
+/// @param[in] num_moduli Number of moduli
+/// @details Fuses the scaling, rounding and reduction modulo every modulus
+/// into the final inverse FFT like stage, so the complex intermediate is never
+/// written back to memory. The forward NTTs use the NTTs from GetNTT.
+void EncodeCKKS(uint64_t* result, const std::complex<double>* values,
+                const FFTLike& fft_like, double scale, const uint64_t* moduli,
+                uint64_t num_moduli);
+
+/// @brief Decodes a CKKS plaintext in NTT form into complex values
+/// @param[out] result n complex values in the order returned by
+/// FFTLike::ComputeForwardFFTLike
+/// @param[in] operand Plaintext with n * num_moduli elements. Limb k holds the
+/// NTT of the coefficients modulo moduli[k].
+/// @param[in] fft_like FFTLike of degree n
+/// @param[in] scale CKKS scale. The coefficients are composed modulo the
+/// product Q of the moduli, centered as by FFTLike::BuildFloatingPoints and
+/// divided by scale before the forward FFT like.
+/// @param[in] moduli Pointer to num_moduli NTT-friendly moduli for degree n
+/// @param[in] num_moduli Number of moduli
+/// @details After the inverse NTTs, the composition, centering and scaling
+/// are fused into the first forward FFT like stage, a block of coefficients
+/// at a time, so the composed integers are never written back to memory. For
+/// n >= 2^15, the limbs and the blocks are processed on up to
+/// GetDecodeCKKSNumThreads() threads.
+void DecodeCKKS(std::complex<double>* result, const uint64_t* operand,
+                const FFTLike& fft_like, double scale, const uint64_t* moduli,
+                uint64_t num_moduli);
+
+/// @brief Sets the maximum number of threads used by DecodeCKKS.
+/// @param[in] num_threads Thread count; 0 uses the OpenMP default and 1 runs
+/// serially. Has no effect when built without OpenMP.
+void SetDecodeCKKSNumThreads(uint64_t num_threads);
+
+/// @brief Returns the thread count set by SetDecodeCKKSNumThreads; 0 by
+/// default
+uint64_t GetDecodeCKKSNumThreads();
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,76 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief Construct floating-point values from CRT-composed polynomial with
+/// integer coefficients in AVX2.
+/// @param[out] res_cmplx_intrlvd Stores the result
+/// @param[in] plain Plaintext
+/// @param[in] threshold Upper half threshold with respect to the total
+/// coefficient modulus
+/// @param[in] decryption_modulus Product of all primes in the coefficient
+/// modulus
+/// @param[in] inv_scale Scale applied to output values
+/// @param[in] mod_size Size of coefficient modulus parameter
+/// @param[in] coeff_count Degree of the polynomial modulus parameter
+/// @details Results match BuildFloatingPointsAVX512 exactly.
+void BuildFloatingPointsAVX2(double* res_cmplx_intrlvd, const uint64_t* plain,
+                             const uint64_t* threshold,
+                             const uint64_t* decryption_modulus,
+                             const double inv_scale, const size_t mod_size,
+                             const size_t coeff_count);
+
+/// @brief Single precision AVX2 implementation of the forward FFT like
+/// @param[out] result_cmplx_intrlvd Output data. Overwritten with FFT like
+/// output. Result is a vector of float with interleaved real and imaginary
+/// numbers.
+/// @param[in] operand_cmplx_intrlvd Input data. A vector of float with
+/// interleaved real and imaginary numbers.
+/// @param[in] roots_of_unity_cmplx_intrlvd Powers of 2n'th root of unity,
+/// rounded to single precision. In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 8.
+/// @param[in] scale Scale applied to output values
+/// @param[in] skip_final_stage If true, stops before the final stage; \p scale
+/// is then unused. See Forward_FFTLike_ToBitReverseFloat.
+/// @details Breadth-first radix-2 transform on 4 complex values per register.
+/// Results agree with Forward_FFTLike_ToBitReverseFloat up to rounding, with
+/// the same bound.
+void Forward_FFTLike_ToBitReverseFloatAVX2(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+/// @brief Single precision AVX2 implementation of the inverse FFT like
+/// @param[out] result_cmplx_intrlvd Output data. Overwritten with FFT like
+/// output. Result is a vector of float with interleaved real and imaginary
+/// numbers.
+/// @param[in] operand_cmplx_intrlvd Input data. A vector of float with
+/// interleaved real and imaginary numbers.
+/// @param[in] inv_roots_of_unity_cmplx_intrlvd Powers of inverse 2n'th root of
+/// unity, rounded to single precision. In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 8.
+/// @param[in] scale Scale applied to output values
+/// @param[in] skip_final_stage If true, stops before the final stage; \p scale
+/// is then unused. See Inverse_FFTLike_FromBitReverseFloat.
+/// @details Results agree with Inverse_FFTLike_FromBitReverseFloat up to
+/// rounding, with the same bound.
+void Inverse_FFTLike_FromBitReverseFloatAVX2(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -396,6 +396,36 @@ inline void ComplexWriteInvInterleavedT8(__m512d* v_X_real, __m512d* v_X_imag,
   _mm512_storeu_pd(v_Y_pt++, v_Y1);
   _mm512_storeu_pd(v_Y_pt, v_Y2);
 }
+
+// ********************************* Radix-4 **********************************
+
+// ComplexMultiply:
+// Multiplies the 8 complex numbers (*real, *imag) by (W_real, W_imag) in place
+inline void ComplexMultiply(__m512d* real, __m512d* imag, __m512d W_real,
+                            __m512d W_imag) {
+  // (a + ib)*(w_a + iw_b) = (a*w_a - b*w_b) + i(a*w_b + b*w_a)
+  __m512d out_real = _mm512_mul_pd(*real, W_real);
+  __m512d tmp = _mm512_mul_pd(*imag, W_imag);
+  out_real = _mm512_sub_pd(out_real, tmp);
+
+  __m512d out_imag = _mm512_mul_pd(*real, W_imag);
+  tmp = _mm512_mul_pd(*imag, W_real);
+  *imag = _mm512_add_pd(out_imag, tmp);
+  *real = out_real;
+}
+
+// ********************************* Threads **********************************
+
+// GetColumnSpan:
+// Splits the columns [0, length) of a pass into num_spans contiguous spans
+// and returns the bounds of span `span`. Bounds are multiples of 16, i.e. of
+// 8 complex values, so each span holds whole SIMD butterflies.
+inline void GetColumnSpan(uint64_t length, uint64_t num_spans, uint64_t span,
+                          uint64_t* begin, uint64_t* end) {
+  const uint64_t steps = length / 16;
+  *begin = (steps * span / num_spans) * 16;
+  *end = (steps * (span + 1) / num_spans) * 16;
+}
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
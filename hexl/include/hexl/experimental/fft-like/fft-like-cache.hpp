@@ -0,0 +1,42 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Returns the cached FFTLike of degree \p degree, constructing it on
+/// first use
+/// @param[in] degree Size of the FFT like transform. Must be a power of 2
+/// @details Lookups take a shared lock; a new FFTLike is constructed without
+/// holding the cache lock. The transforms are const, so one FFTLike may be
+/// used from several threads at once.
+/// @return A reference which stays valid until ClearFFTLikeCache. Use
+/// GetFFTLikeShared to keep an FFTLike alive independently of the cache.
+const FFTLike& GetFFTLike(uint64_t degree);
+
+/// @brief Returns the cached FFTLike of degree \p degree, constructing it on
+/// first use, as a shared pointer which keeps it alive after
+/// ClearFFTLikeCache
+std::shared_ptr<const FFTLike> GetFFTLikeShared(uint64_t degree);
+
+/// @brief Constructs and caches the FFTLike of each of the \p degrees, so
+/// later GetFFTLike calls do not pay the construction cost
+void PrewarmFFTLikeCache(const std::vector<uint64_t>& degrees);
+
+/// @brief Removes every FFTLike from the cache
+void ClearFFTLikeCache();
+
+/// @brief Returns the number of cached FFTLike objects
+size_t GetFFTLikeCacheSize();
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,105 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+/// @brief Single precision AVX512 implementation of the forward FFT like
+/// @param[out] result_cmplx_intrlvd Output data. Overwritten with FFT like
+/// output. Result is a vector of float with interleaved real and imaginary
+/// numbers.
+/// @param[in] operand_cmplx_intrlvd Input data. A vector of float with
+/// interleaved real and imaginary numbers.
+/// @param[in] roots_of_unity_cmplx_intrlvd Powers of 2n'th root of unity,
+/// rounded to single precision. In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 32.
+/// @param[in] scale Scale applied to output values
+/// @param[in] skip_final_stage If true, stops before the final stage; \p scale
+/// is then unused. See Forward_FFTLike_ToBitReverseFloat.
+/// @details Works on 8 complex values per register. The stages with butterfly
+/// distance at least 16 run in radix-4 passes, and the four stages with
+/// distance 8 down to 1 in a single pass, which shuffles each pair of
+/// registers into the X and Y inputs of 8 butterflies. Results agree with
+/// Forward_FFTLike_ToBitReverseFloat up to rounding, with the same bound.
+void Forward_FFTLike_ToBitReverseFloatAVX512(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+/// @brief Single precision AVX512 implementation of the inverse FFT like
+/// @param[out] result_cmplx_intrlvd Output data. Overwritten with FFT like
+/// output. Result is a vector of float with interleaved real and imaginary
+/// numbers.
+/// @param[in] operand_cmplx_intrlvd Input data. A vector of float with
+/// interleaved real and imaginary numbers.
+/// @param[in] inv_roots_of_unity_cmplx_intrlvd Powers of inverse 2n'th root of
+/// unity, rounded to single precision. In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 32.
+/// @param[in] scale Scale applied to output values
+/// @param[in] skip_final_stage If true, stops before the final stage; \p scale
+/// is then unused. See Inverse_FFTLike_FromBitReverseFloat.
+/// @details Same structure as Forward_FFTLike_ToBitReverseFloatAVX512, with
+/// the single pass first. Results agree with
+/// Inverse_FFTLike_FromBitReverseFloat up to rounding.
+void Inverse_FFTLike_FromBitReverseFloatAVX512(
+    float* result_cmplx_intrlvd, const float* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+/// @brief Mixed precision AVX512 implementation of the forward FFT like
+/// @param[out] result_cmplx_intrlvd Output data, as double with interleaved
+/// real and imaginary numbers.
+/// @param[in] operand_cmplx_intrlvd Input data, as double with interleaved
+/// real and imaginary numbers. Rounded to float on load.
+/// @param[in] roots_of_unity_cmplx_intrlvd Powers of 2n'th root of unity,
+/// rounded to single precision. In bit-reversed order.
+/// @param[in] roots_of_unity_double_cmplx_intrlvd Powers of 2n'th root of
+/// unity in double precision. In bit-reversed order.
+/// @param[in] n Size of the transform. Must be a power of two, at least 32.
+/// @param[in] scale Scale applied to output values, in double precision
+/// @param[out] buffer_cmplx_intrlvd Scratch space for 2 * n floats
+/// @details Runs the stages of Forward_FFTLike_ToBitReverseFloatAVX512 on the
+/// buffer, except for the final one which is computed in double precision in
+/// the same pass as the three stages before it. Results agree with
+/// Forward_FFTLike_ToBitReverseFloat followed by
+/// Forward_FFTLike_FinalStageMixed up to rounding.
+void Forward_FFTLike_ToBitReverseMixedAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const float* roots_of_unity_cmplx_intrlvd,
+    const double* roots_of_unity_double_cmplx_intrlvd, const uint64_t n,
+    const double* scale, float* buffer_cmplx_intrlvd);
+
+/// @brief Mixed precision AVX512 implementation of the inverse FFT like
+/// @param[out] result_cmplx_intrlvd Output data, as double with interleaved
+/// real and imaginary numbers.
+/// @param[in] operand_cmplx_intrlvd Input data, as double with interleaved
+/// real and imaginary numbers. Rounded to float on load.
+/// @param[in] inv_roots_of_unity_cmplx_intrlvd Powers of inverse 2n'th root of
+/// unity, rounded to single precision. In bit-reversed order.
+/// @param[in] inv_roots_of_unity_double_cmplx_intrlvd Powers of inverse 2n'th
+/// root of unity in double precision. In bit-reversed order.
+/// @param[in] n Size of the transform. Must be a power of two, at least 32.
+/// @param[in] scale Scale applied to output values, in double precision
+/// @param[out] buffer_cmplx_intrlvd Scratch space for 2 * n floats
+/// @details Runs the stages of Inverse_FFTLike_FromBitReverseFloatAVX512 on
+/// the buffer, except for the final one which is computed in double
+/// precision. Results agree with Inverse_FFTLike_FromBitReverseFloat followed
+/// by Inverse_FFTLike_FinalStageMixed up to rounding.
+void Inverse_FFTLike_FromBitReverseMixedAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const float* inv_roots_of_unity_cmplx_intrlvd,
+    const double* inv_roots_of_unity_double_cmplx_intrlvd, const uint64_t n,
+    const double* scale, float* buffer_cmplx_intrlvd);
+
+#endif  // HEXL_HAS_AVX512DQ
+
+}  // namespace hexl
+}  // namespace intel
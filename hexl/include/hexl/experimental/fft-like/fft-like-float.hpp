@@ -0,0 +1,123 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <complex>
+#include <memory>
+
+#include "hexl/experimental/fft-like/fft-like.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/allocator.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Single precision and mixed precision variants of the FFTLike
+/// transforms, for CKKS workloads which need about 20 bits of precision.
+/// @details The single precision transforms run every stage in float, with
+/// twice as many values per SIMD register as FFTLike. The mixed precision
+/// transforms take and return double values, run every stage but the final
+/// one in float and the final one, which applies the scale, in double. With
+/// inputs and roots of unity rounded to float, the result of either variant
+/// differs from the exact transform by at most a small multiple of
+/// log2(N) * 2^-24 times the sum of the absolute input values, times the scale
+/// if given. The rounding errors of the stages are largely uncorrelated, so
+/// the typical error is far below this bound: about 2^-24 * sqrt(log2(N))
+/// times the root mean square of the output values.
+/// Like FFTLike, the transforms are const and may be used by several threads
+/// at once.
+class FFTLikeFloat {
+ public:
+  /// @brief Initializes an empty FFTLikeFloat object
+  FFTLikeFloat() = default;
+
+  /// @brief Initializes an FFTLikeFloat object with degree \p degree.
+  /// @param[in] degree also known as N. Size of the FFT like transform. Must be
+  /// a power of 2, greater than 8
+  /// @param[in] alloc_ptr Custom memory allocator used for the roots of unity
+  /// and the intermediate values of the mixed precision transforms
+  explicit FFTLikeFloat(uint64_t degree,
+                        std::shared_ptr<AllocatorBase> alloc_ptr = {});
+
+  /// @brief Compute forward FFT like in single precision. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the result
+  /// @param[in] operand Data on which to compute the FFT like
+  /// @param[in] in_scale Scale applied to output values, or nullptr
+  void ComputeForwardFFTLike(std::complex<float>* result,
+                             const std::complex<float>* operand,
+                             const float* in_scale = nullptr) const;
+
+  /// @brief Compute inverse FFT like in single precision. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the result
+  /// @param[in] operand Data on which to compute the FFT like
+  /// @param[in] in_scale Scale applied to output values, or nullptr
+  void ComputeInverseFFTLike(std::complex<float>* result,
+                             const std::complex<float>* operand,
+                             const float* in_scale = nullptr) const;
+
+  /// @brief Compute forward FFT like in mixed precision. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the result
+  /// @param[in] operand Data on which to compute the FFT like. Rounded to
+  /// float.
+  /// @param[in] in_scale Scale applied to output values in double precision,
+  /// or nullptr
+  void ComputeForwardFFTLikeMixed(std::complex<double>* result,
+                                  const std::complex<double>* operand,
+                                  const double* in_scale = nullptr) const;
+
+  /// @brief Compute inverse FFT like in mixed precision. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the result
+  /// @param[in] operand Data on which to compute the FFT like. Rounded to
+  /// float.
+  /// @param[in] in_scale Scale applied to output values in double precision,
+  /// or nullptr
+  void ComputeInverseFFTLikeMixed(std::complex<double>* result,
+                                  const std::complex<double>* operand,
+                                  const double* in_scale = nullptr) const;
+
+  /// @brief Returns the root of unity in bit-reversed order, rounded to float
+  const AlignedVector64<std::complex<float>>& GetComplexRootsOfUnity() const {
+    return m_complex_roots_of_unity;
+  }
+
+  /// @brief Returns the inverse root of unity in bit-reversed order, rounded
+  /// to float
+  const AlignedVector64<std::complex<float>>& GetInvComplexRootsOfUnity()
+      const {
+    return m_inv_complex_roots_of_unity;
+  }
+
+  /// @brief Returns the degree N
+  uint64_t GetDegree() const { return m_fft_like.GetDegree(); }
+
+ private:
+  // Runs the single precision stages, skipping the final one if
+  // skip_final_stage is true
+  void ForwardFloat(std::complex<float>* result,
+                    const std::complex<float>* operand, const float* in_scale,
+                    bool skip_final_stage) const;
+
+  void InverseFloat(std::complex<float>* result,
+                    const std::complex<float>* operand, const float* in_scale,
+                    bool skip_final_stage) const;
+
+  // Provides the double precision roots of unity for the mixed transforms
+  FFTLike m_fft_like;
+
+  AlignedAllocator<std::complex<float>, 64> m_aligned_alloc;
+
+  // Contains 0~(n-1)-th powers of the 2n-th primitive root, rounded to float
+  AlignedVector64<std::complex<float>> m_complex_roots_of_unity;
+
+  // Contains 0~(n-1)-th inv powers of the 2n-th primitive inv root, rounded
+  // to float
+  AlignedVector64<std::complex<float>> m_inv_complex_roots_of_unity;
+};
+
+}  // namespace hexl
+}  // namespace intel
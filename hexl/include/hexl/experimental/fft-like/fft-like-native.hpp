@@ -34,5 +34,206 @@ void Inverse_FFTLike_FromBitReverseRadix2(
     const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
     const double* scale = nullptr);
 
+/// @brief Radix-4 native C++ FFT like implementation of the forward FFT like
+/// @param[out] result Output data. Overwritten with FFT like output
+/// @param[in] operand Input data.
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity. In
+/// bit-reversed order
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+/// @details Merges pairs of radix-2 stages into one pass over the data, with
+/// three complex multiplications per four values instead of four. When log2(n)
+/// is odd the first stage stays radix-2. Results agree with
+/// Forward_FFTLike_ToBitReverseRadix2 up to rounding: the difference is a
+/// small multiple of log2(n) * 2^-53 times the sum of the absolute input
+/// values, times scale if given.
+void Forward_FFTLike_ToBitReverseRadix4(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scale = nullptr);
+
+/// @brief Radix-4 native C++ FFT like implementation of the inverse FFT like
+/// @param[out] result Output data. Overwritten with FFT like output
+/// @param[in] operand Input data.
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity.
+/// In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+/// @details Merges pairs of radix-2 stages into one pass over the data, with
+/// three complex multiplications per four values instead of four. When log2(n)
+/// is odd the first stage stays radix-2. Results agree with
+/// Inverse_FFTLike_FromBitReverseRadix2 up to rounding, with the same bound as
+/// Forward_FFTLike_ToBitReverseRadix4.
+void Inverse_FFTLike_FromBitReverseRadix4(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const double* scale = nullptr);
+
+/// @brief Native C++ forward FFT like that returns the n / 2 CKKS slots in
+/// rotation group order
+/// @param[out] slots Output data of n / 2 elements. Slot i is the output of
+/// Forward_FFTLike_ToBitReverseRadix2 at the bit-reversed position of
+/// (5^i mod 2n - 1) / 2.
+/// @param[in] operand Input data of n elements
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity. In
+/// bit-reversed order
+/// @param[in] slot_positions The bit-reversed position of each slot, as given
+/// by FFTLike::GetSlotPositions
+/// @param[in] n Size of the transform. Must be a power of two, at least 16.
+/// @param[in] scale Scale applied to output data
+/// @param[out] buffer Scratch space for n / 2 elements
+/// @details The slots are the first half of the bit-reversed outputs, so only
+/// the first half of the first stage and the sub-transform below it are
+/// computed. The slots are then gathered from the buffer.
+void Forward_FFTLike_ToSlots(std::complex<double>* slots,
+                             const std::complex<double>* operand,
+                             const std::complex<double>* root_of_unity_powers,
+                             const uint64_t* slot_positions, const uint64_t n,
+                             const double* scale,
+                             std::complex<double>* buffer);
+
+/// @brief Native C++ inverse FFT like of the n / 2 CKKS slots in rotation
+/// group order and their conjugates
+/// @param[out] result Output data of n elements, with zero imaginary parts
+/// @param[in] slots Input data of n / 2 elements. Must not overlap \p result.
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity.
+/// In bit-reversed order.
+/// @param[in] slot_index For each of the first n / 2 bit-reversed positions,
+/// the slot it holds, as given by FFTLike::GetSlotIndex
+/// @param[in] n Size of the transform. Must be a power of two, at least 16.
+/// @param[in] scale Scale applied to output data
+/// @details Agrees up to rounding with Inverse_FFTLike_FromBitReverseRadix2
+/// of the n values holding slot i at the bit-reversed position of
+/// (5^i mod 2n - 1) / 2 and its conjugate at that of (2n - 5^i mod 2n - 1) /
+/// 2. Those are the first and second halves of the input, and the output is
+/// real, so only the sub-transform of the first half is computed: with X its
+/// output, result[j] = 2 * Re(X[j]) and result[j + n / 2] = 2 * Im(X[j]),
+/// times scale. The first stage reads the slots through \p slot_index and the
+/// final stage writes the real outputs.
+void Inverse_FFTLike_FromSlots(
+    std::complex<double>* result, const std::complex<double>* slots,
+    const std::complex<double>* inv_root_of_unity_powers,
+    const uint64_t* slot_index, const uint64_t n, const double* scale);
+
+/// @brief Single precision native C++ implementation of the forward FFT like
+/// @param[out] result Output data. Overwritten with FFT like output
+/// @param[in] operand Input data.
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity, rounded to
+/// single precision. In bit-reversed order
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+/// @param[in] skip_final_stage If true, stops before the final stage, which
+/// combines result[2 * i] and result[2 * i + 1]; \p scale is then unused.
+/// Forward_FFTLike_FinalStageMixed runs that stage in double precision.
+/// @details Same stages as Forward_FFTLike_ToBitReverseRadix4. Results agree
+/// with it up to a small multiple of log2(n) * 2^-24 times the sum of the
+/// absolute input values, times scale if given.
+void Forward_FFTLike_ToBitReverseFloat(
+    std::complex<float>* result, const std::complex<float>* operand,
+    const std::complex<float>* root_of_unity_powers, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+/// @brief Single precision native C++ implementation of the inverse FFT like
+/// @param[out] result Output data. Overwritten with FFT like output
+/// @param[in] operand Input data.
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity,
+/// rounded to single precision. In bit-reversed order.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+/// @param[in] skip_final_stage If true, stops before the final stage, which
+/// combines result[j] and result[j + n / 2]; \p scale is then unused.
+/// Inverse_FFTLike_FinalStageMixed runs that stage in double precision.
+/// @details Same stages as Inverse_FFTLike_FromBitReverseRadix4, with the
+/// same error bound as Forward_FFTLike_ToBitReverseFloat.
+void Inverse_FFTLike_FromBitReverseFloat(
+    std::complex<float>* result, const std::complex<float>* operand,
+    const std::complex<float>* inv_root_of_unity_powers, const uint64_t n,
+    const float* scale = nullptr, bool skip_final_stage = false);
+
+/// @brief Runs the final stage of the forward FFT like in double precision on
+/// the output of Forward_FFTLike_ToBitReverseFloat with skip_final_stage
+/// @param[out] result Output data
+/// @param[in] operand Output of the single precision stages
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity. In
+/// bit-reversed order
+/// @param[in] n Size of the transform. Must be a power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+void Forward_FFTLike_FinalStageMixed(
+    std::complex<double>* result, const std::complex<float>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const double* scale = nullptr);
+
+/// @brief Runs the final stage of the inverse FFT like in double precision on
+/// the output of Inverse_FFTLike_FromBitReverseFloat with skip_final_stage
+/// @param[out] result Output data
+/// @param[in] operand Output of the single precision stages
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity.
+/// In bit-reversed order.
+/// @param[in] n Size of the transform. Must be a power of two, at least 4.
+/// @param[in] scale Scale applied to output data
+void Inverse_FFTLike_FinalStageMixed(
+    std::complex<double>* result, const std::complex<float>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const double* scale = nullptr);
+
+/// @brief Radix-2 native C++ forward FFT like of batch_size vectors at once
+/// @param[out] result Output data of batch_size * n elements. Vector b is
+/// result[b * n], ..., result[b * n + n - 1]
+/// @param[in] operand Input data, laid out as \p result
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity. In
+/// bit-reversed order
+/// @param[in] n Size of each transform. Must be a power of two, at least 4.
+/// @param[in] batch_size Number of vectors
+/// @param[in] scale Scale applied to output data
+/// @details Each stage loads a root of unity power once and applies it to
+/// every vector of the batch. Results agree with
+/// Forward_FFTLike_ToBitReverseRadix2 on each vector up to rounding.
+void Forward_FFTLike_ToBitReverseRadix2Batch(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    const uint64_t batch_size, const double* scale = nullptr);
+
+/// @brief Radix-2 native C++ inverse FFT like of batch_size vectors at once
+/// @param[out] result Output data of batch_size * n elements. Vector b is
+/// result[b * n], ..., result[b * n + n - 1]
+/// @param[in] operand Input data, laid out as \p result
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity.
+/// In bit-reversed order.
+/// @param[in] n Size of each transform. Must be a power of two, at least 4.
+/// @param[in] batch_size Number of vectors
+/// @param[in] scale Scale applied to output data
+/// @details Each stage loads a root of unity power once and applies it to
+/// every vector of the batch. Results agree with
+/// Inverse_FFTLike_FromBitReverseRadix2 on each vector up to rounding.
+void Inverse_FFTLike_FromBitReverseRadix2Batch(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    const uint64_t batch_size, const double* scale = nullptr);
+
+/// @brief Native C++ implementation of constructing floating-point values
+/// from a CRT-composed polynomial with integer coefficients
+/// @param[out] res Stores the result
+/// @param[in] plain Plaintext. Coefficient i is the little-endian multi-word
+/// integer plain[i * mod_size], ..., plain[i * mod_size + mod_size - 1]
+/// @param[in] threshold Upper half threshold with respect to the total
+/// coefficient modulus
+/// @param[in] decryption_modulus Product of all primes in the coefficient
+/// modulus
+/// @param[in] inv_scale Scale applied to output values
+/// @param[in] mod_size Size of coefficient modulus parameter
+/// @param[in] coeff_count Degree of the polynomial modulus parameter
+/// @details Coefficients at or above the threshold are taken as negative.
+/// Results match BuildFloatingPointsAVX512 exactly.
+void BuildFloatingPointsNative(std::complex<double>* res,
+                               const uint64_t* plain,
+                               const uint64_t* threshold,
+                               const uint64_t* decryption_modulus,
+                               const double inv_scale, const size_t mod_size,
+                               const size_t coeff_count);
+
 }  // namespace hexl
 }  // namespace intel
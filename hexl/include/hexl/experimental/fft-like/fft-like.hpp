@@ -5,6 +5,7 @@
 
 #include <complex>
 
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
 #include "hexl/experimental/fft-like/fwd-fft-like-avx512.hpp"
 #include "hexl/experimental/fft-like/inv-fft-like-avx512.hpp"
 #include "hexl/util/aligned-allocator.hpp"
@@ -15,6 +16,8 @@ namespace hexl {
 
 /// @brief Performs linear forward and inverse FFT like transform
 /// for CKKS encoding and decoding.
+/// @details The transforms are const and take their scale as an argument, so
+/// one FFTLike may be used by several threads at once.
 class FFTLike {
  public:
   /// @brief Helper class for custom memory allocation
@@ -38,23 +41,20 @@ class FFTLike {
   /// @brief Destructs the CKKS_FTT object
   ~FFTLike() = default;
 
-  /// @brief Initializes an FFTLike object with degree \p degree and scalar
-  /// \p in_scalar.
+  /// @brief Initializes an FFTLike object with degree \p degree.
   /// @param[in] degree also known as N. Size of the FFT like transform. Must be
   /// a power of 2
-  /// @param[in] in_scalar Scalar value to calculate scale and inv scale
   /// @param[in] alloc_ptr Custom memory allocator used for intermediate
   /// calculations
   /// @details  Performs pre-computation necessary for forward and inverse
   /// transforms
-  FFTLike(uint64_t degree, double* in_scalar,
-          std::shared_ptr<AllocatorBase> alloc_ptr = {});
+  explicit FFTLike(uint64_t degree,
+                   std::shared_ptr<AllocatorBase> alloc_ptr = {});
 
   template <class Allocator, class... AllocatorArgs>
-  FFTLike(uint64_t degree, double* in_scalar, Allocator&& a,
-          AllocatorArgs&&... args)
+  FFTLike(uint64_t degree, Allocator&& a, AllocatorArgs&&... args)
       : FFTLike(
-            degree, in_scalar,
+            degree,
             std::static_pointer_cast<AllocatorBase>(
                 std::make_shared<AllocatorAdapter<Allocator, AllocatorArgs...>>(
                     std::move(a), std::forward<AllocatorArgs>(args)...))) {}
@@ -62,18 +62,88 @@ class FFTLike {
   /// @brief Compute forward FFT like. Results are bit-reversed.
   /// @param[out] result Stores the result
   /// @param[in] operand Data on which to compute the FFT like
-  /// @param[in] in_scale Scale applied to output values
+  /// @param[in] in_scale Scale applied to output values, or nullptr. Decoding
+  /// with scalar s uses 1 / s, encoding uses s / N.
+  /// @details With AVX512, transforms of degree at least 2^15 run on up to
+  /// GetFFTLikeNumThreads() threads, with the same results as one thread.
   void ComputeForwardFFTLike(std::complex<double>* result,
                              const std::complex<double>* operand,
-                             const double* in_scale = nullptr);
+                             const double* in_scale = nullptr) const;
 
   /// @brief Compute inverse FFT like. Results are bit-reversed.
   /// @param[out] result Stores the result
   /// @param[in] operand Data on which to compute the FFT like
-  /// @param[in] in_scale Scale applied to output values
+  /// @param[in] in_scale Scale applied to output values, or nullptr. Decoding
+  /// with scalar s uses 1 / s, encoding uses s / N.
+  /// @details With AVX512, transforms of degree at least 2^15 run on up to
+  /// GetFFTLikeNumThreads() threads, with the same results as one thread.
   void ComputeInverseFFTLike(std::complex<double>* result,
                              const std::complex<double>* operand,
-                             const double* in_scale = nullptr);
+                             const double* in_scale = nullptr) const;
+
+  /// @brief Compute forward FFT like of batch_size vectors. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the results. Vector b is result[b * N], ...,
+  /// result[b * N + N - 1]
+  /// @param[in] operand Data on which to compute the FFT like, laid out as
+  /// \p result
+  /// @param[in] batch_size Number of vectors
+  /// @param[in] in_scale Scale applied to output values
+  /// @details Results agree with ComputeForwardFFTLike on each vector up to
+  /// rounding. The vectors are processed on up to GetFFTLikeNumThreads()
+  /// threads.
+  void ComputeForwardFFTLikeBatch(std::complex<double>* result,
+                                  const std::complex<double>* operand,
+                                  uint64_t batch_size,
+                                  const double* in_scale = nullptr) const;
+
+  /// @brief Compute inverse FFT like of batch_size vectors. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the results. Vector b is result[b * N], ...,
+  /// result[b * N + N - 1]
+  /// @param[in] operand Data on which to compute the FFT like, laid out as
+  /// \p result
+  /// @param[in] batch_size Number of vectors
+  /// @param[in] in_scale Scale applied to output values
+  /// @details Results agree with ComputeInverseFFTLike on each vector up to
+  /// rounding. The vectors are processed on up to GetFFTLikeNumThreads()
+  /// threads.
+  void ComputeInverseFFTLikeBatch(std::complex<double>* result,
+                                  const std::complex<double>* operand,
+                                  uint64_t batch_size,
+                                  const double* in_scale = nullptr) const;
+
+  /// @brief Compute forward FFT like and return the N / 2 CKKS slots, for
+  /// decoding
+  /// @param[out] slots Stores the N / 2 slots. Slot i is the output of
+  /// ComputeForwardFFTLike at the bit-reversed position of
+  /// (5^i mod 2N - 1) / 2, i.e. the slots are in the order of the rotation
+  /// group generated by 5.
+  /// @param[in] operand N values on which to compute the FFT like
+  /// @param[in] in_scale Scale applied to output values, or nullptr
+  /// @details With the generator 5, the slots are the first half of the
+  /// bit-reversed outputs, so only half of the transform is computed, and the
+  /// slots are gathered from it. Results agree with ComputeForwardFFTLike up
+  /// to rounding. Runs on one thread.
+  void ComputeForwardFFTLikeToSlots(std::complex<double>* slots,
+                                    const std::complex<double>* operand,
+                                    const double* in_scale = nullptr) const;
+
+  /// @brief Compute inverse FFT like of the N / 2 CKKS slots and their
+  /// conjugates, for encoding
+  /// @param[out] result Stores the N results, whose imaginary parts are zero
+  /// @param[in] slots N / 2 slots in the order of
+  /// ComputeForwardFFTLikeToSlots. Must not overlap \p result.
+  /// @param[in] in_scale Scale applied to output values, or nullptr
+  /// @details Agrees up to rounding with ComputeInverseFFTLike of the N values
+  /// holding slot i at the bit-reversed position of (5^i mod 2N - 1) / 2 and
+  /// its conjugate at that of (2N - 5^i mod 2N - 1) / 2. The permutation and
+  /// the conjugate expansion are folded into the first and final stages; as
+  /// the conjugates make the output real, only half of the transform is
+  /// computed. Runs on one thread.
+  void ComputeInverseFFTLikeFromSlots(std::complex<double>* result,
+                                      const std::complex<double>* slots,
+                                      const double* in_scale = nullptr) const;
 
   /// @brief Construct floating-point values from CRT-composed polynomial with
   /// integer coefficients.
@@ -90,11 +160,11 @@ class FFTLike {
                            const uint64_t* threshold,
                            const uint64_t* decryption_modulus,
                            const double inv_scale, size_t mod_size,
-                           size_t coeff_count);
+                           size_t coeff_count) const;
 
   /// @brief Returns the root of unity power at bit-reversed index i.
   /// @param[in] i Index
-  std::complex<double> GetComplexRootOfUnity(size_t i) {
+  std::complex<double> GetComplexRootOfUnity(size_t i) const {
     return GetComplexRootsOfUnity()[i];
   }
 
@@ -105,7 +175,7 @@ class FFTLike {
 
   /// @brief Returns the root of unity power at bit-reversed index i.
   /// @param[in] i Index
-  std::complex<double> GetInvComplexRootOfUnity(size_t i) {
+  std::complex<double> GetInvComplexRootOfUnity(size_t i) const {
     return GetInvComplexRootsOfUnity()[i];
   }
 
@@ -115,6 +185,16 @@ class FFTLike {
     return m_inv_complex_roots_of_unity;
   }
 
+  /// @brief Returns, for each of the first N / 2 bit-reversed positions, the
+  /// slot it holds in ComputeForwardFFTLikeToSlots
+  const AlignedVector64<uint64_t>& GetSlotIndex() const { return m_slot_index; }
+
+  /// @brief Returns the bit-reversed position of each of the N / 2 slots of
+  /// ComputeForwardFFTLikeToSlots; the inverse of GetSlotIndex
+  const AlignedVector64<uint64_t>& GetSlotPositions() const {
+    return m_slot_positions;
+  }
+
   /// @brief Returns the degree N
   uint64_t GetDegree() const { return m_degree; }
 
@@ -122,13 +202,11 @@ class FFTLike {
   // Computes 1~(n-1)-th powers and inv powers of the primitive 2n-th root
   void ComputeComplexRootsOfUnity();
 
-  uint64_t m_degree;  // N: size of FFT like transform, should be power of 2
-
-  double* scalar;  // Pointer to scalar used for scale/inv_scale calculation
+  // Computes the slot held by each of the first n / 2 bit-reversed positions
+  // and the position of each slot
+  void ComputeSlotIndex();
 
-  double scale;  // Scale value use for encoding (inv fft-like)
-
-  double inv_scale;  // Scale value use in decoding (fwd fft-like)
+  uint64_t m_degree;  // N: size of FFT like transform, should be power of 2
 
   std::shared_ptr<AllocatorBase> m_alloc;
 
@@ -141,7 +219,22 @@ class FFTLike {
 
   // Contains 0~(n-1)-th inv powers of the 2n-th primitive inv root.
   AlignedVector64<std::complex<double>> m_inv_complex_roots_of_unity;
+
+  // Slot held by each of the first n / 2 bit-reversed positions, and the
+  // position of each slot. The slot transforms read through one or the other
+  // so that they never scatter.
+  AlignedVector64<uint64_t> m_slot_index;
+  AlignedVector64<uint64_t> m_slot_positions;
 };
 
+/// @brief Sets the maximum number of threads used by the batched FFT like
+/// transforms and by the AVX512 FFT like transforms of degree at least 2^15.
+/// @param[in] num_threads Thread count; 0 uses the OpenMP default and 1 runs
+/// serially. Has no effect when built without OpenMP.
+void SetFFTLikeNumThreads(uint64_t num_threads);
+
+/// @brief Returns the thread count set by SetFFTLikeNumThreads; 0 by default
+uint64_t GetFFTLikeNumThreads();
+
 }  // namespace hexl
 }  // namespace intel
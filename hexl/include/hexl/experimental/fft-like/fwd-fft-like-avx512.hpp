@@ -36,6 +36,52 @@ void Forward_FFTLike_ToBitReverseAVX512(
     const double* scale = nullptr, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief Forward FFT like with the in-place stages of
+/// Forward_FFTLike_ToBitReverseAVX512 merged pairwise into radix-4 passes.
+/// Results agree with Forward_FFTLike_ToBitReverseRadix2 up to rounding, with
+/// the bound of Forward_FFTLike_ToBitReverseRadix4.
+void Forward_FFTLike_ToBitReverseRadix4AVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const double* scale = nullptr, uint64_t recursion_depth = 0,
+    uint64_t recursion_half = 0);
+
+/// @brief Multi-threaded Forward_FFTLike_ToBitReverseRadix4AVX512, with
+/// bit-identical results
+/// @param[in] num_threads Maximum number of OpenMP threads; 0 uses the OpenMP
+/// default
+/// @details The passes above the sub-transforms of the depth-first recursion
+/// are split into column spans across the threads. Once there is a
+/// sub-transform per thread, the sub-transforms are computed in parallel.
+/// Transforms with n <= 1024 run serially.
+void Forward_FFTLike_ToBitReverseRadix4ParallelAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* roots_of_unity_cmplx_intrlvd, const uint64_t n,
+    const double* scale, uint64_t num_threads);
+
+/// @brief AVX512 implementation of Forward_FFTLike_ToSlots
+/// @param[out] slots_cmplx_intrlvd Output data of n / 2 slots in rotation
+/// group order, as double with interleaved real and imaginary numbers
+/// @param[in] operand_cmplx_intrlvd Input data of n complex values, as double
+/// with interleaved real and imaginary numbers
+/// @param[in] roots_of_unity_cmplx_intrlvd Powers of 2n'th root of unity. In
+/// bit-reversed order.
+/// @param[in] slot_positions The bit-reversed position of each slot, as given
+/// by FFTLike::GetSlotPositions
+/// @param[in] n Size of the transform. Must be a power of two, at least 32.
+/// @param[in] scale Scale applied to output values
+/// @param[out] buffer_cmplx_intrlvd Scratch space for n doubles
+/// @details Computes the first half of the first stage into the buffer, in
+/// the layout the sub-transforms of Forward_FFTLike_ToBitReverseRadix4AVX512
+/// use, runs the sub-transform of that half and gathers the slots from it.
+/// Runs on one thread.
+void Forward_FFTLike_ToSlotsAVX512(double* slots_cmplx_intrlvd,
+                                   const double* operand_cmplx_intrlvd,
+                                   const double* roots_of_unity_cmplx_intrlvd,
+                                   const uint64_t* slot_positions,
+                                   const uint64_t n, const double* scale,
+                                   double* buffer_cmplx_intrlvd);
+
 /// @brief Construct floating-point values from CRT-composed polynomial with
 /// integer coefficients in AVX512.
 /// @param[out] res_cmplx_intrlvd Stores the result
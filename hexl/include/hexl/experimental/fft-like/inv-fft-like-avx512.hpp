@@ -36,6 +36,49 @@ void Inverse_FFTLike_FromBitReverseAVX512(
     const double* scale = nullptr, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief Inverse FFT like with the in-place stages of
+/// Inverse_FFTLike_FromBitReverseAVX512 merged pairwise into radix-4 passes.
+/// Results agree with Inverse_FFTLike_FromBitReverseRadix2 up to rounding, with
+/// the bound of Forward_FFTLike_ToBitReverseRadix4.
+void Inverse_FFTLike_FromBitReverseRadix4AVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplxintrlvd, const uint64_t n,
+    const double* scale = nullptr, uint64_t recursion_depth = 0,
+    uint64_t recursion_half = 0);
+
+/// @brief Multi-threaded Inverse_FFTLike_FromBitReverseRadix4AVX512, with
+/// bit-identical results
+/// @param[in] num_threads Maximum number of OpenMP threads; 0 uses the OpenMP
+/// default
+/// @details The sub-transforms of the depth-first recursion are computed in
+/// parallel, then the passes above them are split into column spans across
+/// the threads. Transforms with n <= 1024 run serially.
+void Inverse_FFTLike_FromBitReverseRadix4ParallelAVX512(
+    double* result_cmplx_intrlvd, const double* operand_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplxintrlvd, const uint64_t n,
+    const double* scale, uint64_t num_threads);
+
+/// @brief AVX512 implementation of Inverse_FFTLike_FromSlots
+/// @param[out] result_cmplx_intrlvd Output data of n complex values with zero
+/// imaginary parts, as double with interleaved real and imaginary numbers
+/// @param[in] slots_cmplx_intrlvd n / 2 slots in rotation group order, as
+/// double with interleaved real and imaginary numbers. Must not overlap
+/// \p result_cmplx_intrlvd.
+/// @param[in] inv_root_of_unity_cmplxintrlvd Powers of inverse 2n'th root of
+/// unity. In bit-reversed order.
+/// @param[in] slot_index For each of the first n / 2 bit-reversed positions,
+/// the slot it holds, as given by FFTLike::GetSlotIndex
+/// @param[in] n Size of the transform. Must be a power of two, at least 32.
+/// @param[in] scale Scale applied to output values
+/// @details Gathers the slots into the first half of \p result_cmplx_intrlvd,
+/// runs the sub-transform of that half as in
+/// Inverse_FFTLike_FromBitReverseRadix4AVX512 and writes the real outputs in
+/// the final stage. Runs on one thread.
+void Inverse_FFTLike_FromSlotsAVX512(
+    double* result_cmplx_intrlvd, const double* slots_cmplx_intrlvd,
+    const double* inv_root_of_unity_cmplxintrlvd, const uint64_t* slot_index,
+    const uint64_t n, const double* scale);
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
@@ -0,0 +1,83 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "hexl/util/aligned-allocator.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Converts polynomials from an RNS base q = q_0 * ... * q_{k-1} to an
+/// RNS base p_0, ..., p_{l-1}.
+/// @details The fast base conversion of x in [0, q) is
+/// sum_i [x * (q / q_i)^{-1}]_{q_i} * (q / q_i) mod p_j, which equals
+/// x + u * q for some integer 0 <= u < k. Optionally, the q-overflow u is
+/// corrected using floating-point arithmetic (Halevi-Polyakov-Shoup), in which
+/// case the result is the centered representative of x in [-q/2, q/2). This
+/// is the core of hybrid key switching, BFV multiplication and ModRaise.
+class BaseConverter {
+ public:
+  /// @brief Initializes an empty BaseConverter object
+  BaseConverter() = default;
+
+  /// @brief Initializes a BaseConverter object from the input moduli \p
+  /// in_moduli to the output moduli \p out_moduli
+  /// @param[in] in_moduli Pairwise co-prime word-sized moduli of the input
+  /// base. Each must be less than 2^62.
+  /// @param[in] out_moduli Word-sized moduli of the output base. Each must be
+  /// less than 2^62.
+  /// @details Pre-computes the (q / q_i)^{-1} mod q_i and (q / q_i) mod p_j
+  /// tables
+  BaseConverter(const std::vector<uint64_t>& in_moduli,
+                const std::vector<uint64_t>& out_moduli);
+
+  /// @brief Performs fast base conversion
+  /// @param[out] result Stores the result. Has n * out_moduli.size() elements,
+  /// stored as contiguous limbs. Must not alias \p operand.
+  /// @param[in] operand Polynomial with n * in_moduli.size() elements, stored
+  /// as contiguous limbs. Limb i has elements in [0, in_moduli[i]).
+  /// @param[in] n Number of coefficients in each limb
+  /// @param[in] exact If true, corrects the q-overflow so the result is the
+  /// exact centered representative of the input. The correction is exact
+  /// unless the input is within a relative distance of about k * 2^{-52} of
+  /// +/- q/2.
+  /// @param[out] buffer Scratch space for n * in_moduli.size() elements. If
+  /// nullptr, it is allocated on each call.
+  void FastBaseConversion(uint64_t* result, const uint64_t* operand,
+                          uint64_t n, bool exact = false,
+                          uint64_t* buffer = nullptr) const;
+
+  /// @brief Returns the moduli of the input base
+  const std::vector<uint64_t>& InputModuli() const { return m_in_moduli; }
+
+  /// @brief Returns the moduli of the output base
+  const std::vector<uint64_t>& OutputModuli() const { return m_out_moduli; }
+
+  /// @brief Returns (q / q_i)^{-1} mod q_i for each input modulus q_i
+  const AlignedVector64<uint64_t>& GetQHatInvModQ() const {
+    return m_q_hat_inv_mod_q;
+  }
+
+  /// @brief Returns the out_moduli.size() x (in_moduli.size() + 1) row-major
+  /// matrix whose entry (j, i) is (q / q_i) mod p_j for i < k, and -q mod p_j
+  /// for i == k
+  const AlignedVector64<uint64_t>& GetQHatModP() const {
+    return m_q_hat_mod_p;
+  }
+
+ private:
+  std::vector<uint64_t> m_in_moduli;
+  std::vector<uint64_t> m_out_moduli;
+
+  AlignedVector64<uint64_t> m_q_hat_inv_mod_q;
+  AlignedVector64<uint64_t> m_q_hat_mod_p;
+  AlignedVector64<double> m_inv_q;
+};
+
+}  // namespace hexl
+}  // namespace intel
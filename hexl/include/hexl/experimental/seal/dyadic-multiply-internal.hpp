@@ -11,7 +11,7 @@ namespace internal {
 
 /// @brief Computes dyadic multiplication
 /// @param[in,out] result Ciphertext data. Will be over-written with result. Has
-/// (2 * n * num_moduli) elements
+/// (3 * n * num_moduli) elements
 /// @param[in] operand1 First ciphertext argument. Has (2 * n * num_moduli)
 /// elements.
 /// @param[in] operand2 Second ciphertext argument. Has (2 * n * num_moduli)
@@ -24,6 +24,21 @@ void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
                     const uint64_t* moduli, uint64_t num_moduli);
 
+/// @brief Computes dyadic multiplication modulo a single modulus with three
+/// products: the middle polynomial is (x0 + x1)(y0 + y1) - x0 y0 - x1 y1
+/// @param[out] result Output polynomial k starts at result + k * poly_stride,
+/// for k = 0, 1, 2. May alias operand1 or operand2.
+/// @param[in] operand1 Polynomial k of x starts at operand1 + k * poly_stride,
+/// for k = 0, 1. Elements must be less than the modulus.
+/// @param[in] operand2 Polynomial k of y starts at operand2 + k * poly_stride,
+/// for k = 0, 1. Elements must be less than the modulus.
+/// @param[in] n Number of coefficients to process in each polynomial
+/// @param[in] poly_stride Distance between consecutive polynomials
+/// @param[in] modulus Modulus; must be less than 2^62
+void DyadicMultiplyKaratsubaNative(uint64_t* result, const uint64_t* operand1,
+                                   const uint64_t* operand2, uint64_t n,
+                                   uint64_t poly_stride, uint64_t modulus);
+
 }  // namespace internal
 }  // namespace hexl
 }  // namespace intel
@@ -8,9 +8,40 @@
 namespace intel {
 namespace hexl {
 
+/// @enum DyadicMultiplyAlgorithm
+/// @brief Method used by DyadicMultiply for the middle output polynomial
+enum class DyadicMultiplyAlgorithm {
+  /// Faster of the methods below, measured once on first use for moduli
+  /// below 2^50 and once for larger moduli. The measurement is deferred
+  /// while DyadicMultiply is called inside an OpenMP parallel region, which
+  /// uses kSchoolbook until then; select a method explicitly to avoid it.
+  kAuto,
+  /// x0 * y1 + x1 * y0 with four EltwiseMultMod calls and an EltwiseAddMod
+  kSchoolbook,
+  /// (x0 + x1)(y0 + y1) - x0 * y0 - x1 * y1 with three products, fused into
+  /// one pass over the operands; requires modulus < 2^62
+  kKaratsuba
+};
+
+/// @brief Selects the method used by subsequent calls to DyadicMultiply
+/// @details Thread-safe; the default is kAuto
+void SetDyadicMultiplyAlgorithm(DyadicMultiplyAlgorithm algorithm);
+
+/// @brief Returns the method selected by SetDyadicMultiplyAlgorithm
+DyadicMultiplyAlgorithm GetDyadicMultiplyAlgorithm();
+
+/// @brief Sets the maximum number of threads used by DyadicMultiply.
+/// @param[in] num_threads Thread count; 0 uses the OpenMP default and 1 runs
+/// serially. Has no effect when built without OpenMP.
+void SetDyadicMultiplyNumThreads(uint64_t num_threads);
+
+/// @brief Returns the thread count set by SetDyadicMultiplyNumThreads; 0 by
+/// default
+uint64_t GetDyadicMultiplyNumThreads();
+
 /// @brief Computes dyadic multiplication
 /// @param[in,out] result Ciphertext data. Will be over-written with result. Has
-/// (2 * n * num_moduli) elements
+/// (3 * n * num_moduli) elements
 /// @param[in] operand1 First ciphertext argument. Has (2 * n * num_moduli)
 /// elements.
 /// @param[in] operand2 Second ciphertext argument. Has (2 * n * num_moduli)
@@ -19,6 +50,8 @@ namespace hexl {
 /// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
 /// coefficient moduli
 /// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @details Tiles of the moduli are processed in parallel on up to
+/// GetDyadicMultiplyNumThreads() threads
 void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
                     const uint64_t* moduli, uint64_t num_moduli);
@@ -0,0 +1,102 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "hexl/experimental/seal/base-conversion.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Hybrid key switching with dnum decomposition digits and several
+/// special primes
+/// @details The ciphertext modulus Q = q_0 * ... * q_{L-1} is split into
+/// digits of digit_size consecutive primes, and the key switching keys live
+/// modulo P * Q for a special modulus P = p_0 * ... * p_{K-1}. Each digit of
+/// the target is raised to P * Q with fast base conversion (ModUp), multiplied
+/// with the key for that digit, and the accumulated products are divided by P
+/// and rounded (ModDown). Compared to KeySwitch, which decomposes per prime
+/// with a single special prime, this needs dnum = ceil(L / digit_size)
+/// instead of L key components and far fewer NTTs.
+class HybridKeySwitcher {
+ public:
+  /// @brief Initializes an empty HybridKeySwitcher object
+  HybridKeySwitcher() = default;
+
+  /// @brief Initializes a HybridKeySwitcher object
+  /// @param[in] n Number of coefficients in each polynomial. Must be a power
+  /// of two.
+  /// @param[in] moduli The key moduli q_0, ..., q_{L-1}, p_0, ..., p_{K-1}:
+  /// the ciphertext moduli at the top level followed by the special primes.
+  /// Each must be an NTT-friendly prime less than 2^62.
+  /// @param[in] special_modulus_size Number K of special primes at the end of
+  /// \p moduli
+  /// @param[in] digit_size Number of ciphertext primes per decomposition
+  /// digit
+  /// @details Pre-computes the base converters of every level and resolves
+  /// the NTT of every modulus, so KeySwitch performs no NTT cache lookups
+  HybridKeySwitcher(uint64_t n, const std::vector<uint64_t>& moduli,
+                    uint64_t special_modulus_size, uint64_t digit_size);
+
+  /// @brief Computes key switching in-place
+  /// @param[in,out] result Ciphertext data to which the key-switched target
+  /// is added. Has (n * decomp_modulus_size * key_component_count) elements,
+  /// stored as key_component_count polynomials of decomp_modulus_size
+  /// contiguous limbs in NTT form.
+  /// @param[in] t_target_iter_ptr Polynomial to key switch, in NTT form. Has
+  /// n * decomp_modulus_size elements; limb i has elements in [0, q_i).
+  /// @param[in] decomp_modulus_size Number of ciphertext moduli L' <= L at the
+  /// current level
+  /// @param[in] key_component_count Number of components in the resulting
+  /// ciphertext, e.g. key_component_count == 2.
+  /// @param[in] k_switch_keys Array of NumDigits(decomp_modulus_size)
+  /// evaluation keys, one per digit. Each has key_component_count
+  /// polynomials of KeyModulusSize() limbs, in NTT form and in the order of
+  /// \p moduli.
+  void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr,
+                 uint64_t decomp_modulus_size, uint64_t key_component_count,
+                 const uint64_t** k_switch_keys) const;
+
+  /// @brief Returns the number of decomposition digits at a level with
+  /// \p decomp_modulus_size ciphertext moduli
+  uint64_t NumDigits(uint64_t decomp_modulus_size) const {
+    return (decomp_modulus_size + m_digit_size - 1) / m_digit_size;
+  }
+
+  /// @brief Returns the number of ciphertext primes per digit
+  uint64_t DigitSize() const { return m_digit_size; }
+
+  /// @brief Returns the number of special primes
+  uint64_t SpecialModulusSize() const { return m_special_modulus_size; }
+
+  /// @brief Returns the total number of key moduli, L + K
+  uint64_t KeyModulusSize() const { return m_moduli.size(); }
+
+ private:
+  uint64_t m_n{0};
+  uint64_t m_special_modulus_size{0};
+  uint64_t m_digit_size{0};
+  std::vector<uint64_t> m_moduli;
+  // NTT of each modulus in m_moduli, kept alive across cache evictions
+  std::vector<std::shared_ptr<NTT>> m_ntts;
+
+  // m_mod_up[l][d] converts digit d to the other moduli of level l + 1 and
+  // the special primes
+  std::vector<std::vector<BaseConverter>> m_mod_up;
+  // m_mod_down[l] converts the special primes to the moduli of level l + 1
+  std::vector<BaseConverter> m_mod_down;
+
+  AlignedVector64<uint64_t> m_p_inv_mod_q;   // P^{-1} mod q_i
+  AlignedVector64<uint64_t> m_p_half_mod_q;  // floor(P / 2) mod q_i
+  AlignedVector64<uint64_t> m_p_half_mod_p;  // floor(P / 2) mod p_j
+};
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,109 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/allocator.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Number of ciphertexts KeySwitchBatch processes per pass over the key
+/// when no workspace is provided
+constexpr uint64_t kDefaultKeySwitchBatchSize = 4;
+
+/// @brief Scratch memory for KeySwitch and KeySwitchBatch
+/// @details Holds every intermediate buffer KeySwitch needs, 64-byte aligned,
+/// so that KeySwitch performs no heap allocations. Create one workspace per
+/// thread and reuse it across calls; a workspace must not be shared by
+/// concurrent KeySwitch calls.
+class KeySwitchWorkspace {
+ public:
+  /// @brief Allocates a workspace for KeySwitch calls with the given sizes
+  /// @param[in] n Number of coefficients in each polynomial
+  /// @param[in] decomp_modulus_size Largest decomp_modulus_size passed to
+  /// KeySwitch
+  /// @param[in] key_component_count Largest key_component_count passed to
+  /// KeySwitch
+  /// @param[in] batch_size Number of ciphertexts KeySwitchBatch processes per
+  /// pass over the key. Larger values stream the key from memory fewer times
+  /// at the cost of batch_size times more scratch memory.
+  /// @param[in] alloc_ptr Custom memory allocator used for the buffers
+  KeySwitchWorkspace(uint64_t n, uint64_t decomp_modulus_size,
+                     uint64_t key_component_count, uint64_t batch_size = 1,
+                     std::shared_ptr<AllocatorBase> alloc_ptr = {})
+      : m_n(n),
+        m_decomp_modulus_size(decomp_modulus_size),
+        m_key_component_count(key_component_count),
+        m_batch_size(batch_size),
+        m_aligned_alloc(AlignedAllocator<uint64_t, 64>(alloc_ptr)),
+        m_target(batch_size * n * decomp_modulus_size, 0, m_aligned_alloc),
+        m_ntt(batch_size * n * decomp_modulus_size, 0, m_aligned_alloc),
+        m_poly_prod(
+            batch_size * n * key_component_count * (decomp_modulus_size + 1),
+            0, m_aligned_alloc),
+        m_rescale(n * (decomp_modulus_size + 1), 0, m_aligned_alloc),
+        m_rescale_moduli(decomp_modulus_size + 1, 0, m_aligned_alloc),
+        m_ntts(decomp_modulus_size + 1, nullptr),
+        m_cached_ntts(decomp_modulus_size + 1) {}
+
+  /// @brief Returns whether or not this workspace can serve a KeySwitch call
+  /// with the given sizes
+  bool Fits(uint64_t n, uint64_t decomp_modulus_size,
+            uint64_t key_component_count) const {
+    return n == m_n && decomp_modulus_size <= m_decomp_modulus_size &&
+           key_component_count <= m_key_component_count && m_batch_size > 0;
+  }
+
+  /// @brief Returns the number of ciphertexts processed per pass over the key
+  uint64_t BatchSize() const { return m_batch_size; }
+
+  /// @brief Copies of the target polynomials; BatchSize() * n *
+  /// decomp_modulus_size elements
+  uint64_t* Target() { return m_target.data(); }
+
+  /// @brief NTT operands for one RNS limb; BatchSize() * n *
+  /// decomp_modulus_size elements
+  uint64_t* NTTOperand() { return m_ntt.data(); }
+
+  /// @brief Key products; BatchSize() * n * key_component_count *
+  /// rns_modulus_size elements
+  uint64_t* PolyProd() { return m_poly_prod.data(); }
+
+  /// @brief RNSRescale scratch; n * rns_modulus_size elements
+  uint64_t* Rescale() { return m_rescale.data(); }
+
+  /// @brief RNSRescale moduli; rns_modulus_size elements
+  uint64_t* RescaleModuli() { return m_rescale_moduli.data(); }
+
+  /// @brief NTTs of the RNSRescale moduli; rns_modulus_size elements
+  NTT** NTTs() { return m_ntts.data(); }
+
+  /// @brief Keeps the NTTs taken from the NTT cache alive during a call, in
+  /// case they are evicted; rns_modulus_size elements
+  std::shared_ptr<NTT>* CachedNTTs() { return m_cached_ntts.data(); }
+
+ private:
+  uint64_t m_n;
+  uint64_t m_decomp_modulus_size;
+  uint64_t m_key_component_count;
+  uint64_t m_batch_size;
+  AlignedAllocator<uint64_t, 64> m_aligned_alloc;
+  AlignedVector64<uint64_t> m_target;
+  AlignedVector64<uint64_t> m_ntt;
+  AlignedVector64<uint64_t> m_poly_prod;
+  AlignedVector64<uint64_t> m_rescale;
+  AlignedVector64<uint64_t> m_rescale_moduli;
+  std::vector<NTT*> m_ntts;
+  std::vector<std::shared_ptr<NTT>> m_cached_ntts;
+};
+
+}  // namespace hexl
+}  // namespace intel
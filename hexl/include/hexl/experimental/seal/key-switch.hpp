@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/experimental/seal/key-switch-workspace.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -30,7 +32,12 @@ namespace hexl {
 /// coeff_count * ((key_modulus_size - 1)+ (key_component_count - 1) *
 /// (key_modulus_size) + 1) entries
 /// @param[in] modswitch_factors Array of modulus switch factors
-/// @param[in] root_of_unity_powers_ptr Array of root of unity powers
+/// @param[in] root_of_unity_powers_ptr Array of root of unity powers. Not
+/// supported; must be nullptr. To avoid NTT cache lookups, pass NTTs to the
+/// workspace overload instead.
+/// @details RNS limbs are processed in parallel using up to
+/// GetKeySwitchNumThreads() threads; the result does not depend on the thread
+/// count.
 void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                uint64_t decomp_modulus_size, uint64_t key_modulus_size,
                uint64_t rns_modulus_size, uint64_t key_component_count,
@@ -38,5 +45,67 @@ void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                const uint64_t* modswitch_factors,
                const uint64_t* root_of_unity_powers_ptr = nullptr);
 
+/// @brief Computes key switching in-place using caller-provided scratch memory
+/// @details Same as KeySwitch above, but takes all intermediate buffers from
+/// \p workspace and performs no heap allocations.
+/// @param[in,out] workspace Scratch memory; must satisfy
+/// workspace.Fits(n, decomp_modulus_size, key_component_count)
+/// @param[in] ntts Optional array of key_modulus_size NTTs of degree n, one
+/// per modulus in \p moduli. When provided, KeySwitch performs no NTT cache
+/// lookups and takes no locks. If nullptr, each NTT is looked up once per
+/// call in the global NTT cache.
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace, NTT* const* ntts = nullptr);
+
+/// @brief Computes key switching in-place for a batch of ciphertexts sharing
+/// one key
+/// @param[in,out] results Array of batch_size ciphertexts, each laid out as
+/// the result argument of KeySwitch
+/// @param[in] t_target_iter_ptrs Array of batch_size target polynomials, each
+/// laid out as the t_target_iter_ptr argument of KeySwitch
+/// @param[in] batch_size Number of ciphertexts
+/// @details The remaining parameters are as in KeySwitch. Ciphertexts are
+/// processed kDefaultKeySwitchBatchSize at a time; each tile of
+/// k_switch_keys is loaded once per group and reused from cache across it,
+/// so the key is streamed from memory fewer times than with repeated
+/// KeySwitch calls. The results match KeySwitch.
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors);
+
+/// @brief Computes batched key switching in-place using caller-provided
+/// scratch memory
+/// @details Same as KeySwitchBatch above, but processes
+/// workspace.BatchSize() ciphertexts per pass over the key and performs no
+/// heap allocations.
+/// @param[in,out] workspace Scratch memory; must satisfy
+/// workspace.Fits(n, decomp_modulus_size, key_component_count)
+/// @param[in] ntts Optional array of key_modulus_size NTTs of degree n, as in
+/// KeySwitch
+void KeySwitchBatch(uint64_t* const* results,
+                    const uint64_t* const* t_target_iter_ptrs,
+                    uint64_t batch_size, uint64_t n,
+                    uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                    uint64_t rns_modulus_size, uint64_t key_component_count,
+                    const uint64_t* moduli, const uint64_t** k_switch_keys,
+                    const uint64_t* modswitch_factors,
+                    KeySwitchWorkspace& workspace, NTT* const* ntts = nullptr);
+
+/// @brief Sets the maximum number of threads used by KeySwitch.
+/// @param[in] num_threads Thread count; 0 uses the OpenMP default and 1 runs
+/// serially. Has no effect when built without OpenMP.
+void SetKeySwitchNumThreads(uint64_t num_threads);
+
+/// @brief Returns the thread count set by SetKeySwitchNumThreads; 0 by default
+uint64_t GetKeySwitchNumThreads();
+
 }  // namespace hexl
 }  // namespace intel
@@ -3,8 +3,14 @@
 
 #pragma once
 
-#include "hexl/experimental/seal/locks.hpp"
-#include "ntt/ntt-internal.hpp"
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
 
 namespace intel {
 namespace hexl {
@@ -24,33 +30,61 @@ struct HashPair {
   }
 };
 
-NTT& GetNTT(size_t N, uint64_t modulus) {
-  static std::unordered_map<std::pair<uint64_t, uint64_t>, NTT, HashPair>
-      ntt_cache;
-  static RWLock ntt_cache_locker;
+/// @brief Counters of the process-wide NTT cache
+struct NTTCacheStats {
+  /// Lookups served without constructing an NTT
+  uint64_t hits{0};
+  /// Lookups which constructed an NTT
+  uint64_t misses{0};
+  /// NTTs constructed by lookups and PrewarmNTTCache
+  uint64_t constructions{0};
+  /// Total time spent constructing NTTs, in nanoseconds
+  uint64_t construction_ns{0};
+  /// Entries evicted to respect the capacity
+  uint64_t evictions{0};
+  /// Number of cached NTTs
+  uint64_t size{0};
+};
 
-  std::pair<uint64_t, uint64_t> key{N, modulus};
+/// @brief Returns the cached NTT of degree \p N and modulus \p modulus,
+/// constructing it on first use
+/// @details Lookups of NTTs this thread has already seen take no lock: each
+/// thread keeps its own view of the cache, which is refreshed only after an
+/// NTT was evicted or the cache cleared. A new NTT is constructed without
+/// holding the cache lock, so concurrent lookups of other NTTs do not wait
+/// for it.
+/// @return A reference which may dangle after the calling thread's next call
+/// into the cache: if the entry was evicted or the cache cleared in the
+/// meantime, that call destroys the NTT. Do not hold the reference across
+/// another GetNTT call, e.g. when resolving the NTTs of several moduli; use
+/// GetNTTShared to keep an NTT alive independently of the cache.
+NTT& GetNTT(size_t N, uint64_t modulus);
 
-  // Enable shared access to NTT already present
-  {
-    ReadLock reader_lock(ntt_cache_locker.AcquireRead());
-    auto ntt_it = ntt_cache.find(key);
-    if (ntt_it != ntt_cache.end()) {
-      return ntt_it->second;
-    }
-  }
+/// @brief Returns the cached NTT of degree \p N and modulus \p modulus,
+/// constructing it on first use, as a shared pointer which keeps it alive
+/// after eviction
+std::shared_ptr<NTT> GetNTTShared(size_t N, uint64_t modulus);
 
-  // Deal with NTT not yet present
-  WriteLock write_lock(ntt_cache_locker.AcquireWrite());
+/// @brief Constructs and caches the NTT of degree \p N for each of the
+/// \p moduli, so later GetNTT calls do not pay the construction cost
+void PrewarmNTTCache(size_t N, const std::vector<uint64_t>& moduli);
 
-  // Check ntt_cache for value (may be added by another thread)
-  auto ntt_it = ntt_cache.find(key);
-  if (ntt_it == ntt_cache.end()) {
-    NTT ntt(N, modulus);
-    ntt_it = ntt_cache.emplace(std::move(key), std::move(ntt)).first;
-  }
-  return ntt_it->second;
-}
+/// @brief Bounds the number of cached NTTs, evicting the oldest entries
+/// beyond \p capacity. A capacity of 0, the default, means unbounded.
+void SetNTTCacheCapacity(size_t capacity);
+
+/// @brief Returns the capacity set by SetNTTCacheCapacity
+size_t GetNTTCacheCapacity();
+
+/// @brief Removes every NTT from the cache
+void ClearNTTCache();
+
+/// @brief Returns the cache counters accumulated since the last
+/// ResetNTTCacheStats
+NTTCacheStats GetNTTCacheStats();
+
+/// @brief Resets the hit, miss, construction and eviction counters
+void ResetNTTCacheStats();
 
 }  // namespace hexl
 }  // namespace intel
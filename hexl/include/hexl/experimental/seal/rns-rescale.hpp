@@ -0,0 +1,44 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/ntt/ntt.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Divides an RNS polynomial by its last modulus and rounds, dropping
+/// the last modulus, i.e. computes round(x / q_k) mod q_i for i < k. This is
+/// the CKKS rescale / BGV modulus-switching operation.
+/// @param[out] result Stores the result. Has n * (num_moduli - 1) elements,
+/// stored as num_moduli - 1 contiguous limbs. May alias \p operand.
+/// @param[in] operand Polynomial with n * num_moduli elements, stored as
+/// num_moduli contiguous limbs. Limb i has elements in [0, moduli[i]).
+/// @param[in] n Number of coefficients in each limb. Must be a power of two
+/// if \p ntt_form is true.
+/// @param[in] num_moduli Number of moduli, including the modulus q_k to drop.
+/// Must be at least 2.
+/// @param[in] moduli Array of num_moduli coefficient moduli, each less than
+/// 2^62. The last modulus q_k = moduli[num_moduli - 1] is dropped.
+/// @param[in] inv_qk_mod_qi Array of num_moduli - 1 values q_k^{-1} mod
+/// moduli[i]
+/// @param[in] ntt_form Whether \p operand is in NTT form. If true, the result
+/// is also in NTT form; otherwise, both are in coefficient form.
+/// @param[in] num_threads Maximum number of threads processing limbs in
+/// parallel; 0 uses the OpenMP default.
+/// @param[in] scratch Optional scratch buffer of n * num_moduli elements,
+/// preferably 64-byte aligned. If nullptr, RNSRescale allocates its own.
+/// @param[in] ntts Optional array of num_moduli NTTs of degree n, one per
+/// modulus in \p moduli, used when \p ntt_form is true. If nullptr, the NTTs
+/// are looked up in the global NTT cache.
+void RNSRescale(uint64_t* result, const uint64_t* operand, uint64_t n,
+                uint64_t num_moduli, const uint64_t* moduli,
+                const uint64_t* inv_qk_mod_qi, bool ntt_form,
+                uint64_t num_threads = 0, uint64_t* scratch = nullptr,
+                NTT* const* ntts = nullptr);
+
+}  // namespace hexl
+}  // namespace intel
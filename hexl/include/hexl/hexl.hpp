@@ -6,16 +6,25 @@
 #include "hexl/eltwise/eltwise-add-mod.hpp"
 #include "hexl/eltwise/eltwise-cmp-add.hpp"
 #include "hexl/eltwise/eltwise-cmp-sub-mod.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
 #include "hexl/eltwise/eltwise-fma-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
 #include "hexl/eltwise/eltwise-sub-mod.hpp"
+#include "hexl/eltwise/eltwise-sum-mod.hpp"
+#include "hexl/experimental/fft-like/ckks-encoding.hpp"
+#include "hexl/experimental/fft-like/fft-like-cache.hpp"
+#include "hexl/experimental/fft-like/fft-like-float.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
 #include "hexl/experimental/misc/lr-mat-vec-mult.hpp"
+#include "hexl/experimental/seal/base-conversion.hpp"
 #include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 #include "hexl/experimental/seal/dyadic-multiply.hpp"
+#include "hexl/experimental/seal/hybrid-key-switch.hpp"
 #include "hexl/experimental/seal/key-switch-internal.hpp"
+#include "hexl/experimental/seal/key-switch-workspace.hpp"
 #include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/experimental/seal/rns-rescale.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/ntt/ntt.hpp"
 #include "hexl/number-theory/number-theory.hpp"
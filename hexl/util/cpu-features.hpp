@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <cstdlib>
 
@@ -12,13 +13,14 @@
 namespace intel {
 namespace hexl {
 
-// Use to disable avx512 dispatching at runtime
+// Use to disable avx512 and avx2 dispatching at runtime
 static const bool disable_avx512dq =
     (std::getenv("HEXL_DISABLE_AVX512DQ") != nullptr);
 static const bool disable_avx512ifma =
     disable_avx512dq || (std::getenv("HEXL_DISABLE_AVX512IFMA") != nullptr);
 static const bool disable_avx512vbmi2 =
     disable_avx512dq || (std::getenv("HEXL_DISABLE_AVX512VBMI2") != nullptr);
+static const bool disable_avx2 = (std::getenv("HEXL_DISABLE_AVX2") != nullptr);
 
 static const cpu_features::X86Features features =
     cpu_features::GetX86Info().features;
@@ -31,5 +33,23 @@ static const bool has_avx512ifma = features.avx512ifma && !disable_avx512ifma;
 static const bool has_avx512vbmi2 =
     features.avx512vbmi2 && !disable_avx512vbmi2;
 
+static const bool has_avx2 = features.avx2 && !disable_avx2;
+
+// Returns the size in bytes of the data or unified cache at the given level,
+// e.g. 1 for L1d, or 0 if it is unknown
+inline uint64_t GetDataCacheSize(int level) {
+  cpu_features::CacheInfo cache_info = cpu_features::GetX86CacheInfo();
+  for (int i = 0; i < cache_info.size; ++i) {
+    const cpu_features::CacheLevelInfo& info = cache_info.levels[i];
+    if (info.level == level &&
+        (info.cache_type == cpu_features::CPU_FEATURE_CACHE_DATA ||
+         info.cache_type == cpu_features::CPU_FEATURE_CACHE_UNIFIED) &&
+        info.cache_size > 0) {
+      return static_cast<uint64_t>(info.cache_size);
+    }
+  }
+  return 0;
+}
+
 }  // namespace hexl
 }  // namespace intel
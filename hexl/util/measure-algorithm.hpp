@@ -0,0 +1,102 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace intel {
+namespace hexl {
+
+/// @brief Returns whether or not the calling thread is inside an active
+/// OpenMP parallel region. Returns false when built without OpenMP.
+inline bool InOmpParallel() {
+#ifdef _OPENMP
+  return omp_in_parallel() != 0;
+#else
+  return false;
+#endif
+}
+
+/// @brief Fills \p operand1 and \p operand2 with \p n fixed, well-spread
+/// values below \p modulus, used as inputs when timing kernels
+inline void GenerateTimingOperands(uint64_t* operand1, uint64_t* operand2,
+                                   uint64_t n, uint64_t modulus) {
+  for (uint64_t i = 0; i < n; ++i) {
+    operand1[i] = (i * 0x9e3779b97f4a7c15ULL) % modulus;
+    operand2[i] = (i * 0xc2b2ae3d27d4eb4fULL + 1) % modulus;
+  }
+}
+
+/// @brief Times \p run for each of the \p candidates and returns the fastest
+/// @details Each candidate is run once to warm up, then timed as the minimum
+/// over 16 runs. Ties keep the earlier candidate.
+/// @param[in] candidates Non-empty list of algorithms
+/// @param[in] run Callable running the given algorithm once
+template <typename Algorithm, typename Run>
+Algorithm MeasureFastestAlgorithm(const std::vector<Algorithm>& candidates,
+                                  Run run) {
+  constexpr size_t kNumTrials = 16;
+  Algorithm best = candidates.front();
+  auto best_time = std::chrono::steady_clock::duration::max();
+  for (Algorithm candidate : candidates) {
+    // Warm-up
+    run(candidate);
+    auto min_time = std::chrono::steady_clock::duration::max();
+    for (size_t trial = 0; trial < kNumTrials; ++trial) {
+      auto start = std::chrono::steady_clock::now();
+      run(candidate);
+      min_time = std::min(min_time, std::chrono::steady_clock::now() - start);
+    }
+    if (min_time < best_time) {
+      best = candidate;
+      best_time = min_time;
+    }
+  }
+  return best;
+}
+
+/// @brief Caches an algorithm choice which is measured once, on first use
+/// @details Inside an OpenMP parallel region the other threads would skew
+/// the timings, so the measurement is deferred to the first call outside
+/// one; until then, calls return the given fallback.
+template <typename Algorithm>
+class MeasuredAlgorithm {
+ public:
+  /// @brief Returns the measured algorithm, measuring it with \p measure if
+  /// this is the first call outside an OpenMP parallel region, or \p fallback
+  /// if it is not measured yet
+  template <typename Measure>
+  Algorithm Get(Algorithm fallback, Measure measure) {
+    if (m_measured.load(std::memory_order_acquire)) {
+      return m_algorithm;
+    }
+    if (InOmpParallel()) {
+      return fallback;
+    }
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_measured.load(std::memory_order_relaxed)) {
+      m_algorithm = measure();
+      m_measured.store(true, std::memory_order_release);
+    }
+    return m_algorithm;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::atomic<bool> m_measured{false};
+  Algorithm m_algorithm{};
+};
+
+}  // namespace hexl
+}  // namespace intel
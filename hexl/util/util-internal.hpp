@@ -10,9 +10,26 @@
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/util.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace intel {
 namespace hexl {
 
+/// @brief Returns the thread count for an OpenMP parallel region: \p
+/// num_threads, or the OpenMP default if \p num_threads is 0. Returns 1 when
+/// built without OpenMP.
+inline int GetOmpNumThreads(uint64_t num_threads) {
+#ifdef _OPENMP
+  return num_threads == 0 ? omp_get_max_threads()
+                          : static_cast<int>(num_threads);
+#else
+  HEXL_UNUSED(num_threads);
+  return 1;
+#endif
+}
+
 inline bool Compare(CMPINT cmp, uint64_t lhs, uint64_t rhs) {
   switch (cmp) {
     case CMPINT::EQ:
@@ -0,0 +1,289 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "hexl/experimental/fft-like/ckks-encoding.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/experimental/fft-like/fft-like.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/compiler.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Returns the integer-valued x mod modulus
+uint64_t ReduceDouble(double x, uint64_t modulus) {
+  int exponent;
+  double fraction = std::frexp(std::fabs(x), &exponent);
+  uint64_t result;
+  if (exponent <= 63) {
+    result = static_cast<uint64_t>(std::fabs(x)) % modulus;
+  } else {
+    result = static_cast<uint64_t>(std::ldexp(fraction, 53)) % modulus;
+    for (int i = 53; i < exponent; ++i) {
+      result = (2 * result) % modulus;
+    }
+  }
+  return (x < 0 && result != 0) ? modulus - result : result;
+}
+
+// Unfused encoding: inverse FFT like, rounding, reduction, then the NTTs.
+// Rounding to integers is sensitive to the last bit of the coefficients, so
+// this uses the same inverse FFT like implementation as EncodeCKKS.
+std::vector<uint64_t> EncodeCKKSReference(
+    const std::vector<std::complex<double>>& values, double scale,
+    const std::vector<uint64_t>& moduli) {
+  uint64_t n = values.size();
+  FFTLike fft_like(n);
+  std::vector<std::complex<double>> coeffs(n);
+  double fix = scale / static_cast<double>(n);
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 32) {
+    Inverse_FFTLike_FromBitReverseAVX512(
+        reinterpret_cast<double*>(coeffs.data()),
+        reinterpret_cast<const double*>(values.data()),
+        reinterpret_cast<const double*>(
+            fft_like.GetInvComplexRootsOfUnity().data()),
+        n, &fix);
+  } else {
+#else
+  {
+#endif
+    Inverse_FFTLike_FromBitReverseRadix2(
+        coeffs.data(), values.data(),
+        fft_like.GetInvComplexRootsOfUnity().data(), n, &fix);
+  }
+
+  std::vector<uint64_t> result(n * moduli.size());
+  for (size_t k = 0; k < moduli.size(); ++k) {
+    for (size_t i = 0; i < n; ++i) {
+      result[k * n + i] = ReduceDouble(std::round(coeffs[i].real()), moduli[k]);
+    }
+    NTT(n, moduli[k]).ComputeForward(&result[k * n], &result[k * n], 1, 1);
+  }
+  return result;
+}
+
+// Product of the moduli, in moduli.size() words
+std::vector<uint64_t> ProductOfModuli(const std::vector<uint64_t>& moduli) {
+  std::vector<uint64_t> product(moduli.size(), 0);
+  product[0] = 1;
+  for (uint64_t modulus : moduli) {
+    uint64_t carry = 0;
+    for (auto& word : product) {
+      uint64_t prod_hi;
+      uint64_t prod_lo;
+      MultiplyUInt64(word, modulus, &prod_hi, &prod_lo);
+      prod_hi += AddUInt64(prod_lo, carry, &word);
+      carry = prod_hi;
+    }
+  }
+  return product;
+}
+
+// n random coefficients below product, of product.size() words each
+std::vector<uint64_t> RandomComposed(uint64_t n,
+                                     const std::vector<uint64_t>& product) {
+  const uint64_t num_words = product.size();
+  std::vector<uint64_t> composed(n * num_words);
+  for (uint64_t i = 0; i < n; ++i) {
+    for (uint64_t w = 0; w + 1 < num_words; ++w) {
+      composed[i * num_words + w] =
+          GenerateInsecureUniformIntRandomValue(0, UINT64_MAX);
+    }
+    composed[i * num_words + num_words - 1] =
+        GenerateInsecureUniformIntRandomValue(0, product[num_words - 1]);
+  }
+  return composed;
+}
+
+// The plaintext in NTT form with the given composed coefficients
+std::vector<uint64_t> ComposedToNTT(const std::vector<uint64_t>& composed,
+                                    const std::vector<uint64_t>& moduli) {
+  const uint64_t num_words = moduli.size();
+  const uint64_t n = composed.size() / num_words;
+  std::vector<uint64_t> result(n * moduli.size());
+  for (size_t k = 0; k < moduli.size(); ++k) {
+    uint64_t two_pow_64_mod_q =
+        MultiplyMod(1ULL << 32, 1ULL << 32, moduli[k]);
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t residue = 0;
+      for (uint64_t w = num_words; w-- > 0;) {
+        residue = AddUIntMod(MultiplyMod(residue, two_pow_64_mod_q, moduli[k]),
+                             composed[i * num_words + w] % moduli[k],
+                             moduli[k]);
+      }
+      result[k * n + i] = residue;
+    }
+    NTT(n, moduli[k]).ComputeForward(&result[k * n], &result[k * n], 1, 1);
+  }
+  return result;
+}
+
+// Unfused decoding of the composed coefficients: BuildFloatingPoints, then
+// the same forward FFT like implementation as DecodeCKKS
+std::vector<std::complex<double>> DecodeCKKSReference(
+    const std::vector<uint64_t>& composed, double scale,
+    const std::vector<uint64_t>& moduli) {
+  const uint64_t num_words = moduli.size();
+  const uint64_t n = composed.size() / num_words;
+  std::vector<uint64_t> product = ProductOfModuli(moduli);
+  // (product + 1) / 2 for odd product
+  std::vector<uint64_t> threshold(num_words);
+  for (uint64_t w = 0; w < num_words; ++w) {
+    threshold[w] = product[w] >> 1;
+    if (w + 1 < num_words) {
+      threshold[w] |= product[w + 1] << 63;
+    }
+  }
+  for (auto& word : threshold) {
+    if (++word != 0) {
+      break;
+    }
+  }
+
+  FFTLike fft_like(n);
+  std::vector<std::complex<double>> coeffs(n);
+  fft_like.BuildFloatingPoints(coeffs.data(), composed.data(),
+                               threshold.data(), product.data(), 1.0 / scale,
+                               num_words, n);
+  std::vector<std::complex<double>> result(n);
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 32) {
+    Forward_FFTLike_ToBitReverseAVX512(
+        reinterpret_cast<double*>(result.data()),
+        reinterpret_cast<const double*>(coeffs.data()),
+        reinterpret_cast<const double*>(
+            fft_like.GetComplexRootsOfUnity().data()),
+        n);
+  } else {
+#else
+  {
+#endif
+    Forward_FFTLike_ToBitReverseRadix2(
+        result.data(), coeffs.data(), fft_like.GetComplexRootsOfUnity().data(),
+        n);
+  }
+  return result;
+}
+
+std::vector<std::complex<double>> RandomValues(uint64_t n, double bound) {
+  std::vector<std::complex<double>> values(n);
+  for (auto& value : values) {
+    value = std::complex<double>(
+        GenerateInsecureUniformRealRandomValue(-bound, bound),
+        GenerateInsecureUniformRealRandomValue(-bound, bound));
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(EncodeCKKS, matches_unfused) {
+  const double scale = std::pow(2.0, 40);
+  for (uint64_t n : {16, 64, 4096}) {
+    std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+    std::vector<std::complex<double>> values = RandomValues(n, 100);
+    FFTLike fft_like(n);
+
+    std::vector<uint64_t> result(n * moduli.size());
+    EncodeCKKS(result.data(), values.data(), fft_like, scale, moduli.data(),
+               moduli.size());
+    ASSERT_EQ(result, EncodeCKKSReference(values, scale, moduli))
+        << "n " << n;
+  }
+}
+
+// Coefficients of 64 bits or more take the multi-precision reduction
+TEST(EncodeCKKS, large_coefficients) {
+  const uint64_t n = 64;
+  const double scale = std::pow(2.0, 90);
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 60, true, n);
+  std::vector<std::complex<double>> values = RandomValues(n, 1000);
+  FFTLike fft_like(n);
+
+  std::vector<uint64_t> result(n * moduli.size());
+  EncodeCKKS(result.data(), values.data(), fft_like, scale, moduli.data(),
+             moduli.size());
+  ASSERT_EQ(result, EncodeCKKSReference(values, scale, moduli));
+}
+
+TEST(DecodeCKKS, matches_unfused) {
+  const double scale = std::pow(2.0, 40);
+  for (uint64_t n : {16, 64, 4096}) {
+    for (uint64_t num_moduli : {1, 3}) {
+      std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+      std::vector<uint64_t> composed =
+          RandomComposed(n, ProductOfModuli(moduli));
+      std::vector<uint64_t> operand = ComposedToNTT(composed, moduli);
+      FFTLike fft_like(n);
+
+      std::vector<std::complex<double>> result(n);
+      DecodeCKKS(result.data(), operand.data(), fft_like, scale, moduli.data(),
+                 num_moduli);
+      ASSERT_EQ(result, DecodeCKKSReference(composed, scale, moduli))
+          << "n " << n << ", num_moduli " << num_moduli;
+    }
+  }
+}
+
+TEST(DecodeCKKS, encode_round_trip) {
+  const uint64_t n = 1024;
+  const double scale = std::pow(2.0, 40);
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 50, true, n);
+  FFTLike fft_like(n);
+
+  // Values whose inverse FFT like is real, as for slots and their conjugates
+  std::vector<std::complex<double>> coeffs(n);
+  for (auto& coeff : coeffs) {
+    coeff = GenerateInsecureUniformRealRandomValue(-100, 100);
+  }
+  std::vector<std::complex<double>> values(n);
+  fft_like.ComputeForwardFFTLike(values.data(), coeffs.data());
+
+  std::vector<uint64_t> plain(n * moduli.size());
+  EncodeCKKS(plain.data(), values.data(), fft_like, scale, moduli.data(),
+             moduli.size());
+  std::vector<std::complex<double>> result(n);
+  DecodeCKKS(result.data(), plain.data(), fft_like, scale, moduli.data(),
+             moduli.size());
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_NEAR(result[i].real(), values[i].real(), 1e-6) << "i " << i;
+    ASSERT_NEAR(result[i].imag(), values[i].imag(), 1e-6) << "i " << i;
+  }
+}
+
+TEST(DecodeCKKS, num_threads) {
+  const uint64_t n = 1 << 15;
+  const double scale = std::pow(2.0, 40);
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+  std::vector<uint64_t> composed = RandomComposed(n, ProductOfModuli(moduli));
+  std::vector<uint64_t> operand = ComposedToNTT(composed, moduli);
+  std::vector<std::complex<double>> expected =
+      DecodeCKKSReference(composed, scale, moduli);
+  FFTLike fft_like(n);
+
+  uint64_t default_num_threads = GetDecodeCKKSNumThreads();
+  for (uint64_t num_threads : {1, 2, 4}) {
+    SetDecodeCKKSNumThreads(num_threads);
+    ASSERT_EQ(GetDecodeCKKSNumThreads(), num_threads);
+    std::vector<std::complex<double>> result(n);
+    DecodeCKKS(result.data(), operand.data(), fft_like, scale, moduli.data(),
+               moduli.size());
+    ASSERT_EQ(result, expected) << "num_threads " << num_threads;
+  }
+  SetDecodeCKKSNumThreads(default_num_threads);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,9 +3,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <complex>
+#include <vector>
 
 #include "hexl/experimental/fft-like/fft-like-avx512-util.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/util/defines.hpp"
@@ -125,6 +128,100 @@ TEST(FFTLike, BuildFloatingPointsAVX512) {
   }
 }
 
+namespace {
+
+// Random multi-word BuildFloatingPoints inputs. The coefficients are below
+// the decryption modulus and include values at the threshold, just below the
+// decryption modulus and with zero upper words.
+struct BuildFloatingPointsInputs {
+  BuildFloatingPointsInputs(size_t mod_size, size_t coeff_count)
+      : threshold(mod_size), decryption_modulus(mod_size) {
+    for (size_t j = 0; j < mod_size; ++j) {
+      decryption_modulus[j] = GenerateInsecureUniformIntRandomValue(0, ~0ULL);
+    }
+    decryption_modulus[mod_size - 1] =
+        GenerateInsecureUniformIntRandomValue(2, 1ULL << 62);
+    for (size_t j = 0; j < mod_size; ++j) {
+      uint64_t next = (j + 1 < mod_size) ? decryption_modulus[j + 1] : 0;
+      threshold[j] = (decryption_modulus[j] >> 1) | (next << 63);
+    }
+
+    for (size_t i = 0; i < coeff_count; ++i) {
+      std::vector<uint64_t> coeff(mod_size, 0);
+      switch (i % 4) {
+        case 0:  // Uniform below the decryption modulus
+          for (size_t j = 0; j < mod_size; ++j) {
+            coeff[j] = GenerateInsecureUniformIntRandomValue(0, ~0ULL);
+          }
+          coeff[mod_size - 1] = GenerateInsecureUniformIntRandomValue(
+              0, decryption_modulus[mod_size - 1]);
+          break;
+        case 1:  // At the threshold
+          coeff = threshold;
+          break;
+        case 2: {  // Small negative values
+          coeff = decryption_modulus;
+          uint64_t borrow = GenerateInsecureUniformIntRandomValue(1, 1 << 20);
+          for (size_t j = 0; j < mod_size; ++j) {
+            uint64_t word = coeff[j];
+            coeff[j] = word - borrow;
+            borrow = (word < borrow) ? 1 : 0;
+          }
+          break;
+        }
+        default:  // Small positive values
+          coeff[0] = GenerateInsecureUniformIntRandomValue(0, ~0ULL);
+          break;
+      }
+      plain.insert(plain.end(), coeff.begin(), coeff.end());
+    }
+  }
+
+  std::vector<uint64_t> plain;
+  std::vector<uint64_t> threshold;
+  std::vector<uint64_t> decryption_modulus;
+};
+
+}  // namespace
+
+// Native and AVX2 results match the AVX512 ones exactly
+TEST(FFTLike, BuildFloatingPointsMatchesAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  const double inv_scale = 1.0 / 1099511627776;  // 1 / (1 << 40)
+  const size_t coeff_count = 64;
+
+  for (size_t mod_size : {1, 2, 3, 4, 5, 8}) {
+    BuildFloatingPointsInputs in(mod_size, coeff_count);
+    std::vector<std::complex<double>> expected(coeff_count);
+    BuildFloatingPointsAVX512(&reinterpret_cast<double(&)[2]>(expected[0])[0],
+                              in.plain.data(), in.threshold.data(),
+                              in.decryption_modulus.data(), inv_scale,
+                              mod_size, coeff_count);
+
+    std::vector<std::complex<double>> native(coeff_count);
+    BuildFloatingPointsNative(native.data(), in.plain.data(),
+                              in.threshold.data(), in.decryption_modulus.data(),
+                              inv_scale, mod_size, coeff_count);
+    ASSERT_EQ(expected, native) << "mod_size " << mod_size;
+
+#ifdef HEXL_HAS_AVX256
+    if (has_avx2) {
+      // An odd count also runs the native tail
+      size_t avx2_count = coeff_count - 3;
+      std::vector<std::complex<double>> avx2(avx2_count);
+      BuildFloatingPointsAVX2(&reinterpret_cast<double(&)[2]>(avx2[0])[0],
+                              in.plain.data(), in.threshold.data(),
+                              in.decryption_modulus.data(), inv_scale,
+                              mod_size, avx2_count);
+      expected.resize(avx2_count);
+      ASSERT_EQ(expected, avx2) << "mod_size " << mod_size;
+    }
+#endif
+  }
+}
+
 TEST(FFTLike, ComplexLoadFwdInterleavedT1AVX512) {
   if (!has_avx512dq) {
     GTEST_SKIP();
@@ -346,7 +443,7 @@ TEST(FFTLike, ForwardInverseFFTLikeAVX512) {
     GTEST_SKIP();
   }
 
-  FFTLike fft_like(64, nullptr);
+  FFTLike fft_like(64);
   AlignedVector64<std::complex<double>> root_powers =
       fft_like.GetComplexRootsOfUnity();
   AlignedVector64<std::complex<double>> inv_root_powers =
@@ -527,7 +624,7 @@ TEST(FFTLike, ForwardInverseFFTLikeAVX512) {
     const double inv_scale = 1.0 / scale;
     const double data_bound = (1 << 30);
 
-    FFTLike big_fft_like(n, nullptr);
+    FFTLike big_fft_like(n);
     AlignedVector64<std::complex<double>> big_root_powers =
         big_fft_like.GetComplexRootsOfUnity();
     AlignedVector64<std::complex<double>> big_inv_root_powers =
@@ -557,6 +654,174 @@ TEST(FFTLike, ForwardInverseFFTLikeAVX512) {
   }
 }
 
+TEST(FFTLike, FFTLikeRadix4AVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  const double scale = 1 << 16;
+  // Breadth-first sizes and each level of the depth-first recursion
+  for (uint64_t n : {16, 32, 64, 1024, 2048, 4096, 16384}) {
+    FFTLike fft_like(n);
+    const double* roots = &(reinterpret_cast<const double(&)[2]>(
+        fft_like.GetComplexRootsOfUnity()[0]))[0];
+    const double* inv_roots = &(reinterpret_cast<const double(&)[2]>(
+        fft_like.GetInvComplexRootsOfUnity()[0]))[0];
+
+    AlignedVector64<std::complex<double>> operand(n);
+    for (auto& value : operand) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+    const double* operand_cmplx_intrlvd =
+        &(reinterpret_cast<const double(&)[2]>(operand[0]))[0];
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      // Radix-4 rounds differently, within a small multiple of
+      // log2(n) * 2^-53 times the sum of the absolute input values
+      const double tolerance =
+          4 * Log2(n) * std::ldexp(2.0 * n, -53) * (scalar ? scale : 1.0);
+      AlignedVector64<std::complex<double>> expected(n);
+      AlignedVector64<std::complex<double>> result(n);
+      double* result_cmplx_intrlvd =
+          &(reinterpret_cast<double(&)[2]>(result[0]))[0];
+
+      Forward_FFTLike_ToBitReverseRadix2(
+          expected.data(), operand.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+      Forward_FFTLike_ToBitReverseRadix4AVX512(
+          result_cmplx_intrlvd, operand_cmplx_intrlvd, roots, n, scalar);
+      CheckClose(result, expected, tolerance);
+
+      Inverse_FFTLike_FromBitReverseRadix2(
+          expected.data(), operand.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      Inverse_FFTLike_FromBitReverseRadix4AVX512(
+          result_cmplx_intrlvd, operand_cmplx_intrlvd, inv_roots, n, scalar);
+      CheckClose(result, expected, tolerance);
+    }
+  }
+}
+
+TEST(FFTLike, FFTLikeSlotsAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  const double scale = 1 << 16;
+  for (uint64_t n : {32, 64, 128, 1024, 2048, 4096, 16384}) {
+    FFTLike fft_like(n);
+    const uint64_t half_n = n / 2;
+    const uint64_t* slot_index = fft_like.GetSlotIndex().data();
+    const uint64_t* slot_positions = fft_like.GetSlotPositions().data();
+    // Slot values in the first half of the bit-reversed input, conjugates at
+    // the complementary positions in the second half
+    AlignedVector64<std::complex<double>> slots(half_n);
+    for (auto& value : slots) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+    AlignedVector64<std::complex<double>> expanded(n);
+    for (uint64_t j = 0; j < half_n; ++j) {
+      expanded[j] = slots[slot_index[j]];
+      expanded[n - 1 - j] = std::conj(slots[slot_index[j]]);
+    }
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      const double tolerance =
+          4 * Log2(n) * std::ldexp(2.0 * n, -53) * (scalar ? scale : 1.0);
+      AlignedVector64<std::complex<double>> expected(n);
+      AlignedVector64<std::complex<double>> result(n);
+      AlignedVector64<std::complex<double>> buffer(half_n);
+
+      Inverse_FFTLike_FromBitReverseRadix2(
+          expected.data(), expanded.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      Inverse_FFTLike_FromSlotsAVX512(
+          &(reinterpret_cast<double(&)[2]>(result[0]))[0],
+          &(reinterpret_cast<const double(&)[2]>(slots[0]))[0],
+          &(reinterpret_cast<const double(&)[2]>(
+              fft_like.GetInvComplexRootsOfUnity()[0]))[0],
+          slot_index, n, scalar);
+      CheckClose(result, expected, tolerance);
+
+      Forward_FFTLike_ToBitReverseRadix2(
+          expected.data(), expanded.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+      AlignedVector64<std::complex<double>> expected_slots(half_n);
+      for (uint64_t j = 0; j < half_n; ++j) {
+        expected_slots[slot_index[j]] = expected[j];
+      }
+      result.resize(half_n);
+      Forward_FFTLike_ToSlotsAVX512(
+          &(reinterpret_cast<double(&)[2]>(result[0]))[0],
+          &(reinterpret_cast<const double(&)[2]>(expanded[0]))[0],
+          &(reinterpret_cast<const double(&)[2]>(
+              fft_like.GetComplexRootsOfUnity()[0]))[0],
+          slot_positions, n, scalar,
+          &(reinterpret_cast<double(&)[2]>(buffer[0]))[0]);
+      CheckClose(result, expected_slots, tolerance);
+    }
+  }
+}
+
+TEST(FFTLike, FFTLikeRadix4ParallelAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  const double scale = 1 << 16;
+  // Serial fallback, then leaves at depth 1, 3 and 5
+  for (uint64_t n : {1024, 4096, 1 << 16, 1 << 17}) {
+    FFTLike fft_like(n);
+    const double* roots = &(reinterpret_cast<const double(&)[2]>(
+        fft_like.GetComplexRootsOfUnity()[0]))[0];
+    const double* inv_roots = &(reinterpret_cast<const double(&)[2]>(
+        fft_like.GetInvComplexRootsOfUnity()[0]))[0];
+
+    AlignedVector64<std::complex<double>> operand(n);
+    for (auto& value : operand) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+    const double* operand_cmplx_intrlvd =
+        &(reinterpret_cast<const double(&)[2]>(operand[0]))[0];
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      AlignedVector64<std::complex<double>> fwd_expected(n);
+      AlignedVector64<std::complex<double>> inv_expected(n);
+      Forward_FFTLike_ToBitReverseRadix4AVX512(
+          &(reinterpret_cast<double(&)[2]>(fwd_expected[0]))[0],
+          operand_cmplx_intrlvd, roots, n, scalar);
+      Inverse_FFTLike_FromBitReverseRadix4AVX512(
+          &(reinterpret_cast<double(&)[2]>(inv_expected[0]))[0],
+          operand_cmplx_intrlvd, inv_roots, n, scalar);
+
+      for (uint64_t num_threads : {1, 2, 3, 4, 8, 32}) {
+        AlignedVector64<std::complex<double>> result(n);
+        double* result_cmplx_intrlvd =
+            &(reinterpret_cast<double(&)[2]>(result[0]))[0];
+
+        Forward_FFTLike_ToBitReverseRadix4ParallelAVX512(
+            result_cmplx_intrlvd, operand_cmplx_intrlvd, roots, n, scalar,
+            num_threads);
+        ASSERT_EQ(result, fwd_expected)
+            << "n " << n << " num_threads " << num_threads;
+
+        Inverse_FFTLike_FromBitReverseRadix4ParallelAVX512(
+            result_cmplx_intrlvd, operand_cmplx_intrlvd, inv_roots, n, scalar,
+            num_threads);
+        ASSERT_EQ(result, inv_expected)
+            << "n " << n << " num_threads " << num_threads;
+      }
+    }
+  }
+}
+
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
@@ -0,0 +1,97 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like-cache.hpp"
+#include "hexl/experimental/fft-like/fft-like.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(FFTLikeCache, lookup) {
+  uint64_t n = 64;
+  double scale = 1.0 / n;
+
+  const FFTLike& fft_like = GetFFTLike(n);
+  EXPECT_EQ(fft_like.GetDegree(), n);
+  EXPECT_EQ(&GetFFTLike(n), &fft_like);
+  EXPECT_EQ(GetFFTLikeShared(n).get(), &fft_like);
+  EXPECT_NE(&GetFFTLike(2 * n), &fft_like);
+
+  // Matches an FFTLike constructed directly
+  FFTLike expected(n);
+  EXPECT_EQ(fft_like.GetComplexRootsOfUnity(),
+            expected.GetComplexRootsOfUnity());
+  EXPECT_EQ(fft_like.GetInvComplexRootsOfUnity(),
+            expected.GetInvComplexRootsOfUnity());
+
+  std::vector<std::complex<double>> operand(n);
+  for (auto& value : operand) {
+    value = std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                                 GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  std::vector<std::complex<double>> result(n);
+  std::vector<std::complex<double>> expected_result(n);
+  fft_like.ComputeInverseFFTLike(result.data(), operand.data(), &scale);
+  expected.ComputeInverseFFTLike(expected_result.data(), operand.data(),
+                                 &scale);
+  EXPECT_EQ(result, expected_result);
+}
+
+TEST(FFTLikeCache, prewarm_and_clear) {
+  uint64_t n = 128;
+  ClearFFTLikeCache();
+  EXPECT_EQ(GetFFTLikeCacheSize(), 0ULL);
+
+  PrewarmFFTLikeCache({n, 2 * n, 4 * n});
+  EXPECT_EQ(GetFFTLikeCacheSize(), 3ULL);
+  std::shared_ptr<const FFTLike> first = GetFFTLikeShared(n);
+  EXPECT_EQ(GetFFTLikeCacheSize(), 3ULL);
+
+  // The shared pointer keeps the FFTLike alive after clearing the cache
+  ClearFFTLikeCache();
+  EXPECT_EQ(GetFFTLikeCacheSize(), 0ULL);
+  EXPECT_EQ(first->GetDegree(), n);
+  EXPECT_NE(GetFFTLikeShared(n), first);
+  EXPECT_EQ(GetFFTLikeCacheSize(), 1ULL);
+  ClearFFTLikeCache();
+}
+
+// Concurrent lookups from several threads agree on one FFTLike per key
+TEST(FFTLikeCache, threads) {
+  std::vector<uint64_t> degrees{16, 256, 4096};
+  size_t num_threads = 4;
+  std::vector<std::vector<const FFTLike*>> fft_likes(num_threads);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t rep = 0; rep < 100; ++rep) {
+        for (uint64_t degree : degrees) {
+          const FFTLike& fft_like = GetFFTLike(degree);
+          if (rep == 0) {
+            fft_likes[t].push_back(&fft_like);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 1; t < num_threads; ++t) {
+    EXPECT_EQ(fft_likes[t], fft_likes[0]);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
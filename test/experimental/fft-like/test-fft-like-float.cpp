@@ -0,0 +1,290 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+#include "hexl/experimental/fft-like/fft-like-float-avx512.hpp"
+#include "hexl/experimental/fft-like/fft-like-float.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/experimental/fft-like/fft-like.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+std::vector<std::complex<double>> RandomComplexVector(uint64_t n) {
+  std::vector<std::complex<double>> values(n);
+  for (auto& value : values) {
+    value = std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                                 GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+  return values;
+}
+
+// Checks the documented bounds of FFTLikeFloat against the double precision
+// result: the maximum error is below 4 * log2(n) * 2^-24 times the sum of the
+// absolute input values, and the root mean square error is below
+// 4 * sqrt(log2(n)) * 2^-24 times the root mean square of the output values.
+// Inputs in [-1, 1] + [-1, 1]i sum to at most 2n in absolute value.
+template <typename Complex>
+void CheckFloatError(const std::vector<Complex>& result,
+                     const std::vector<std::complex<double>>& expected,
+                     double scale) {
+  const uint64_t n = expected.size();
+  const double log_n = static_cast<double>(Log2(n));
+  double max_error = 0;
+  double sum_sq_error = 0;
+  double sum_sq_expected = 0;
+  for (size_t i = 0; i < n; ++i) {
+    std::complex<double> value(result[i].real(), result[i].imag());
+    double error = std::abs(value - expected[i]);
+    max_error = std::max(max_error, error);
+    sum_sq_error += error * error;
+    sum_sq_expected += std::norm(expected[i]);
+  }
+  EXPECT_LE(max_error, 4 * log_n * std::ldexp(2.0 * n, -24) * scale);
+  EXPECT_LE(std::sqrt(sum_sq_error),
+            4 * std::sqrt(log_n) * std::ldexp(std::sqrt(sum_sq_expected), -24));
+}
+
+void CheckCloseFloat(const std::vector<std::complex<float>>& x,
+                     const std::vector<std::complex<float>>& y,
+                     float tolerance) {
+  ASSERT_EQ(x.size(), y.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_LE(std::abs(x[i] - y[i]), tolerance) << "Mismatch at index " << i;
+  }
+}
+
+}  // namespace
+
+TEST(FFTLikeFloat, roots_of_unity) {
+  uint64_t n = 64;
+  FFTLike fft_like(n);
+  FFTLikeFloat fft_like_float(n);
+  EXPECT_EQ(fft_like_float.GetDegree(), n);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(fft_like_float.GetComplexRootsOfUnity()[i],
+              std::complex<float>(fft_like.GetComplexRootOfUnity(i)));
+    EXPECT_EQ(fft_like_float.GetInvComplexRootsOfUnity()[i],
+              std::complex<float>(fft_like.GetInvComplexRootOfUnity(i)));
+  }
+}
+
+TEST(FFTLikeFloat, float) {
+  for (uint64_t n : {16, 32, 64, 128, 256, 4096, 1 << 15}) {
+    SCOPED_TRACE(n);
+    FFTLike fft_like(n);
+    FFTLikeFloat fft_like_float(n);
+    std::vector<std::complex<double>> operand = RandomComplexVector(n);
+    std::vector<std::complex<float>> operand_float(operand.begin(),
+                                                   operand.end());
+
+    // Decoding and encoding scales with a small CKKS scale
+    const double decode_scale = std::ldexp(1.0, -20);
+    const double encode_scale = std::ldexp(1.0, 20) / static_cast<double>(n);
+    const float decode_scale_float = static_cast<float>(decode_scale);
+    const float encode_scale_float = static_cast<float>(encode_scale);
+
+    std::vector<std::complex<double>> expected(n);
+    std::vector<std::complex<float>> result(n);
+
+    fft_like.ComputeForwardFFTLike(expected.data(), operand.data());
+    fft_like_float.ComputeForwardFFTLike(result.data(), operand_float.data());
+    CheckFloatError(result, expected, 1.0);
+
+    fft_like.ComputeForwardFFTLike(expected.data(), operand.data(),
+                                   &decode_scale);
+    fft_like_float.ComputeForwardFFTLike(result.data(), operand_float.data(),
+                                         &decode_scale_float);
+    CheckFloatError(result, expected, decode_scale);
+
+    fft_like.ComputeInverseFFTLike(expected.data(), operand.data(),
+                                   &encode_scale);
+    fft_like_float.ComputeInverseFFTLike(result.data(), operand_float.data(),
+                                         &encode_scale_float);
+    CheckFloatError(result, expected, encode_scale);
+
+    // The inverse undoes the forward transform up to the same bounds
+    std::vector<std::complex<float>> round_trip(n);
+    const float inv_n = 1.0f / static_cast<float>(n);
+    fft_like_float.ComputeForwardFFTLike(result.data(), operand_float.data());
+    fft_like_float.ComputeInverseFFTLike(round_trip.data(), result.data(),
+                                         &inv_n);
+    CheckFloatError(round_trip, operand, 1.0);
+  }
+}
+
+TEST(FFTLikeFloat, mixed) {
+  for (uint64_t n : {16, 32, 64, 128, 256, 4096, 1 << 15}) {
+    SCOPED_TRACE(n);
+    FFTLike fft_like(n);
+    FFTLikeFloat fft_like_float(n);
+    std::vector<std::complex<double>> operand = RandomComplexVector(n);
+
+    // Decoding and encoding scales with a CKKS scale of 2^40, which does not
+    // fit the float precision of the other stages
+    const double decode_scale = std::ldexp(1.0, -40);
+    const double encode_scale = std::ldexp(1.0, 40) / static_cast<double>(n);
+
+    std::vector<std::complex<double>> expected(n);
+    std::vector<std::complex<double>> result(n);
+
+    fft_like.ComputeForwardFFTLike(expected.data(), operand.data());
+    fft_like_float.ComputeForwardFFTLikeMixed(result.data(), operand.data());
+    CheckFloatError(result, expected, 1.0);
+
+    fft_like.ComputeForwardFFTLike(expected.data(), operand.data(),
+                                   &decode_scale);
+    fft_like_float.ComputeForwardFFTLikeMixed(result.data(), operand.data(),
+                                              &decode_scale);
+    CheckFloatError(result, expected, decode_scale);
+
+    fft_like.ComputeInverseFFTLike(expected.data(), operand.data());
+    fft_like_float.ComputeInverseFFTLikeMixed(result.data(), operand.data());
+    CheckFloatError(result, expected, 1.0);
+
+    fft_like.ComputeInverseFFTLike(expected.data(), operand.data(),
+                                   &encode_scale);
+    fft_like_float.ComputeInverseFFTLikeMixed(result.data(), operand.data(),
+                                              &encode_scale);
+    CheckFloatError(result, expected, encode_scale);
+  }
+}
+
+// The native, AVX2 and AVX512 kernels agree up to rounding, with and without
+// the final stage
+TEST(FFTLikeFloat, kernels) {
+  for (uint64_t n : {16, 32, 64, 128, 512, 2048}) {
+    FFTLikeFloat fft_like_float(n);
+    const std::complex<float>* roots =
+        fft_like_float.GetComplexRootsOfUnity().data();
+    const std::complex<float>* inv_roots =
+        fft_like_float.GetInvComplexRootsOfUnity().data();
+    std::vector<std::complex<double>> operand_double = RandomComplexVector(n);
+    std::vector<std::complex<float>> operand(operand_double.begin(),
+                                             operand_double.end());
+    const float scale = 0.25f;
+    const float tolerance = 4 * Log2(n) * std::ldexp(2.0f * n, -24);
+
+    for (bool skip_final_stage : {false, true}) {
+      SCOPED_TRACE(n * 2 + skip_final_stage);
+      std::vector<std::complex<float>> fwd_native(n);
+      std::vector<std::complex<float>> inv_native(n);
+      Forward_FFTLike_ToBitReverseFloat(fwd_native.data(), operand.data(),
+                                        roots, n, &scale, skip_final_stage);
+      Inverse_FFTLike_FromBitReverseFloat(inv_native.data(), operand.data(),
+                                          inv_roots, n, &scale,
+                                          skip_final_stage);
+
+      std::vector<std::complex<float>> fwd(n);
+      std::vector<std::complex<float>> inv(n);
+#ifdef HEXL_HAS_AVX512DQ
+      if (has_avx512dq && n >= 32) {
+        Forward_FFTLike_ToBitReverseFloatAVX512(
+            &reinterpret_cast<float(&)[2]>(fwd[0])[0],
+            &reinterpret_cast<const float(&)[2]>(operand[0])[0],
+            &reinterpret_cast<const float(&)[2]>(roots[0])[0], n, &scale,
+            skip_final_stage);
+        Inverse_FFTLike_FromBitReverseFloatAVX512(
+            &reinterpret_cast<float(&)[2]>(inv[0])[0],
+            &reinterpret_cast<const float(&)[2]>(operand[0])[0],
+            &reinterpret_cast<const float(&)[2]>(inv_roots[0])[0], n, &scale,
+            skip_final_stage);
+        CheckCloseFloat(fwd, fwd_native, tolerance);
+        CheckCloseFloat(inv, inv_native, tolerance);
+      }
+#endif
+#ifdef HEXL_HAS_AVX256
+      if (has_avx2) {
+        Forward_FFTLike_ToBitReverseFloatAVX2(
+            &reinterpret_cast<float(&)[2]>(fwd[0])[0],
+            &reinterpret_cast<const float(&)[2]>(operand[0])[0],
+            &reinterpret_cast<const float(&)[2]>(roots[0])[0], n, &scale,
+            skip_final_stage);
+        Inverse_FFTLike_FromBitReverseFloatAVX2(
+            &reinterpret_cast<float(&)[2]>(inv[0])[0],
+            &reinterpret_cast<const float(&)[2]>(operand[0])[0],
+            &reinterpret_cast<const float(&)[2]>(inv_roots[0])[0], n, &scale,
+            skip_final_stage);
+        CheckCloseFloat(fwd, fwd_native, tolerance);
+        CheckCloseFloat(inv, inv_native, tolerance);
+      }
+#endif
+    }
+  }
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+
+// The AVX512 mixed precision kernels agree with the native single precision
+// stages followed by the double precision final stage
+TEST(FFTLikeFloat, MixedAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {32, 64, 128, 1024}) {
+    SCOPED_TRACE(n);
+    FFTLikeFloat fft_like_float(n);
+    FFTLike fft_like(n);
+    std::vector<std::complex<double>> operand = RandomComplexVector(n);
+    std::vector<std::complex<float>> operand_float(operand.begin(),
+                                                   operand.end());
+    const double scale = std::ldexp(1.0, -40);
+    const double tolerance = 4 * Log2(n) * std::ldexp(2.0 * n, -24) * scale;
+
+    std::vector<std::complex<float>> buffer(n);
+    std::vector<std::complex<double>> expected(n);
+    std::vector<std::complex<double>> result(n);
+
+    Forward_FFTLike_ToBitReverseFloat(
+        buffer.data(), operand_float.data(),
+        fft_like_float.GetComplexRootsOfUnity().data(), n, nullptr, true);
+    Forward_FFTLike_FinalStageMixed(expected.data(), buffer.data(),
+                                    fft_like.GetComplexRootsOfUnity().data(),
+                                    n, &scale);
+    Forward_FFTLike_ToBitReverseMixedAVX512(
+        &reinterpret_cast<double(&)[2]>(result[0])[0],
+        &reinterpret_cast<const double(&)[2]>(operand[0])[0],
+        &reinterpret_cast<const float(&)[2]>(
+            fft_like_float.GetComplexRootsOfUnity()[0])[0],
+        &reinterpret_cast<const double(&)[2]>(
+            fft_like.GetComplexRootsOfUnity()[0])[0],
+        n, &scale, &reinterpret_cast<float(&)[2]>(buffer[0])[0]);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_LE(std::abs(result[i] - expected[i]), tolerance);
+    }
+
+    Inverse_FFTLike_FromBitReverseFloat(
+        buffer.data(), operand_float.data(),
+        fft_like_float.GetInvComplexRootsOfUnity().data(), n, nullptr, true);
+    Inverse_FFTLike_FinalStageMixed(expected.data(), buffer.data(),
+                                    fft_like.GetInvComplexRootsOfUnity().data(),
+                                    n, &scale);
+    Inverse_FFTLike_FromBitReverseMixedAVX512(
+        &reinterpret_cast<double(&)[2]>(result[0])[0],
+        &reinterpret_cast<const double(&)[2]>(operand[0])[0],
+        &reinterpret_cast<const float(&)[2]>(
+            fft_like_float.GetInvComplexRootsOfUnity()[0])[0],
+        &reinterpret_cast<const double(&)[2]>(
+            fft_like.GetInvComplexRootsOfUnity()[0])[0],
+        n, &scale, &reinterpret_cast<float(&)[2]>(buffer[0])[0]);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_LE(std::abs(result[i] - expected[i]), tolerance);
+    }
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,7 +3,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <complex>
+#include <vector>
 
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
@@ -17,7 +19,7 @@ namespace intel {
 namespace hexl {
 
 TEST(FFTLike, ForwardInverseFFTLikeNative) {
-  FFTLike fft_like(64, nullptr);
+  FFTLike fft_like(64);
   AlignedVector64<std::complex<double>> root_powers =
       fft_like.GetComplexRootsOfUnity();
   AlignedVector64<std::complex<double>> inv_root_powers =
@@ -191,5 +193,175 @@ TEST(FFTLike, ForwardInverseFFTLikeNative) {
   }
 }
 
+TEST(FFTLike, FFTLikeBatchNative) {
+  const uint64_t batch_size = 5;
+  const double scale = 1 << 16;
+  for (uint64_t n : {16, 64, 1024}) {
+    FFTLike fft_like(n);
+    AlignedVector64<std::complex<double>> operand(batch_size * n);
+    for (auto& value : operand) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      // The compiler may fuse different multiply-adds in the batched
+      // kernels, so results can differ in the last bits
+      const double tolerance = 1e-12 * n * (scalar ? scale : 1.0);
+      AlignedVector64<std::complex<double>> fwd_expected(batch_size * n);
+      AlignedVector64<std::complex<double>> inv_expected(batch_size * n);
+      for (uint64_t b = 0; b < batch_size; ++b) {
+        Forward_FFTLike_ToBitReverseRadix2(
+            &fwd_expected[b * n], &operand[b * n],
+            fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+        Inverse_FFTLike_FromBitReverseRadix2(
+            &inv_expected[b * n], &operand[b * n],
+            fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      }
+
+      AlignedVector64<std::complex<double>> result(batch_size * n);
+      Forward_FFTLike_ToBitReverseRadix2Batch(
+          result.data(), operand.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, batch_size, scalar);
+      CheckClose(result, fwd_expected, tolerance);
+      Inverse_FFTLike_FromBitReverseRadix2Batch(
+          result.data(), operand.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, batch_size, scalar);
+      CheckClose(result, inv_expected, tolerance);
+    }
+  }
+}
+
+TEST(FFTLike, FFTLikeRadix4Native) {
+  const double scale = 1 << 16;
+  // Both odd and even numbers of stages
+  for (uint64_t n : {16, 32, 64, 128, 1024, 2048}) {
+    FFTLike fft_like(n);
+    AlignedVector64<std::complex<double>> operand(n);
+    for (auto& value : operand) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      // Radix-4 rounds differently, within a small multiple of
+      // log2(n) * 2^-53 times the sum of the absolute input values
+      const double tolerance =
+          4 * Log2(n) * std::ldexp(2.0 * n, -53) * (scalar ? scale : 1.0);
+      AlignedVector64<std::complex<double>> expected(n);
+      AlignedVector64<std::complex<double>> result(n);
+
+      Forward_FFTLike_ToBitReverseRadix2(
+          expected.data(), operand.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+      Forward_FFTLike_ToBitReverseRadix4(
+          result.data(), operand.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+      CheckClose(result, expected, tolerance);
+
+      Inverse_FFTLike_FromBitReverseRadix2(
+          expected.data(), operand.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      Inverse_FFTLike_FromBitReverseRadix4(
+          result.data(), operand.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      CheckClose(result, expected, tolerance);
+    }
+
+    // In place round trip
+    const double inv_n = 1.0 / static_cast<double>(n);
+    AlignedVector64<std::complex<double>> result(operand);
+    Inverse_FFTLike_FromBitReverseRadix4(
+        result.data(), result.data(),
+        fft_like.GetInvComplexRootsOfUnity().data(), n, &inv_n);
+    Forward_FFTLike_ToBitReverseRadix4(result.data(), result.data(),
+                                       fft_like.GetComplexRootsOfUnity().data(),
+                                       n, nullptr);
+    CheckClose(result, operand, 1e-12);
+  }
+}
+
+TEST(FFTLike, FFTLikeSlotsNative) {
+  const double scale = 1 << 16;
+  for (uint64_t n : {16, 32, 64, 128, 1024, 2048}) {
+    FFTLike fft_like(n);
+    const uint64_t half_n = n / 2;
+    const uint64_t* slot_index = fft_like.GetSlotIndex().data();
+    const uint64_t* slot_positions = fft_like.GetSlotPositions().data();
+    // Slot values in the first half of the bit-reversed input, conjugates at
+    // the complementary positions in the second half
+    AlignedVector64<std::complex<double>> slots(half_n);
+    for (auto& value : slots) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+    AlignedVector64<std::complex<double>> expanded(n);
+    for (uint64_t j = 0; j < half_n; ++j) {
+      expanded[j] = slots[slot_index[j]];
+      expanded[n - 1 - j] = std::conj(slots[slot_index[j]]);
+    }
+
+    for (const double* scalar : {static_cast<const double*>(nullptr), &scale}) {
+      const double tolerance =
+          4 * Log2(n) * std::ldexp(2.0 * n, -53) * (scalar ? scale : 1.0);
+      AlignedVector64<std::complex<double>> expected(n);
+      AlignedVector64<std::complex<double>> result(n);
+      AlignedVector64<std::complex<double>> buffer(half_n);
+
+      Inverse_FFTLike_FromBitReverseRadix2(
+          expected.data(), expanded.data(),
+          fft_like.GetInvComplexRootsOfUnity().data(), n, scalar);
+      Inverse_FFTLike_FromSlots(result.data(), slots.data(),
+                                fft_like.GetInvComplexRootsOfUnity().data(),
+                                slot_index, n, scalar);
+      CheckClose(result, expected, tolerance);
+
+      Forward_FFTLike_ToBitReverseRadix2(
+          expected.data(), expanded.data(),
+          fft_like.GetComplexRootsOfUnity().data(), n, scalar);
+      AlignedVector64<std::complex<double>> expected_slots(half_n);
+      for (uint64_t j = 0; j < half_n; ++j) {
+        expected_slots[slot_index[j]] = expected[j];
+      }
+      result.resize(half_n);
+      Forward_FFTLike_ToSlots(result.data(), expanded.data(),
+                              fft_like.GetComplexRootsOfUnity().data(),
+                              slot_positions, n, scalar, buffer.data());
+      CheckClose(result, expected_slots, tolerance);
+    }
+  }
+}
+
+TEST(FFTLike, BuildFloatingPointsNative) {
+  {  // Single word, coefficients at or above the threshold are negative
+    const uint64_t plain[] = {0, 1, 48, 49, 96};
+    const uint64_t threshold[] = {49};
+    const uint64_t decryption_modulus[] = {97};
+    std::vector<std::complex<double>> result(5);
+    std::vector<std::complex<double>> expected{
+        {0, 0}, {0.5, 0}, {24, 0}, {-24, 0}, {-0.5, 0}};
+
+    BuildFloatingPointsNative(result.data(), plain, threshold,
+                              decryption_modulus, 0.5, 1, 5);
+    ASSERT_EQ(expected, result);
+  }
+  {  // Two words, decryption modulus 2 * 2^64 + 3
+    const uint64_t plain[] = {1, 1, 2, 1, 0, 0};
+    const uint64_t threshold[] = {2, 1};
+    const uint64_t decryption_modulus[] = {3, 2};
+    const double two_pow_64 = 18446744073709551616.0;
+    std::vector<std::complex<double>> result(3);
+    std::vector<std::complex<double>> expected{
+        {two_pow_64, 0}, {-two_pow_64, 0}, {0, 0}};
+
+    BuildFloatingPointsNative(result.data(), plain, threshold,
+                              decryption_modulus, 1.0, 2, 3);
+    ASSERT_EQ(expected, result);
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -3,12 +3,18 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <complex>
+#include <thread>
+#include <vector>
+
 #include "hexl/experimental/fft-like/fft-like.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/util/defines.hpp"
 #include "ntt/ntt-internal.hpp"
 #include "test/test-util.hpp"
 #include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -19,11 +25,11 @@ TEST(FFTLike, bad_input) {
   double scalar = 1.0;
   AlignedVector64<std::complex<double>> input(N, {0, 0});
 
-  EXPECT_ANY_THROW(FFTLike fft_like(2, nullptr));
-  EXPECT_ANY_THROW(FFTLike fft_like(17, nullptr));
-  EXPECT_NO_THROW(FFTLike fft_like(16, nullptr));
+  EXPECT_ANY_THROW(FFTLike fft_like(2));
+  EXPECT_ANY_THROW(FFTLike fft_like(17));
+  EXPECT_NO_THROW(FFTLike fft_like(16));
 
-  FFTLike fft_like(N, nullptr);
+  FFTLike fft_like(N);
 
   // Forward transform
   // Bad input
@@ -51,7 +57,7 @@ TEST(FFTLike, bad_input) {
 
 TEST(FFTLike, RootsOfUnityNative) {
   {
-    FFTLike myfft_like(16, nullptr);
+    FFTLike myfft_like(16);
     ASSERT_EQ(std::complex<double>(0, 0), myfft_like.GetComplexRootOfUnity(0));
     ASSERT_EQ(std::complex<double>(-0.38268343236508978, 0.92387953251128674),
               myfft_like.GetComplexRootOfUnity(5));
@@ -65,7 +71,7 @@ TEST(FFTLike, RootsOfUnityNative) {
 TEST(FFTLike, RootsOfUnityNative2) {
   uint64_t N = 16;
 
-  FFTLike fft_like(N, nullptr);
+  FFTLike fft_like(N);
 
   EXPECT_EQ(fft_like.GetDegree(), N);
   EXPECT_EQ(fft_like.GetInvComplexRootOfUnity(0),
@@ -136,7 +142,6 @@ TEST(FFTLike, fft_like_with_allocator) {
   }
   AlignedVector64<std::complex<double>> input2 = input1;
   AlignedVector64<std::complex<double>> input3 = input1;
-  AlignedVector64<std::complex<double>> input4 = input1;
   AlignedVector64<std::complex<double>> exp_out = input1;
 
   {
@@ -144,31 +149,220 @@ TEST(FFTLike, fft_like_with_allocator) {
     double scalar = 1 << 16;
     double scale = scalar / static_cast<double>(N);
     double inv_scale = 1.0 / scalar;
-    FFTLike fft_like1(N, nullptr);
-    FFTLike fft_like2(N, &scalar);
-    FFTLike fft_like3(N, &scalar, std::move(a));
+    FFTLike fft_like1(N);
+    FFTLike fft_like2(N, std::move(a));
 
     std::allocator<int> s;
-    FFTLike fft_like4(N, &scalar, std::move(s));
+    FFTLike fft_like3(N, std::move(s));
 
     fft_like1.ComputeForwardFFTLike(input1.data(), input1.data(), &inv_scale);
     fft_like1.ComputeInverseFFTLike(input1.data(), input1.data(), &scale);
-    fft_like2.ComputeForwardFFTLike(input2.data(), input2.data());
-    fft_like2.ComputeInverseFFTLike(input2.data(), input2.data());
 
     ASSERT_NE(allocators::CustomAllocatorFFTLike::number_allocations, 0);
 
-    fft_like3.ComputeForwardFFTLike(input3.data(), input3.data());
-    fft_like3.ComputeInverseFFTLike(input3.data(), input3.data());
-    fft_like4.ComputeForwardFFTLike(input4.data(), input4.data(), &inv_scale);
-    fft_like4.ComputeInverseFFTLike(input4.data(), input4.data(), &scale);
+    fft_like2.ComputeForwardFFTLike(input2.data(), input2.data(), &inv_scale);
+    fft_like2.ComputeInverseFFTLike(input2.data(), input2.data(), &scale);
+    fft_like3.ComputeForwardFFTLike(input3.data(), input3.data(), &inv_scale);
+    fft_like3.ComputeInverseFFTLike(input3.data(), input3.data(), &scale);
   }
 
   ASSERT_NE(allocators::CustomAllocatorFFTLike::number_deallocations, 0);
   CheckClose(exp_out, input1, 0.5);
   CheckClose(exp_out, input2, 0.5);
   CheckClose(exp_out, input3, 0.5);
-  CheckClose(exp_out, input4, 0.5);
+}
+
+// Whichever implementation is dispatched agrees with the plain computation,
+// including for counts which are not a multiple of the vector width
+TEST(FFTLike, BuildFloatingPoints) {
+  const uint64_t modulus = 97;
+  const uint64_t threshold = 49;
+  const double inv_scale = 0.25;
+  FFTLike fft_like(16);
+
+  for (size_t coeff_count : {16, 12, 5}) {
+    std::vector<uint64_t> plain(coeff_count);
+    std::vector<std::complex<double>> expected(coeff_count);
+    for (size_t i = 0; i < coeff_count; ++i) {
+      plain[i] = (i * 13) % modulus;
+      double value = static_cast<double>(plain[i]);
+      if (plain[i] >= threshold) {
+        value -= static_cast<double>(modulus);
+      }
+      expected[i] = std::complex<double>(value * inv_scale, 0);
+    }
+
+    std::vector<std::complex<double>> result(coeff_count);
+    fft_like.BuildFloatingPoints(result.data(), plain.data(), &threshold,
+                                 &modulus, inv_scale, 1, coeff_count);
+    ASSERT_EQ(expected, result) << "coeff_count " << coeff_count;
+  }
+}
+
+TEST(FFTLike, Batch) {
+  const uint64_t n = 1024;
+  const uint64_t batch_size = 19;
+  const double scale = 1 << 20;
+  FFTLike fft_like(n);
+  AlignedVector64<std::complex<double>> operand(batch_size * n);
+  for (auto& value : operand) {
+    value = std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                                 GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+
+  AlignedVector64<std::complex<double>> fwd_expected(batch_size * n);
+  AlignedVector64<std::complex<double>> inv_expected(batch_size * n);
+  for (uint64_t b = 0; b < batch_size; ++b) {
+    fft_like.ComputeForwardFFTLike(&fwd_expected[b * n], &operand[b * n]);
+    fft_like.ComputeInverseFFTLike(&inv_expected[b * n], &operand[b * n],
+                                   &scale);
+  }
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  for (uint64_t num_threads : {1, 2, 4}) {
+    SetFFTLikeNumThreads(num_threads);
+    ASSERT_EQ(GetFFTLikeNumThreads(), num_threads);
+    AlignedVector64<std::complex<double>> result(batch_size * n);
+    fft_like.ComputeForwardFFTLikeBatch(result.data(), operand.data(),
+                                        batch_size);
+    CheckClose(result, fwd_expected, 1e-9);
+    fft_like.ComputeInverseFFTLikeBatch(result.data(), operand.data(),
+                                        batch_size, &scale);
+    CheckClose(result, inv_expected, 1e-9 * scale);
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+// Large transforms are split across threads, with the same results
+TEST(FFTLike, Threads) {
+  const uint64_t n = 1 << 16;
+  const double scale = 1 << 20;
+  FFTLike fft_like(n);
+  AlignedVector64<std::complex<double>> operand(n);
+  for (auto& value : operand) {
+    value = std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                                 GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+
+  uint64_t default_num_threads = GetFFTLikeNumThreads();
+  SetFFTLikeNumThreads(1);
+  AlignedVector64<std::complex<double>> fwd_expected(n);
+  AlignedVector64<std::complex<double>> inv_expected(n);
+  fft_like.ComputeForwardFFTLike(fwd_expected.data(), operand.data());
+  fft_like.ComputeInverseFFTLike(inv_expected.data(), operand.data(), &scale);
+
+  for (uint64_t num_threads : {2, 4}) {
+    SetFFTLikeNumThreads(num_threads);
+    AlignedVector64<std::complex<double>> result(n);
+    fft_like.ComputeForwardFFTLike(result.data(), operand.data());
+    ASSERT_EQ(result, fwd_expected);
+    fft_like.ComputeInverseFFTLike(result.data(), operand.data(), &scale);
+    ASSERT_EQ(result, inv_expected);
+  }
+  SetFFTLikeNumThreads(default_num_threads);
+}
+
+// One FFTLike serves concurrent transforms with different scales
+TEST(FFTLike, SharedAcrossThreads) {
+  const uint64_t n = 1024;
+  const size_t num_threads = 4;
+  const FFTLike fft_like(n);
+  AlignedVector64<std::complex<double>> operand(n);
+  for (auto& value : operand) {
+    value = std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                                 GenerateInsecureUniformRealRandomValue(-1, 1));
+  }
+
+  std::vector<double> scales(num_threads);
+  std::vector<AlignedVector64<std::complex<double>>> fwd_expected(num_threads);
+  std::vector<AlignedVector64<std::complex<double>>> inv_expected(num_threads);
+  for (size_t t = 0; t < num_threads; ++t) {
+    scales[t] = static_cast<double>(1ULL << (10 * t));
+    fwd_expected[t].resize(n);
+    inv_expected[t].resize(n);
+    fft_like.ComputeForwardFFTLike(fwd_expected[t].data(), operand.data(),
+                                   &scales[t]);
+    fft_like.ComputeInverseFFTLike(inv_expected[t].data(), operand.data(),
+                                   &scales[t]);
+  }
+
+  std::vector<AlignedVector64<std::complex<double>>> fwd_results(
+      num_threads, AlignedVector64<std::complex<double>>(n));
+  std::vector<AlignedVector64<std::complex<double>>> inv_results(
+      num_threads, AlignedVector64<std::complex<double>>(n));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t rep = 0; rep < 50; ++rep) {
+        fft_like.ComputeForwardFFTLike(fwd_results[t].data(), operand.data(),
+                                       &scales[t]);
+        fft_like.ComputeInverseFFTLike(inv_results[t].data(), operand.data(),
+                                       &scales[t]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < num_threads; ++t) {
+    ASSERT_EQ(fwd_results[t], fwd_expected[t]);
+    ASSERT_EQ(inv_results[t], inv_expected[t]);
+  }
+}
+
+// The slot transforms agree with the full transforms of the slots and their
+// conjugates in the order of the rotation group generated by 5
+TEST(FFTLike, Slots) {
+  for (uint64_t n : {16, 32, 64, 1024, 4096}) {
+    FFTLike fft_like(n);
+    const uint64_t half_n = n / 2;
+    const uint64_t log_n = Log2(n);
+    const double inv_n = 1.0 / static_cast<double>(n);
+    const double tolerance = 4 * Log2(n) * std::ldexp(2.0 * n, -53);
+
+    AlignedVector64<std::complex<double>> slots(half_n);
+    for (auto& value : slots) {
+      value =
+          std::complex<double>(GenerateInsecureUniformRealRandomValue(-1, 1),
+                               GenerateInsecureUniformRealRandomValue(-1, 1));
+    }
+    AlignedVector64<std::complex<double>> expanded(n);
+    std::vector<uint64_t> positions(half_n);
+    uint64_t power = 1;
+    for (uint64_t i = 0; i < half_n; ++i) {
+      positions[i] = ReverseBits((power - 1) / 2, log_n);
+      ASSERT_EQ(fft_like.GetSlotPositions()[i], positions[i]);
+      ASSERT_EQ(fft_like.GetSlotIndex()[positions[i]], i);
+      expanded[positions[i]] = slots[i];
+      expanded[ReverseBits((2 * n - power - 1) / 2, log_n)] =
+          std::conj(slots[i]);
+      power = power * 5 % (2 * n);
+    }
+
+    AlignedVector64<std::complex<double>> expected(n);
+    AlignedVector64<std::complex<double>> result(n);
+    fft_like.ComputeInverseFFTLike(expected.data(), expanded.data(), &inv_n);
+    fft_like.ComputeInverseFFTLikeFromSlots(result.data(), slots.data(),
+                                            &inv_n);
+    CheckClose(result, expected, tolerance * inv_n);
+
+    // Decoding gives back the slots
+    AlignedVector64<std::complex<double>> decoded(half_n);
+    fft_like.ComputeForwardFFTLikeToSlots(decoded.data(), result.data());
+    CheckClose(decoded, slots, tolerance);
+
+    // Complex operands, with a scale
+    const double scale = 1 << 20;
+    fft_like.ComputeForwardFFTLike(expected.data(), expanded.data(), &scale);
+    fft_like.ComputeForwardFFTLikeToSlots(decoded.data(), expanded.data(),
+                                          &scale);
+    AlignedVector64<std::complex<double>> expected_slots(half_n);
+    for (uint64_t i = 0; i < half_n; ++i) {
+      expected_slots[i] = expected[positions[i]];
+    }
+    CheckClose(decoded, expected_slots, tolerance * scale);
+  }
 }
 
 }  // namespace hexl
@@ -0,0 +1,239 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "experimental/seal/base-conversion-avx512.hpp"
+#include "experimental/seal/base-conversion-internal.hpp"
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/experimental/seal/base-conversion.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Returns x mod modulus for a 128-bit x
+uint64_t Mod128(uint128_t x, uint64_t modulus) {
+  return static_cast<uint64_t>(x % modulus);
+}
+
+// Returns random 128-bit values in [0, q), along with their RNS representation
+// in the base in_moduli
+std::vector<uint128_t> GenerateRNSValues(const std::vector<uint64_t>& in_moduli,
+                                         uint64_t n,
+                                         std::vector<uint64_t>* rns) {
+  uint128_t q = 1;
+  for (uint64_t qi : in_moduli) {
+    q *= qi;
+  }
+  std::vector<uint128_t> values(n);
+  rns->assign(n * in_moduli.size(), 0);
+  for (size_t l = 0; l < n; ++l) {
+    uint128_t hi = GenerateInsecureUniformIntRandomValue(0, ~0ULL);
+    uint128_t lo = GenerateInsecureUniformIntRandomValue(0, ~0ULL);
+    values[l] = ((hi << 64) | lo) % q;
+    // Include values close to 0 and q
+    if (l == 0) values[l] = 0;
+    if (l == 1) values[l] = 1;
+    if (l == 2) values[l] = q - 1;
+    for (size_t i = 0; i < in_moduli.size(); ++i) {
+      (*rns)[i * n + l] = Mod128(values[l], in_moduli[i]);
+    }
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(BaseConverter, small) {
+  std::vector<uint64_t> in_moduli{3, 5};
+  std::vector<uint64_t> out_moduli{7, 11};
+  BaseConverter converter(in_moduli, out_moduli);
+
+  // x = 0, ..., 14; q = 15
+  uint64_t n = 15;
+  std::vector<uint64_t> input(2 * n);
+  for (size_t x = 0; x < n; ++x) {
+    input[x] = x % 3;
+    input[n + x] = x % 5;
+  }
+
+  std::vector<uint64_t> result(2 * n);
+  converter.FastBaseConversion(result.data(), input.data(), n, true);
+
+  std::vector<uint64_t> expected(2 * n);
+  for (size_t x = 0; x < n; ++x) {
+    // Centered representative in [-7, 7]
+    int64_t centered = (x >= 8) ? static_cast<int64_t>(x) - 15 : x;
+    expected[x] = static_cast<uint64_t>((centered + 7 * 3) % 7);
+    expected[n + x] = static_cast<uint64_t>((centered + 11 * 2) % 11);
+  }
+  AssertEqual(result, expected);
+}
+
+TEST(BaseConverter, fast) {
+  uint64_t n = 67;
+  for (size_t bits : {30, 45, 55}) {
+    std::vector<uint64_t> in_moduli = GeneratePrimes(2, bits, true, 32);
+    std::vector<uint64_t> out_moduli = GeneratePrimes(3, 61, true, 32);
+    BaseConverter converter(in_moduli, out_moduli);
+
+    std::vector<uint64_t> input;
+    std::vector<uint128_t> values = GenerateRNSValues(in_moduli, n, &input);
+    uint128_t q = uint128_t(in_moduli[0]) * in_moduli[1];
+
+    std::vector<uint64_t> result(n * out_moduli.size());
+    converter.FastBaseConversion(result.data(), input.data(), n);
+
+    // The result is x + u * q for some 0 <= u < 2, consistent across moduli
+    for (size_t l = 0; l < n; ++l) {
+      bool u_found = false;
+      for (uint128_t u = 0; u < 2; ++u) {
+        bool match = true;
+        for (size_t j = 0; j < out_moduli.size(); ++j) {
+          match &= (result[j * n + l] ==
+                    Mod128(values[l] + u * q, out_moduli[j]));
+        }
+        u_found |= match;
+      }
+      EXPECT_TRUE(u_found) << "coefficient " << l;
+    }
+  }
+}
+
+TEST(BaseConverter, exact) {
+  uint64_t n = 67;
+  for (size_t bits : {20, 40, 60}) {
+    std::vector<uint64_t> in_moduli = GeneratePrimes(2, bits, true, 32);
+    std::vector<uint64_t> out_moduli = GeneratePrimes(3, 49, true, 32);
+    BaseConverter converter(in_moduli, out_moduli);
+
+    std::vector<uint64_t> input;
+    std::vector<uint128_t> values = GenerateRNSValues(in_moduli, n, &input);
+    uint128_t q = uint128_t(in_moduli[0]) * in_moduli[1];
+
+    std::vector<uint64_t> result(n * out_moduli.size());
+    converter.FastBaseConversion(result.data(), input.data(), n, true);
+
+    std::vector<uint64_t> expected(n * out_moduli.size());
+    for (size_t j = 0; j < out_moduli.size(); ++j) {
+      uint64_t pj = out_moduli[j];
+      for (size_t l = 0; l < n; ++l) {
+        // Centered representative x - q if x >= q / 2
+        uint64_t x_mod_pj = Mod128(values[l], pj);
+        if (values[l] >= q - q / 2) {
+          x_mod_pj = SubUIntMod(x_mod_pj, Mod128(q, pj), pj);
+        }
+        expected[j * n + l] = x_mod_pj;
+      }
+    }
+    AssertEqual(result, expected);
+  }
+}
+
+// The q-overflow of sum_i y_i / q_i = k / 2 rounds half to even in every
+// kernel
+TEST(BaseConverter, OverflowRoundsHalfToEven) {
+  uint64_t n = 8;
+  uint64_t out_modulus = 17;
+  for (uint64_t num_in_moduli : {1, 3, 5, 7}) {
+    // y_i / q_i = 2 / 4 = 1/2 is exact in double precision
+    std::vector<uint64_t> y(n * num_in_moduli, 2);
+    std::vector<double> inv_q(num_in_moduli, 0.25);
+    // Only the overflow column is non-zero, so the result is the overflow
+    std::vector<uint64_t> q_hat_mod_p(num_in_moduli + 1, 0);
+    q_hat_mod_p[num_in_moduli] = 1;
+
+    uint64_t half_sum = num_in_moduli / 2;
+    uint64_t expected_overflow = half_sum + (half_sum % 2);
+    std::vector<uint64_t> expected(n, expected_overflow);
+
+    std::vector<uint64_t> native_out(n);
+    FastBaseConversionNative(native_out.data(), y.data(), n, num_in_moduli,
+                             &out_modulus, 1, q_hat_mod_p.data(),
+                             inv_q.data());
+    AssertEqual(native_out, expected);
+
+#ifdef HEXL_HAS_AVX512IFMA
+    if (has_avx512ifma) {
+      std::vector<uint64_t> avx512_out(n);
+      FastBaseConversionAVX512IFMA(avx512_out.data(), y.data(), n,
+                                   num_in_moduli, &out_modulus, 1,
+                                   q_hat_mod_p.data(), inv_q.data());
+      AssertEqual(avx512_out, expected);
+    }
+#endif
+  }
+}
+
+TEST(BaseConverter, buffer) {
+  uint64_t n = 300;
+  std::vector<uint64_t> in_moduli = GeneratePrimes(3, 40, true, 32);
+  std::vector<uint64_t> out_moduli = GeneratePrimes(2, 45, true, 32);
+  BaseConverter converter(in_moduli, out_moduli);
+
+  std::vector<uint64_t> input;
+  GenerateRNSValues(in_moduli, n, &input);
+
+  std::vector<uint64_t> expected(n * out_moduli.size());
+  converter.FastBaseConversion(expected.data(), input.data(), n, true);
+
+  std::vector<uint64_t> buffer(n * in_moduli.size());
+  std::vector<uint64_t> result(n * out_moduli.size());
+  converter.FastBaseConversion(result.data(), input.data(), n, true,
+                               buffer.data());
+  AssertEqual(result, expected);
+}
+
+#ifdef HEXL_HAS_AVX512IFMA
+TEST(BaseConverter, avx512ifma) {
+  if (!has_avx512ifma) {
+    GTEST_SKIP();
+  }
+
+  for (uint64_t num_in_moduli : {1, 4, 15}) {
+    for (uint64_t n : {8, 13, 1024}) {
+      std::vector<uint64_t> in_moduli =
+          GeneratePrimes(num_in_moduli, 49, true, 32);
+      std::vector<uint64_t> out_moduli = GeneratePrimes(5, 45, true, 32);
+      BaseConverter converter(in_moduli, out_moduli);
+
+      std::vector<uint64_t> y(n * num_in_moduli);
+      for (size_t i = 0; i < num_in_moduli; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, in_moduli[i]);
+        std::copy(limb.begin(), limb.end(), &y[i * n]);
+      }
+      std::vector<double> inv_q;
+      for (uint64_t qi : in_moduli) {
+        inv_q.push_back(1.0 / static_cast<double>(qi));
+      }
+
+      for (const double* inv_q_ptr :
+           {static_cast<const double*>(nullptr),
+            static_cast<const double*>(inv_q.data())}) {
+        std::vector<uint64_t> native_out(n * out_moduli.size());
+        std::vector<uint64_t> avx512_out(n * out_moduli.size());
+        FastBaseConversionNative(native_out.data(), y.data(), n, num_in_moduli,
+                                 out_moduli.data(), out_moduli.size(),
+                                 converter.GetQHatModP().data(), inv_q_ptr);
+        FastBaseConversionAVX512IFMA(avx512_out.data(), y.data(), n,
+                                     num_in_moduli, out_moduli.data(),
+                                     out_moduli.size(),
+                                     converter.GetQHatModP().data(), inv_q_ptr);
+        AssertEqual(native_out, avx512_out);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,14 +5,59 @@
 
 #include <vector>
 
+#include "experimental/seal/dyadic-multiply-avx512.hpp"
+#include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 #include "hexl/experimental/seal/dyadic-multiply.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
 
+namespace {
+
+// Returns the dyadic product of two random ciphertexts, computed with
+// MultiplyMod
+std::vector<uint64_t> ReferenceDyadicMultiply(
+    const std::vector<uint64_t>& operand1,
+    const std::vector<uint64_t>& operand2, uint64_t n,
+    const std::vector<uint64_t>& moduli) {
+  uint64_t poly_size = n * moduli.size();
+  std::vector<uint64_t> result(3 * poly_size);
+  for (size_t i = 0; i < moduli.size(); ++i) {
+    uint64_t q = moduli[i];
+    for (size_t j = i * n; j < (i + 1) * n; ++j) {
+      uint64_t x0 = operand1[j];
+      uint64_t x1 = operand1[j + poly_size];
+      uint64_t y0 = operand2[j];
+      uint64_t y1 = operand2[j + poly_size];
+      result[j] = MultiplyMod(x0, y0, q);
+      result[j + poly_size] =
+          AddUIntMod(MultiplyMod(x0, y1, q), MultiplyMod(x1, y0, q), q);
+      result[j + 2 * poly_size] = MultiplyMod(x1, y1, q);
+    }
+  }
+  return result;
+}
+
+// Returns a random ciphertext with two polynomials
+std::vector<uint64_t> RandomCiphertext(uint64_t n,
+                                       const std::vector<uint64_t>& moduli) {
+  std::vector<uint64_t> result;
+  for (size_t k = 0; k < 2; ++k) {
+    for (uint64_t q : moduli) {
+      auto limb = GenerateInsecureUniformIntRandomValues(n, 0, q);
+      result.insert(result.end(), limb.begin(), limb.end());
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 TEST(DyadicMultiply, small_one_mod) {
   size_t coeff_count = 3;
   std::vector<uint64_t> moduli{10};
@@ -154,5 +199,100 @@ TEST(DyadicMultiply, small_two_mod) {
   CheckEqual(out, exp_out);
 }
 
+// Both methods, in-place and out-of-place, match the reference for moduli on
+// either side of the 2^50 kernel boundary
+TEST(DyadicMultiply, algorithms) {
+  DyadicMultiplyAlgorithm default_algorithm = GetDyadicMultiplyAlgorithm();
+  for (DyadicMultiplyAlgorithm algorithm :
+       {DyadicMultiplyAlgorithm::kSchoolbook,
+        DyadicMultiplyAlgorithm::kKaratsuba, DyadicMultiplyAlgorithm::kAuto}) {
+    SetDyadicMultiplyAlgorithm(algorithm);
+    ASSERT_EQ(GetDyadicMultiplyAlgorithm(), algorithm);
+    for (uint64_t n : {8, 1000, 4096}) {
+      std::vector<uint64_t> moduli{GeneratePrimes(1, 30, true, 32)[0],
+                                   GeneratePrimes(1, 49, true, 32)[0],
+                                   GeneratePrimes(1, 55, true, 32)[0],
+                                   GeneratePrimes(1, 61, true, 32)[0]};
+      auto op1 = RandomCiphertext(n, moduli);
+      auto op2 = RandomCiphertext(n, moduli);
+      auto expected = ReferenceDyadicMultiply(op1, op2, n, moduli);
+
+      std::vector<uint64_t> out(3 * n * moduli.size());
+      DyadicMultiply(out.data(), op1.data(), op2.data(), n, moduli.data(),
+                     moduli.size());
+      AssertEqual(out, expected);
+
+      op1.resize(3 * n * moduli.size());
+      DyadicMultiply(op1.data(), op1.data(), op2.data(), n, moduli.data(),
+                     moduli.size());
+      AssertEqual(op1, expected);
+    }
+  }
+  SetDyadicMultiplyAlgorithm(default_algorithm);
+}
+
+// The parallel DyadicMultiply gives the same result for any thread count
+TEST(DyadicMultiply, num_threads) {
+  uint64_t n = 4096;
+  std::vector<uint64_t> moduli = GeneratePrimes(5, 50, true, n);
+  auto op1 = RandomCiphertext(n, moduli);
+  auto op2 = RandomCiphertext(n, moduli);
+  auto expected = ReferenceDyadicMultiply(op1, op2, n, moduli);
+
+  uint64_t default_num_threads = GetDyadicMultiplyNumThreads();
+  for (uint64_t num_threads : {1, 2, 3, 0}) {
+    SetDyadicMultiplyNumThreads(num_threads);
+    ASSERT_EQ(GetDyadicMultiplyNumThreads(), num_threads);
+
+    std::vector<uint64_t> out(3 * n * moduli.size());
+    DyadicMultiply(out.data(), op1.data(), op2.data(), n, moduli.data(),
+                   moduli.size());
+    AssertEqual(out, expected);
+  }
+  SetDyadicMultiplyNumThreads(default_num_threads);
+}
+
+TEST(DyadicMultiply, karatsuba_native) {
+  for (uint64_t n : {1, 13, 512}) {
+    for (uint64_t bits : {10, 30, 50, 61}) {
+      std::vector<uint64_t> moduli{GeneratePrimes(1, bits, true, 32)[0]};
+      auto op1 = RandomCiphertext(n, moduli);
+      auto op2 = RandomCiphertext(n, moduli);
+      std::vector<uint64_t> out(3 * n);
+      internal::DyadicMultiplyKaratsubaNative(out.data(), op1.data(),
+                                              op2.data(), n, n, moduli[0]);
+      AssertEqual(out, ReferenceDyadicMultiply(op1, op2, n, moduli));
+    }
+  }
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(DyadicMultiply, karatsuba_avx512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {8, 13, 512}) {
+    for (uint64_t bits : {10, 30, 49, 50, 61}) {
+      std::vector<uint64_t> moduli{GeneratePrimes(1, bits, true, 32)[0]};
+      auto op1 = RandomCiphertext(n, moduli);
+      auto op2 = RandomCiphertext(n, moduli);
+      auto expected = ReferenceDyadicMultiply(op1, op2, n, moduli);
+      std::vector<uint64_t> out(3 * n);
+      internal::DyadicMultiplyKaratsubaAVX512DQ(out.data(), op1.data(),
+                                                op2.data(), n, n, moduli[0]);
+      AssertEqual(out, expected);
+
+#ifdef HEXL_HAS_AVX512IFMA
+      if (has_avx512ifma && bits < 50) {
+        internal::DyadicMultiplyKaratsubaAVX512IFMA(
+            out.data(), op1.data(), op2.data(), n, n, moduli[0]);
+        AssertEqual(out, expected);
+      }
+#endif
+    }
+  }
+}
+#endif
+
 }  // namespace hexl
 }  // namespace intel
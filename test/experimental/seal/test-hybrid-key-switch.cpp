@@ -0,0 +1,199 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/eltwise/eltwise-sub-mod.hpp"
+#include "hexl/experimental/seal/hybrid-key-switch.hpp"
+#include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Returns the ternary polynomial with coefficients in {-1, 0, 1} stored in
+// NTT form modulo each of the moduli
+std::vector<uint64_t> RandomTernaryNTT(uint64_t n,
+                                       const std::vector<uint64_t>& moduli) {
+  auto coeffs = GenerateInsecureUniformIntRandomValues(n, 0, 3);
+  std::vector<uint64_t> result(n * moduli.size());
+  for (size_t i = 0; i < moduli.size(); ++i) {
+    for (size_t l = 0; l < n; ++l) {
+      result[i * n + l] = (coeffs[l] == 2) ? moduli[i] - 1 : coeffs[l];
+    }
+    NTT(n, moduli[i]).ComputeForward(&result[i * n], &result[i * n], 1, 1);
+  }
+  return result;
+}
+
+// Checks that, with one special prime and one prime per digit, hybrid key
+// switching matches KeySwitch. The last of the moduli is the special prime.
+void CheckMatchesKeySwitch(uint64_t n, const std::vector<uint64_t>& moduli) {
+  uint64_t key_modulus_size = moduli.size();
+  uint64_t num_q = key_modulus_size - 1;
+  uint64_t key_component_count = 2;
+  HybridKeySwitcher switcher(n, moduli, 1, 1);
+
+  std::vector<std::vector<uint64_t>> key_vector(num_q);
+  std::vector<const uint64_t*> key_ptrs;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    key_ptrs.push_back(each_key.data());
+  }
+
+  for (uint64_t decomp_modulus_size : {num_q, num_q - 2}) {
+    EXPECT_EQ(switcher.NumDigits(decomp_modulus_size), decomp_modulus_size);
+    std::vector<uint64_t> modswitch_factors;
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      modswitch_factors.push_back(
+          InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+    }
+
+    std::vector<uint64_t> t_target;
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      t_target.insert(t_target.end(), limb.begin(), limb.end());
+    }
+    std::vector<uint64_t> input;
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+        input.insert(input.end(), limb.begin(), limb.end());
+      }
+    }
+
+    std::vector<uint64_t> expected_output = input;
+    KeySwitch(expected_output.data(), t_target.data(), n, decomp_modulus_size,
+              key_modulus_size, decomp_modulus_size + 1, key_component_count,
+              moduli.data(), key_ptrs.data(), modswitch_factors.data());
+
+    std::vector<uint64_t> output = input;
+    switcher.KeySwitch(output.data(), t_target.data(), decomp_modulus_size,
+                       key_component_count, key_ptrs.data());
+    AssertEqual(output, expected_output);
+  }
+}
+
+}  // namespace
+
+TEST(HybridKeySwitch, matches_key_switch) {
+  uint64_t n = 1024;
+  CheckMatchesKeySwitch(n, GeneratePrimes(5, 50, true, n));
+}
+
+// Moduli of different sizes exercise the RNS conversion of KeySwitch, both
+// within and beyond the lazy NTT input range [0, 4q)
+TEST(HybridKeySwitch, matches_key_switch_mixed_moduli) {
+  uint64_t n = 1024;
+  std::vector<uint64_t> moduli;
+  for (uint64_t bits : {40, 60, 51, 48, 30, 45}) {
+    moduli.push_back(GeneratePrimes(1, bits, true, n)[0]);
+  }
+  CheckMatchesKeySwitch(n, moduli);
+}
+
+// Switches c * s2 to a ciphertext (c0, c1) under s, i.e. c0 + c1 * s is
+// c * s2 up to a small error, for several digit sizes and levels
+TEST(HybridKeySwitch, decrypts) {
+  uint64_t n = 1024;
+  uint64_t num_q = 5;
+  uint64_t num_special = 2;
+  uint64_t key_modulus_size = num_q + num_special;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, n);
+  std::vector<uint64_t> p_moduli(moduli.begin() + num_q, moduli.end());
+
+  auto s = RandomTernaryNTT(n, moduli);
+  auto s2 = RandomTernaryNTT(n, moduli);
+
+  for (uint64_t digit_size : {1, 2, 5}) {
+    HybridKeySwitcher switcher(n, moduli, num_special, digit_size);
+    uint64_t num_digits = switcher.NumDigits(num_q);
+
+    // Key for digit d is (-a * s + g_d * s2, a), where the gadget factor g_d
+    // is P mod q_i for q_i in digit d and 0 modulo every other prime
+    std::vector<std::vector<uint64_t>> key_vector(num_digits);
+    std::vector<const uint64_t*> key_ptrs;
+    for (uint64_t d = 0; d < num_digits; ++d) {
+      auto& key = key_vector[d];
+      key.resize(2 * key_modulus_size * n);
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        uint64_t qi = moduli[i];
+        uint64_t gadget = 0;
+        if (i >= d * digit_size && i < (d + 1) * digit_size && i < num_q) {
+          gadget = 1;
+          for (uint64_t pj : p_moduli) {
+            gadget = MultiplyMod(gadget, pj % qi, qi);
+          }
+        }
+        uint64_t* b = &key[i * n];
+        uint64_t* a = &key[(key_modulus_size + i) * n];
+        auto a_limb = GenerateInsecureUniformIntRandomValues(n, 0, qi);
+        std::copy(a_limb.begin(), a_limb.end(), a);
+        std::vector<uint64_t> gs2(n);
+        for (size_t l = 0; l < n; ++l) {
+          gs2[l] = MultiplyMod(gadget, s2[i * n + l], qi);
+        }
+        EltwiseMultMod(b, a, &s[i * n], n, qi, 1);
+        EltwiseSubMod(b, gs2.data(), b, n, qi);
+      }
+      key_ptrs.push_back(key.data());
+    }
+
+    for (uint64_t decomp_modulus_size : {num_q, num_q - 2}) {
+      std::vector<uint64_t> t_target;
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        auto limb = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+        t_target.insert(t_target.end(), limb.begin(), limb.end());
+      }
+      std::vector<uint64_t> output(2 * decomp_modulus_size * n, 0);
+      switcher.KeySwitch(output.data(), t_target.data(), decomp_modulus_size,
+                         2, key_ptrs.data());
+
+      // Per limb, compute c0 + c1 * s - c * s2 in coefficient form; the
+      // error is the same small integer polynomial modulo every q_i
+      std::vector<int64_t> expected_error;
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        uint64_t qi = moduli[i];
+        std::vector<uint64_t> error(n);
+        std::vector<uint64_t> c_s2(n);
+        EltwiseMultMod(error.data(), &output[(decomp_modulus_size + i) * n],
+                       &s[i * n], n, qi, 1);
+        EltwiseAddMod(error.data(), error.data(), &output[i * n], n, qi);
+        EltwiseMultMod(c_s2.data(), &t_target[i * n], &s2[i * n], n, qi, 1);
+        EltwiseSubMod(error.data(), error.data(), c_s2.data(), n, qi);
+        NTT(n, qi).ComputeInverse(error.data(), error.data(), 1, 1);
+
+        std::vector<int64_t> centered_error(n);
+        for (size_t l = 0; l < n; ++l) {
+          centered_error[l] = (error[l] > qi / 2)
+                                  ? -static_cast<int64_t>(qi - error[l])
+                                  : static_cast<int64_t>(error[l]);
+          ASSERT_LT(std::abs(centered_error[l]), 1 << 20);
+        }
+        if (i == 0) {
+          expected_error = centered_error;
+        }
+        ASSERT_EQ(centered_error, expected_error);
+      }
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -6,9 +6,12 @@
 #include <vector>
 
 #include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/experimental/seal/ntt-cache.hpp"
 #include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -185,5 +188,378 @@ TEST(KeySwitch, small) {
   AssertEqual(input, expected_output);
 }
 
+// Checks the parallel KeySwitch gives the same result for any thread count
+TEST(KeySwitch, num_threads) {
+  size_t coeff_count = 1024;
+  size_t decomp_modulus_size = 5;
+  size_t key_modulus_size = 7;
+  size_t rns_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, coeff_count);
+
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    modswitch_factors.push_back(
+        InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+  }
+
+  std::vector<std::vector<uint64_t>> key_vector(decomp_modulus_size);
+  std::vector<const uint64_t*> hexl_key_vectors;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    hexl_key_vectors.push_back(each_key.data());
+  }
+
+  std::vector<uint64_t> t_target;
+  std::vector<uint64_t> input;
+  for (size_t k = 0; k < key_component_count; ++k) {
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb =
+          GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+      input.insert(input.end(), limb.begin(), limb.end());
+    }
+  }
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto limb =
+        GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+    t_target.insert(t_target.end(), limb.begin(), limb.end());
+  }
+
+  uint64_t default_num_threads = GetKeySwitchNumThreads();
+  std::vector<uint64_t> expected_output;
+  for (uint64_t num_threads : {1, 2, 3, 0}) {
+    SetKeySwitchNumThreads(num_threads);
+    ASSERT_EQ(GetKeySwitchNumThreads(), num_threads);
+
+    std::vector<uint64_t> output = input;
+    KeySwitch(output.data(), t_target.data(), coeff_count, decomp_modulus_size,
+              key_modulus_size, rns_modulus_size, key_component_count,
+              moduli.data(), hexl_key_vectors.data(), modswitch_factors.data());
+    if (expected_output.empty()) {
+      expected_output = output;
+    }
+    AssertEqual(output, expected_output);
+  }
+  SetKeySwitchNumThreads(default_num_threads);
+}
+
+// Reusing one workspace across calls matches the allocating overload
+TEST(KeySwitch, workspace) {
+  size_t coeff_count = 1024;
+  size_t decomp_modulus_size = 5;
+  size_t key_modulus_size = 7;
+  size_t rns_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, coeff_count);
+
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    modswitch_factors.push_back(
+        InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+  }
+
+  std::vector<std::vector<uint64_t>> key_vector(decomp_modulus_size);
+  std::vector<const uint64_t*> hexl_key_vectors;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    hexl_key_vectors.push_back(each_key.data());
+  }
+
+  KeySwitchWorkspace workspace(coeff_count, decomp_modulus_size,
+                               key_component_count);
+  EXPECT_TRUE(workspace.Fits(coeff_count, decomp_modulus_size,
+                             key_component_count));
+  EXPECT_TRUE(workspace.Fits(coeff_count, decomp_modulus_size - 1, 1));
+  EXPECT_FALSE(workspace.Fits(coeff_count * 2, decomp_modulus_size,
+                              key_component_count));
+  EXPECT_FALSE(workspace.Fits(coeff_count, decomp_modulus_size + 1,
+                              key_component_count));
+
+  for (size_t trial = 0; trial < 3; ++trial) {
+    std::vector<uint64_t> t_target;
+    std::vector<uint64_t> input;
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        input.insert(input.end(), limb.begin(), limb.end());
+      }
+    }
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb =
+          GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+      t_target.insert(t_target.end(), limb.begin(), limb.end());
+    }
+
+    std::vector<uint64_t> expected_output = input;
+    KeySwitch(expected_output.data(), t_target.data(), coeff_count,
+              decomp_modulus_size, key_modulus_size, rns_modulus_size,
+              key_component_count, moduli.data(), hexl_key_vectors.data(),
+              modswitch_factors.data());
+
+    std::vector<uint64_t> output = input;
+    KeySwitch(output.data(), t_target.data(), coeff_count, decomp_modulus_size,
+              key_modulus_size, rns_modulus_size, key_component_count,
+              moduli.data(), hexl_key_vectors.data(), modswitch_factors.data(),
+              workspace);
+    AssertEqual(output, expected_output);
+  }
+}
+
+// KeySwitchBatch matches repeated KeySwitch calls, including when the batch
+// is not a multiple of the workspace batch size
+TEST(KeySwitch, batch) {
+  size_t coeff_count = 1024;
+  size_t decomp_modulus_size = 4;
+  size_t key_modulus_size = 6;
+  size_t rns_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  size_t batch_size = 5;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, coeff_count);
+
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    modswitch_factors.push_back(
+        InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+  }
+
+  std::vector<std::vector<uint64_t>> key_vector(decomp_modulus_size);
+  std::vector<const uint64_t*> hexl_key_vectors;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    hexl_key_vectors.push_back(each_key.data());
+  }
+
+  std::vector<std::vector<uint64_t>> t_targets(batch_size);
+  std::vector<std::vector<uint64_t>> inputs(batch_size);
+  for (size_t b = 0; b < batch_size; ++b) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < decomp_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        inputs[b].insert(inputs[b].end(), limb.begin(), limb.end());
+      }
+    }
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb =
+          GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+      t_targets[b].insert(t_targets[b].end(), limb.begin(), limb.end());
+    }
+  }
+
+  std::vector<std::vector<uint64_t>> expected_outputs = inputs;
+  for (size_t b = 0; b < batch_size; ++b) {
+    KeySwitch(expected_outputs[b].data(), t_targets[b].data(), coeff_count,
+              decomp_modulus_size, key_modulus_size, rns_modulus_size,
+              key_component_count, moduli.data(), hexl_key_vectors.data(),
+              modswitch_factors.data());
+  }
+
+  std::vector<const uint64_t*> target_ptrs;
+  for (const auto& t_target : t_targets) {
+    target_ptrs.push_back(t_target.data());
+  }
+
+  for (uint64_t workspace_batch_size : {0, 1, 2, 5, 8}) {
+    std::vector<std::vector<uint64_t>> outputs = inputs;
+    std::vector<uint64_t*> output_ptrs;
+    for (auto& output : outputs) {
+      output_ptrs.push_back(output.data());
+    }
+    if (workspace_batch_size == 0) {
+      KeySwitchBatch(output_ptrs.data(), target_ptrs.data(), batch_size,
+                     coeff_count, decomp_modulus_size, key_modulus_size,
+                     rns_modulus_size, key_component_count, moduli.data(),
+                     hexl_key_vectors.data(), modswitch_factors.data());
+    } else {
+      KeySwitchWorkspace workspace(coeff_count, decomp_modulus_size,
+                                   key_component_count, workspace_batch_size);
+      KeySwitchBatch(output_ptrs.data(), target_ptrs.data(), batch_size,
+                     coeff_count, decomp_modulus_size, key_modulus_size,
+                     rns_modulus_size, key_component_count, moduli.data(),
+                     hexl_key_vectors.data(), modswitch_factors.data(),
+                     workspace);
+    }
+    for (size_t b = 0; b < batch_size; ++b) {
+      AssertEqual(outputs[b], expected_outputs[b]);
+    }
+  }
+
+  // An empty batch is a no-op, with or without a workspace
+  KeySwitchBatch(nullptr, nullptr, 0, coeff_count, decomp_modulus_size,
+                 key_modulus_size, rns_modulus_size, key_component_count,
+                 moduli.data(), hexl_key_vectors.data(),
+                 modswitch_factors.data());
+  KeySwitchWorkspace workspace(coeff_count, decomp_modulus_size,
+                               key_component_count);
+  KeySwitchBatch(nullptr, nullptr, 0, coeff_count, decomp_modulus_size,
+                 key_modulus_size, rns_modulus_size, key_component_count,
+                 moduli.data(), hexl_key_vectors.data(),
+                 modswitch_factors.data(), workspace);
+}
+
+// KeySwitch keeps its NTTs alive when resolving one evicts another from a
+// small NTT cache
+TEST(KeySwitch, ntt_cache_capacity) {
+  size_t coeff_count = 1024;
+  size_t decomp_modulus_size = 5;
+  size_t key_modulus_size = 7;
+  size_t rns_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, coeff_count);
+
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    modswitch_factors.push_back(
+        InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+  }
+
+  std::vector<std::vector<uint64_t>> key_vector(decomp_modulus_size);
+  std::vector<const uint64_t*> hexl_key_vectors;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    hexl_key_vectors.push_back(each_key.data());
+  }
+
+  std::vector<uint64_t> t_target;
+  std::vector<uint64_t> input;
+  for (size_t k = 0; k < key_component_count; ++k) {
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb =
+          GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+      input.insert(input.end(), limb.begin(), limb.end());
+    }
+  }
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto limb =
+        GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+    t_target.insert(t_target.end(), limb.begin(), limb.end());
+  }
+
+  std::vector<uint64_t> expected_output = input;
+  KeySwitch(expected_output.data(), t_target.data(), coeff_count,
+            decomp_modulus_size, key_modulus_size, rns_modulus_size,
+            key_component_count, moduli.data(), hexl_key_vectors.data(),
+            modswitch_factors.data());
+
+  size_t default_capacity = GetNTTCacheCapacity();
+  for (size_t capacity : {1, 2}) {
+    ClearNTTCache();
+    SetNTTCacheCapacity(capacity);
+
+    std::vector<uint64_t> output = input;
+    KeySwitch(output.data(), t_target.data(), coeff_count, decomp_modulus_size,
+              key_modulus_size, rns_modulus_size, key_component_count,
+              moduli.data(), hexl_key_vectors.data(), modswitch_factors.data());
+    AssertEqual(output, expected_output);
+  }
+  SetNTTCacheCapacity(default_capacity);
+  ClearNTTCache();
+}
+
+// Caller-provided NTTs give the same result as the NTT cache
+TEST(KeySwitch, ntts) {
+  size_t coeff_count = 1024;
+  size_t decomp_modulus_size = 3;
+  size_t key_modulus_size = 5;
+  size_t rns_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, coeff_count);
+
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    modswitch_factors.push_back(
+        InverseMod(moduli[key_modulus_size - 1] % moduli[i], moduli[i]));
+  }
+
+  std::vector<std::vector<uint64_t>> key_vector(decomp_modulus_size);
+  std::vector<const uint64_t*> hexl_key_vectors;
+  for (auto& each_key : key_vector) {
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (size_t i = 0; i < key_modulus_size; ++i) {
+        auto limb =
+            GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+        each_key.insert(each_key.end(), limb.begin(), limb.end());
+      }
+    }
+    hexl_key_vectors.push_back(each_key.data());
+  }
+
+  std::vector<uint64_t> t_target;
+  std::vector<uint64_t> input;
+  for (size_t k = 0; k < key_component_count; ++k) {
+    for (size_t i = 0; i < decomp_modulus_size; ++i) {
+      auto limb =
+          GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+      input.insert(input.end(), limb.begin(), limb.end());
+    }
+  }
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto limb =
+        GenerateInsecureUniformIntRandomValues(coeff_count, 0, moduli[i]);
+    t_target.insert(t_target.end(), limb.begin(), limb.end());
+  }
+
+  std::vector<NTT> ntts;
+  for (uint64_t modulus : moduli) {
+    ntts.emplace_back(coeff_count, modulus);
+  }
+  std::vector<NTT*> ntt_ptrs;
+  for (auto& ntt : ntts) {
+    ntt_ptrs.push_back(&ntt);
+  }
+
+  std::vector<uint64_t> expected_output = input;
+  KeySwitch(expected_output.data(), t_target.data(), coeff_count,
+            decomp_modulus_size, key_modulus_size, rns_modulus_size,
+            key_component_count, moduli.data(), hexl_key_vectors.data(),
+            modswitch_factors.data());
+
+  KeySwitchWorkspace workspace(coeff_count, decomp_modulus_size,
+                               key_component_count);
+  std::vector<uint64_t> output = input;
+  KeySwitch(output.data(), t_target.data(), coeff_count, decomp_modulus_size,
+            key_modulus_size, rns_modulus_size, key_component_count,
+            moduli.data(), hexl_key_vectors.data(), modswitch_factors.data(),
+            workspace, ntt_ptrs.data());
+  AssertEqual(output, expected_output);
+
+  std::vector<uint64_t> root_of_unity_powers(coeff_count);
+  EXPECT_ANY_THROW(KeySwitch(
+      output.data(), t_target.data(), coeff_count, decomp_modulus_size,
+      key_modulus_size, rns_modulus_size, key_component_count, moduli.data(),
+      hexl_key_vectors.data(), modswitch_factors.data(),
+      root_of_unity_powers.data()));
+}
+
 }  // namespace hexl
 }  // namespace intel
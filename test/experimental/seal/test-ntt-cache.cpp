@@ -0,0 +1,111 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hexl/experimental/seal/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(NTTCache, lookup) {
+  uint64_t n = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 40, true, 2 * n);
+  ResetNTTCacheStats();
+
+  NTT& ntt = GetNTT(n, moduli[0]);
+  EXPECT_EQ(ntt.GetDegree(), n);
+  EXPECT_EQ(ntt.GetModulus(), moduli[0]);
+  EXPECT_EQ(&GetNTT(n, moduli[0]), &ntt);
+  EXPECT_EQ(GetNTTShared(n, moduli[0]).get(), &ntt);
+  EXPECT_NE(&GetNTT(n, moduli[1]), &ntt);
+  EXPECT_NE(&GetNTT(2 * n, moduli[0]), &ntt);
+
+  NTTCacheStats stats = GetNTTCacheStats();
+  EXPECT_EQ(stats.hits + stats.misses, 5ULL);
+  EXPECT_LE(stats.misses, 3ULL);
+  EXPECT_EQ(stats.constructions, stats.misses);
+}
+
+TEST(NTTCache, prewarm) {
+  uint64_t n = 128;
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 45, true, n);
+  PrewarmNTTCache(n, moduli);
+  ResetNTTCacheStats();
+
+  for (uint64_t modulus : moduli) {
+    EXPECT_EQ(GetNTT(n, modulus).GetModulus(), modulus);
+  }
+  NTTCacheStats stats = GetNTTCacheStats();
+  EXPECT_EQ(stats.hits, moduli.size());
+  EXPECT_EQ(stats.misses, 0ULL);
+  EXPECT_EQ(stats.constructions, 0ULL);
+  EXPECT_GE(stats.size, moduli.size());
+}
+
+TEST(NTTCache, capacity) {
+  uint64_t n = 32;
+  std::vector<uint64_t> moduli = GeneratePrimes(5, 30, true, n);
+  size_t default_capacity = GetNTTCacheCapacity();
+  ClearNTTCache();
+  ResetNTTCacheStats();
+
+  SetNTTCacheCapacity(3);
+  EXPECT_EQ(GetNTTCacheCapacity(), 3ULL);
+  std::shared_ptr<NTT> first = GetNTTShared(n, moduli[0]);
+  for (uint64_t modulus : moduli) {
+    GetNTT(n, modulus);
+  }
+  NTTCacheStats stats = GetNTTCacheStats();
+  EXPECT_EQ(stats.size, 3ULL);
+  EXPECT_EQ(stats.evictions, 2ULL);
+
+  // The oldest entry was evicted, but the shared pointer keeps it alive
+  EXPECT_EQ(first->GetModulus(), moduli[0]);
+  EXPECT_NE(GetNTTShared(n, moduli[0]), first);
+  EXPECT_EQ(GetNTTCacheStats().misses, moduli.size() + 1);
+
+  SetNTTCacheCapacity(1);
+  EXPECT_EQ(GetNTTCacheStats().size, 1ULL);
+
+  SetNTTCacheCapacity(default_capacity);
+  ClearNTTCache();
+  EXPECT_EQ(GetNTTCacheStats().size, 0ULL);
+}
+
+// Concurrent lookups from several threads agree on one NTT per key
+TEST(NTTCache, threads) {
+  uint64_t n = 256;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+  size_t num_threads = 4;
+  std::vector<std::vector<NTT*>> ntts(num_threads);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t rep = 0; rep < 100; ++rep) {
+        for (uint64_t modulus : moduli) {
+          NTT& ntt = GetNTT(n, modulus);
+          if (rep == 0) {
+            ntts[t].push_back(&ntt);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 1; t < num_threads; ++t) {
+    EXPECT_EQ(ntts[t], ntts[0]);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
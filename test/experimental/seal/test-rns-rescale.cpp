@@ -0,0 +1,168 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "experimental/seal/rns-rescale-avx512.hpp"
+#include "experimental/seal/rns-rescale-internal.hpp"
+#include "hexl/experimental/seal/rns-rescale.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Returns the RNS representation of the integer values, along with the
+// expected rescaled values round(x / qk) mod qi
+void GenerateRescaleTestData(const std::vector<uint64_t>& moduli, uint64_t n,
+                             std::vector<uint64_t>* input,
+                             std::vector<uint64_t>* expected) {
+  size_t num_moduli = moduli.size();
+  uint64_t qk = moduli.back();
+
+  input->assign(n * num_moduli, 0);
+  expected->assign(n * (num_moduli - 1), 0);
+  for (size_t l = 0; l < n; ++l) {
+    // x = a * qk + b, with rounding at b = qk / 2
+    uint64_t a = GenerateInsecureUniformIntRandomValue(0, 1ULL << 40);
+    uint64_t b = (l % 4 == 0) ? (qk >> 1)
+                 : (l % 4 == 1)
+                     ? (qk >> 1) - 1
+                     : GenerateInsecureUniformIntRandomValue(0, qk);
+    uint64_t rounded = a + ((b >= qk - (qk >> 1)) ? 1 : 0);
+    for (size_t i = 0; i < num_moduli; ++i) {
+      uint64_t qi = moduli[i];
+      uint64_t x_mod_qi =
+          AddUIntMod(MultiplyMod(a % qi, qk % qi, qi), b % qi, qi);
+      (*input)[i * n + l] = x_mod_qi;
+      if (i < num_moduli - 1) {
+        (*expected)[i * n + l] = rounded % qi;
+      }
+    }
+  }
+}
+
+std::vector<uint64_t> InvLastModulus(const std::vector<uint64_t>& moduli) {
+  std::vector<uint64_t> inv_qk_mod_qi;
+  for (size_t i = 0; i + 1 < moduli.size(); ++i) {
+    inv_qk_mod_qi.push_back(InverseMod(moduli.back() % moduli[i], moduli[i]));
+  }
+  return inv_qk_mod_qi;
+}
+
+}  // namespace
+
+TEST(RNSRescale, coefficient_form) {
+  uint64_t n = 64;
+  for (const auto& moduli :
+       {GeneratePrimes(3, 50, true, n),
+        std::vector<uint64_t>{GeneratePrimes(1, 40, true, n)[0],
+                              GeneratePrimes(1, 55, true, n)[0],
+                              GeneratePrimes(1, 60, true, n)[0]}}) {
+    std::vector<uint64_t> input;
+    std::vector<uint64_t> expected;
+    GenerateRescaleTestData(moduli, n, &input, &expected);
+    std::vector<uint64_t> inv_qk_mod_qi = InvLastModulus(moduli);
+
+    std::vector<uint64_t> result(n * (moduli.size() - 1), 0);
+    RNSRescale(result.data(), input.data(), n, moduli.size(), moduli.data(),
+               inv_qk_mod_qi.data(), false);
+    AssertEqual(result, expected);
+
+    // In-place
+    RNSRescale(input.data(), input.data(), n, moduli.size(), moduli.data(),
+               inv_qk_mod_qi.data(), false);
+    input.resize(expected.size());
+    AssertEqual(input, expected);
+  }
+}
+
+TEST(RNSRescale, ntt_form) {
+  uint64_t n = 1024;
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 58, true, n);
+  std::vector<uint64_t> input;
+  std::vector<uint64_t> expected;
+  GenerateRescaleTestData(moduli, n, &input, &expected);
+  std::vector<uint64_t> inv_qk_mod_qi = InvLastModulus(moduli);
+
+  for (size_t i = 0; i < moduli.size(); ++i) {
+    NTT ntt(n, moduli[i]);
+    ntt.ComputeForward(&input[i * n], &input[i * n], 1, 1);
+    if (i < moduli.size() - 1) {
+      ntt.ComputeForward(&expected[i * n], &expected[i * n], 1, 1);
+    }
+  }
+
+  std::vector<uint64_t> result(n * (moduli.size() - 1), 0);
+  RNSRescale(result.data(), input.data(), n, moduli.size(), moduli.data(),
+             inv_qk_mod_qi.data(), true);
+  AssertEqual(result, expected);
+}
+
+TEST(RNSRescale, tail_kernels_native) {
+  uint64_t n = 1024;
+  for (uint64_t bits : {30, 50, 61}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, n)[0];
+    uint64_t scale = GenerateInsecureUniformIntRandomValue(0, modulus);
+    uint64_t addend = GenerateInsecureUniformIntRandomValue(0, 2 * modulus);
+    auto operand = GenerateInsecureUniformIntRandomValues(n, 0, ~0ULL);
+    auto operand1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    auto operand2 = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+
+    std::vector<uint64_t> lazy(n);
+    EltwiseReduceAddLazyNative(lazy.data(), operand.data(), n, modulus, addend);
+    std::vector<uint64_t> result(n);
+    EltwiseSubScaleModNative(result.data(), operand1.data(), operand2.data(),
+                             n, modulus, scale);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_LT(lazy[i], 4 * modulus);
+      ASSERT_EQ(lazy[i] % modulus, (operand[i] % modulus + addend) % modulus);
+      uint64_t diff = SubUIntMod(operand1[i], operand2[i] % modulus, modulus);
+      ASSERT_EQ(result[i], MultiplyMod(diff, scale, modulus));
+    }
+  }
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(RNSRescale, tail_kernels_avx512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {8, 13, 1024}) {
+    for (uint64_t bits : {30, 50, 61}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 32)[0];
+      uint64_t scale = GenerateInsecureUniformIntRandomValue(0, modulus);
+      uint64_t addend = GenerateInsecureUniformIntRandomValue(0, 2 * modulus);
+      auto operand = GenerateInsecureUniformIntRandomValues(n, 0, ~0ULL);
+      auto operand1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto operand2 =
+          GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+
+      std::vector<uint64_t> native_out(n);
+      std::vector<uint64_t> avx512_out(n);
+      EltwiseReduceAddLazyNative(native_out.data(), operand.data(), n, modulus,
+                                 addend);
+      EltwiseReduceAddLazyAVX512(avx512_out.data(), operand.data(), n, modulus,
+                                 addend);
+      AssertEqual(native_out, avx512_out);
+
+      EltwiseSubScaleModNative(native_out.data(), operand1.data(),
+                               operand2.data(), n, modulus, scale);
+      EltwiseSubScaleModAVX512(avx512_out.data(), operand1.data(),
+                               operand2.data(), n, modulus, scale);
+      AssertEqual(native_out, avx512_out);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
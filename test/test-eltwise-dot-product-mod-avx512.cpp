@@ -0,0 +1,109 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(EltwiseDotProductMod, avx512dq_small) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint64_t> op2{9, 8, 7, 6, 5, 4, 3, 2, 1};
+  uint64_t modulus = 101;
+
+  EXPECT_EQ(EltwiseDotProductModAVX512DQ<1>(op1.data(), op2.data(), op1.size(),
+                                            modulus),
+            165 % modulus);
+}
+
+// Compares AVX512DQ against the native implementation, for all input mod
+// factors and for vector lengths which are not a multiple of 8
+TEST(EltwiseDotProductMod, avx512dq_random) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  for (size_t bits = 20; bits <= 62; bits += 7) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (size_t n : {8, 15, 1024, 4099}) {
+      for (uint64_t input_mod_factor = 1; input_mod_factor <= 4;
+           input_mod_factor *= 2) {
+        if (input_mod_factor * modulus >= (1ULL << 63)) {
+          continue;
+        }
+        uint64_t bound = input_mod_factor * modulus;
+        auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, bound);
+        auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, bound);
+
+        uint64_t expected = 0;
+        uint64_t result = 0;
+        switch (input_mod_factor) {
+          case 1:
+            expected = EltwiseDotProductModNative<1>(op1.data(), op2.data(), n,
+                                                     modulus);
+            result = EltwiseDotProductModAVX512DQ<1>(op1.data(), op2.data(), n,
+                                                     modulus);
+            break;
+          case 2:
+            expected = EltwiseDotProductModNative<2>(op1.data(), op2.data(), n,
+                                                     modulus);
+            result = EltwiseDotProductModAVX512DQ<2>(op1.data(), op2.data(), n,
+                                                     modulus);
+            break;
+          case 4:
+            expected = EltwiseDotProductModNative<4>(op1.data(), op2.data(), n,
+                                                     modulus);
+            result = EltwiseDotProductModAVX512DQ<4>(op1.data(), op2.data(), n,
+                                                     modulus);
+            break;
+        }
+        ASSERT_EQ(result, expected);
+      }
+    }
+  }
+}
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+// Uses vectors long enough to exercise the periodic flush of the 52-bit lane
+// accumulators
+TEST(EltwiseDotProductMod, avx512ifma_random) {
+  if (!has_avx512ifma) {
+    GTEST_SKIP();
+  }
+
+  for (size_t bits : {17, 30, 45, 50}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (size_t n : {8, 15, 1024, 40001}) {
+      // Unreduced inputs with values up to 4 * modulus
+      auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+      auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+
+      uint64_t expected =
+          EltwiseDotProductModNative<4>(op1.data(), op2.data(), n, modulus);
+      ASSERT_EQ(EltwiseDotProductModAVX512IFMA(op1.data(), op2.data(), n,
+                                               modulus),
+                expected);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
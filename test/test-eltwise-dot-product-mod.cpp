@@ -0,0 +1,112 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_DEBUG
+TEST(EltwiseDotProductMod, null) {
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<uint64_t> op2{1, 2, 3, 4, 5, 6, 7, 8};
+  uint64_t modulus = 769;
+  std::vector<uint64_t> big_input(op1.size(), modulus);
+
+  EXPECT_ANY_THROW(
+      EltwiseDotProductMod(nullptr, op2.data(), op1.size(), modulus, 1));
+  EXPECT_ANY_THROW(
+      EltwiseDotProductMod(op1.data(), nullptr, op1.size(), modulus, 1));
+  EXPECT_ANY_THROW(EltwiseDotProductMod(op1.data(), op2.data(), 0, modulus, 1));
+  EXPECT_ANY_THROW(
+      EltwiseDotProductMod(op1.data(), op2.data(), op1.size(), 1, 1));
+  EXPECT_ANY_THROW(
+      EltwiseDotProductMod(op1.data(), op2.data(), op1.size(), modulus, 3));
+  EXPECT_ANY_THROW(EltwiseDotProductMod(op1.data(), big_input.data(),
+                                       op1.size(), modulus, 1));
+  // input_mod_factor * modulus must be below 2^63
+  EXPECT_ANY_THROW(EltwiseDotProductMod(op1.data(), op2.data(), op1.size(),
+                                       (1ULL << 61) + 1, 4));
+}
+#endif
+
+TEST(EltwiseDotProductMod, small) {
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint64_t> op2{9, 8, 7, 6, 5, 4, 3, 2, 1};
+  uint64_t modulus = 101;
+
+  // 9 + 16 + 21 + 24 + 25 + 24 + 21 + 16 + 9 = 165
+  EXPECT_EQ(
+      EltwiseDotProductMod(op1.data(), op2.data(), op1.size(), modulus, 1),
+      165 % modulus);
+}
+
+TEST(EltwiseDotProductMod, mult_input_mod_factor) {
+  uint64_t modulus = 101;
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint64_t> op2{9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+  for (uint64_t input_mod_factor = 1; input_mod_factor <= 4;
+       input_mod_factor *= 2) {
+    std::vector<uint64_t> lazy_op1(op1);
+    std::vector<uint64_t> lazy_op2(op2);
+    for (size_t i = 0; i < op1.size(); ++i) {
+      lazy_op1[i] += (input_mod_factor - 1) * modulus;
+      lazy_op2[i] += (i % input_mod_factor) * modulus;
+    }
+    EXPECT_EQ(EltwiseDotProductMod(lazy_op1.data(), lazy_op2.data(),
+                                   op1.size(), modulus, input_mod_factor),
+              165 % modulus);
+  }
+}
+
+TEST(EltwiseDotProductMod, multi_modulus) {
+  uint64_t n = 3;
+  std::vector<uint64_t> moduli{10, 20};
+  std::vector<uint64_t> op1{1, 2, 3,  //
+                            11, 12, 13};
+  std::vector<uint64_t> op2{2, 4, 6,  //
+                            12, 14, 16};
+  std::vector<uint64_t> result(moduli.size());
+  std::vector<uint64_t> exp_out{(1 * 2 + 2 * 4 + 3 * 6) % 10,
+                                (11 * 12 + 12 * 14 + 13 * 16) % 20};
+
+  EltwiseDotProductMod(result.data(), op1.data(), op2.data(), n, moduli.data(),
+                       moduli.size(), 1);
+
+  CheckEqual(result, exp_out);
+}
+
+// Checks the lazy accumulator against a modular reference for large moduli
+TEST(EltwiseDotProductMod, random) {
+  for (size_t bits = 20; bits < 62; bits += 7) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (size_t n : {1, 7, 8, 1024, 1031}) {
+      auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+
+      uint64_t expected = 0;
+      for (size_t i = 0; i < n; ++i) {
+        expected =
+            AddUIntMod(expected, MultiplyMod(op1[i], op2[i], modulus), modulus);
+      }
+      EXPECT_EQ(EltwiseDotProductMod(op1.data(), op2.data(), n, modulus, 1),
+                expected);
+      EXPECT_EQ(
+          EltwiseDotProductModNative<1>(op1.data(), op2.data(), n, modulus),
+          expected);
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
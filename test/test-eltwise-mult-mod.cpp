@@ -11,6 +11,7 @@
 #include "hexl/number-theory/number-theory.hpp"
 #include "ntt/ntt-internal.hpp"
 #include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
 
 namespace intel {
 namespace hexl {
@@ -283,6 +284,98 @@ TEST_P(ModulusInputModFactor, NativeRandom) {
   ASSERT_EQ(output, expected);
 }
 
+// Checks every selectable kernel against MultiplyMod through the public API
+TEST(EltwiseMultMod, Algorithms) {
+  const std::vector<EltwiseMultModAlgorithm> algorithms{
+      EltwiseMultModAlgorithm::kAuto, EltwiseMultModAlgorithm::kNative,
+      EltwiseMultModAlgorithm::kAVX512Float,
+      EltwiseMultModAlgorithm::kAVX512IFMA,
+      EltwiseMultModAlgorithm::kAVX512DQInt};
+  uint64_t length = 1024 + 3;
+
+  for (EltwiseMultModAlgorithm algorithm : algorithms) {
+    SetEltwiseMultModAlgorithm(algorithm);
+    ASSERT_EQ(GetEltwiseMultModAlgorithm(), algorithm);
+
+    for (uint64_t modulus_bits : {30, 45, 49, 50, 60}) {
+      uint64_t modulus = GeneratePrimes(1, modulus_bits, true)[0];
+      for (uint64_t input_mod_factor : {1, 2, 4}) {
+        auto input_1 = GenerateInsecureUniformIntRandomValues(
+            length, 0, input_mod_factor * modulus);
+        auto input_2 = GenerateInsecureUniformIntRandomValues(
+            length, 0, input_mod_factor * modulus);
+        std::vector<uint64_t> output(length, 0);
+        std::vector<uint64_t> expected(length, 0);
+        for (size_t i = 0; i < length; ++i) {
+          expected[i] = MultiplyMod(input_1[i] % modulus, input_2[i] % modulus,
+                                    modulus);
+        }
+
+        EltwiseMultMod(output.data(), input_1.data(), input_2.data(), length,
+                       modulus, input_mod_factor);
+        ASSERT_EQ(output, expected);
+      }
+    }
+  }
+  SetEltwiseMultModAlgorithm(EltwiseMultModAlgorithm::kAuto);
+
+  EXPECT_TRUE(IsEltwiseMultModAlgorithmSupported(
+      EltwiseMultModAlgorithm::kNative, 1ULL << 60));
+  EXPECT_FALSE(IsEltwiseMultModAlgorithmSupported(
+      EltwiseMultModAlgorithm::kAVX512Float, 1ULL << 50));
+  EXPECT_FALSE(IsEltwiseMultModAlgorithmSupported(
+      EltwiseMultModAlgorithm::kAVX512IFMA, 1ULL << 50));
+#ifdef HEXL_HAS_AVX512DQ
+  EXPECT_EQ(IsEltwiseMultModAlgorithmSupported(
+                EltwiseMultModAlgorithm::kAVX512DQInt, 1ULL << 50),
+            has_avx512dq);
+#endif
+}
+
+// A modulus of exactly 2^50 lies on the boundary between the small- and
+// large-modulus kernels, and must keep an AVX512 kernel
+TEST(EltwiseMultMod, Algorithms_modulus_2_50) {
+  const std::vector<EltwiseMultModAlgorithm> algorithms{
+      EltwiseMultModAlgorithm::kAuto, EltwiseMultModAlgorithm::kNative,
+      EltwiseMultModAlgorithm::kAVX512DQInt};
+  uint64_t modulus = 1ULL << 50;
+  uint64_t length = 1024 + 3;
+
+  for (EltwiseMultModAlgorithm algorithm : algorithms) {
+    SetEltwiseMultModAlgorithm(algorithm);
+    for (uint64_t input_mod_factor : {1, 2, 4}) {
+      auto input_1 = GenerateInsecureUniformIntRandomValues(
+          length, 0, input_mod_factor * modulus);
+      auto input_2 = GenerateInsecureUniformIntRandomValues(
+          length, 0, input_mod_factor * modulus);
+      std::vector<uint64_t> output(length, 0);
+      std::vector<uint64_t> expected(length, 0);
+      for (size_t i = 0; i < length; ++i) {
+        expected[i] = MultiplyMod(input_1[i] % modulus, input_2[i] % modulus,
+                                  modulus);
+      }
+
+      EltwiseMultMod(output.data(), input_1.data(), input_2.data(), length,
+                     modulus, input_mod_factor);
+      ASSERT_EQ(output, expected);
+    }
+  }
+  SetEltwiseMultModAlgorithm(EltwiseMultModAlgorithm::kAuto);
+
+  bool has_avx512_kernel = false;
+  for (EltwiseMultModAlgorithm algorithm :
+       {EltwiseMultModAlgorithm::kAVX512Float,
+        EltwiseMultModAlgorithm::kAVX512IFMA,
+        EltwiseMultModAlgorithm::kAVX512DQInt}) {
+    has_avx512_kernel |= IsEltwiseMultModAlgorithmSupported(algorithm, modulus);
+  }
+#ifdef HEXL_HAS_AVX512DQ
+  EXPECT_EQ(has_avx512_kernel, has_avx512dq);
+#else
+  EXPECT_FALSE(has_avx512_kernel);
+#endif
+}
+
 INSTANTIATE_TEST_SUITE_P(
     EltwiseMultMod, ModulusInputModFactor,
     ::testing::Combine(::testing::Range(uint64_t{30}, uint64_t{61}),
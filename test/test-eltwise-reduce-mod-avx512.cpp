@@ -319,6 +319,66 @@ TEST(EltwiseReduceMod, AVX512Big_2_1) {
   }
 }
 
+// Checks AVX512 and native power-of-two lazy reductions match
+TEST(EltwiseReduceMod, AVX512Big_PowerOfTwo) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  size_t length = 1024 + 3;
+
+  for (size_t bits = 40; bits <= 58; bits += 6) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (uint64_t input_mod_factor : {8, 16, 32}) {
+      auto op = GenerateInsecureUniformIntRandomValues(
+          length, 0, input_mod_factor * modulus);
+      for (uint64_t output_mod_factor = 1; output_mod_factor < input_mod_factor;
+           output_mod_factor *= 2) {
+        std::vector<uint64_t> result1(length, 0);
+        std::vector<uint64_t> result2(length, 0);
+
+        EltwiseReduceModNative(result1.data(), op.data(), length, modulus,
+                               input_mod_factor, output_mod_factor);
+        EltwiseReduceModAVX512<64>(result2.data(), op.data(), length, modulus,
+                                   input_mod_factor, output_mod_factor);
+        ASSERT_EQ(result1, result2);
+      }
+    }
+  }
+}
+
+// Checks AVX512 and native 128-bit reductions match
+TEST(EltwiseReduceMod, AVX512Big_128) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  size_t length = 1024 + 5;
+
+  for (size_t bits = 20; bits <= 62; bits += 7) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    auto op_hi = GenerateInsecureUniformIntRandomValues(length, 0, ~0ULL);
+    auto op_lo = GenerateInsecureUniformIntRandomValues(length, 0, ~0ULL);
+    for (uint64_t output_mod_factor : {1, 2}) {
+      std::vector<uint64_t> result1(length, 0);
+      std::vector<uint64_t> result2(length, 0);
+
+      EltwiseReduceMod128Native(result1.data(), op_hi.data(), op_lo.data(),
+                                length, modulus, output_mod_factor);
+      EltwiseReduceMod128AVX512(result2.data(), op_hi.data(), op_lo.data(),
+                                length, modulus, output_mod_factor);
+      if (output_mod_factor == 1) {
+        ASSERT_EQ(result1, result2);
+      } else {
+        for (size_t i = 0; i < length; ++i) {
+          ASSERT_LT(result2[i], 2 * modulus);
+          ASSERT_EQ(result1[i] % modulus, result2[i] % modulus);
+        }
+      }
+    }
+  }
+}
+
 #ifdef HEXL_HAS_AVX512IFMA
 // Checks AVX512 and native EltwiseReduceMod implementations match with randomly
 // generated inputs
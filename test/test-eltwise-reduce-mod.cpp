@@ -80,6 +80,48 @@ TEST(EltwiseReduceMod, 4_2) {
   CheckEqual(result, exp_out);
 }
 
+TEST(EltwiseReduceMod, 8_1) {
+  std::vector<uint64_t> op{1, 730, 1460, 2919, 3000, 4380, 5109, 5839};
+  std::vector<uint64_t> exp_out{1, 0, 0, 729, 80, 0, 729, 729};
+  std::vector<uint64_t> result(op.size(), 0);
+
+  const uint64_t modulus = 730;
+  const uint64_t input_mod_factor = 8;
+  const uint64_t output_mod_factor = 1;
+  EltwiseReduceMod(result.data(), op.data(), op.size(), modulus,
+                   input_mod_factor, output_mod_factor);
+  CheckEqual(result, exp_out);
+}
+
+TEST(EltwiseReduceMod, 16_4) {
+  std::vector<uint64_t> op{1, 2919, 2920, 5000, 8759, 11679};
+  std::vector<uint64_t> exp_out{1, 2919, 0, 2080, 2919, 2919};
+  std::vector<uint64_t> result(op.size(), 0);
+
+  const uint64_t modulus = 730;
+  const uint64_t input_mod_factor = 16;
+  const uint64_t output_mod_factor = 4;
+  EltwiseReduceMod(result.data(), op.data(), op.size(), modulus,
+                   input_mod_factor, output_mod_factor);
+  CheckEqual(result, exp_out);
+}
+
+TEST(EltwiseReduceMod, 128_1) {
+  std::vector<uint64_t> op_hi{0, 0, 1, 768, 1ULL << 63, ~0ULL};
+  std::vector<uint64_t> op_lo{0, 1538, 0, ~0ULL, 12345, ~0ULL};
+  std::vector<uint64_t> exp_out(op_hi.size(), 0);
+  std::vector<uint64_t> result(op_hi.size(), 0);
+
+  const uint64_t modulus = 769;
+  for (size_t i = 0; i < op_hi.size(); ++i) {
+    exp_out[i] = static_cast<uint64_t>(
+        ((uint128_t(op_hi[i]) << 64) | op_lo[i]) % modulus);
+  }
+  EltwiseReduceMod128(result.data(), op_hi.data(), op_lo.data(), op_hi.size(),
+                      modulus, 1);
+  CheckEqual(result, exp_out);
+}
+
 // First parameter is the number of bits in the modulus
 // Second parameter is whether or not to prefer small moduli
 class EltwiseReduceModTest
@@ -122,6 +164,55 @@ TEST_P(EltwiseReduceModTest, Random) {
   AssertEqual(result_native, result_public_api);
 }
 
+// Test power-of-two lazy input ranges against direct reduction
+TEST_P(EltwiseReduceModTest, RandomPowerOfTwo) {
+  for (uint64_t input_mod_factor = 2; input_mod_factor <= 64;
+       input_mod_factor *= 2) {
+    if (input_mod_factor / 2 > (~0ULL) / m_modulus) {
+      break;
+    }
+    uint64_t upper_bound = input_mod_factor > (~0ULL) / m_modulus
+                               ? ~0ULL
+                               : input_mod_factor * m_modulus;
+    auto input = GenerateInsecureUniformIntRandomValues(m_N, 0, upper_bound);
+
+    for (uint64_t output_mod_factor = 1; output_mod_factor < input_mod_factor;
+         output_mod_factor *= 2) {
+      std::vector<uint64_t> result_native(m_N, 0);
+      std::vector<uint64_t> result_public_api(m_N, 0);
+
+      EltwiseReduceModNative(result_native.data(), input.data(), m_N,
+                             m_modulus, input_mod_factor, output_mod_factor);
+      EltwiseReduceMod(result_public_api.data(), input.data(), m_N, m_modulus,
+                       input_mod_factor, output_mod_factor);
+      for (size_t i = 0; i < m_N; ++i) {
+        ASSERT_LT(result_native[i], output_mod_factor * m_modulus);
+        ASSERT_EQ(result_native[i] % m_modulus, input[i] % m_modulus);
+        ASSERT_LT(result_public_api[i], output_mod_factor * m_modulus);
+        ASSERT_EQ(result_public_api[i] % m_modulus, input[i] % m_modulus);
+      }
+    }
+  }
+}
+
+// Test 128-bit public API matches Native implementation on random values
+TEST_P(EltwiseReduceModTest, Random128) {
+  auto input_hi = GenerateInsecureUniformIntRandomValues(m_N, 0, ~0ULL);
+  auto input_lo = GenerateInsecureUniformIntRandomValues(m_N, 0, ~0ULL);
+  std::vector<uint64_t> result_native(m_N, 0);
+  std::vector<uint64_t> result_public_api(m_N, 0);
+
+  EltwiseReduceMod128Native(result_native.data(), input_hi.data(),
+                            input_lo.data(), m_N, m_modulus, 1);
+  EltwiseReduceMod128(result_public_api.data(), input_hi.data(),
+                      input_lo.data(), m_N, m_modulus, 1);
+  for (size_t i = 0; i < m_N; ++i) {
+    uint128_t x = (uint128_t(input_hi[i]) << 64) | input_lo[i];
+    ASSERT_EQ(result_native[i], static_cast<uint64_t>(x % m_modulus));
+  }
+  AssertEqual(result_native, result_public_api);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     EltwiseReduceMod, EltwiseReduceModTest,
     ::testing::Combine(::testing::ValuesIn(AlignedVector64<uint64_t>{
@@ -0,0 +1,52 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-sum-mod-avx512.hpp"
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-sum-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(EltwiseSumMod, avx512_small) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  uint64_t modulus = 101;
+
+  EXPECT_EQ(EltwiseSumModAVX512(op.data(), op.size(), modulus), 120 % modulus);
+}
+
+// Uses inputs close to 4 * modulus so that the lane accumulators carry
+TEST(EltwiseSumMod, avx512_random) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  for (size_t bits = 20; bits <= 61; bits += 7) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (size_t n : {8, 15, 24, 1024, 4099}) {
+      auto op = GenerateInsecureUniformIntRandomValues(n, 3 * modulus,
+                                                       4 * modulus);
+
+      ASSERT_EQ(EltwiseSumModAVX512(op.data(), n, modulus),
+                EltwiseSumModNative(op.data(), n, modulus));
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,99 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-sum-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-sum-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_DEBUG
+TEST(EltwiseSumMod, null) {
+  std::vector<uint64_t> op{1, 2, 3, 4, 5, 6, 7, 8};
+  uint64_t modulus = 769;
+  std::vector<uint64_t> big_input(op.size(), modulus);
+
+  EXPECT_ANY_THROW(EltwiseSumMod(nullptr, op.size(), modulus, 1));
+  EXPECT_ANY_THROW(EltwiseSumMod(op.data(), 0, modulus, 1));
+  EXPECT_ANY_THROW(EltwiseSumMod(op.data(), op.size(), 1, 1));
+  EXPECT_ANY_THROW(EltwiseSumMod(op.data(), op.size(), modulus, 3));
+  EXPECT_ANY_THROW(EltwiseSumMod(big_input.data(), op.size(), modulus, 1));
+}
+#endif
+
+TEST(EltwiseSumMod, small) {
+  std::vector<uint64_t> op{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  uint64_t modulus = 101;
+
+  EXPECT_EQ(EltwiseSumMod(op.data(), op.size(), modulus, 1), 120 % modulus);
+}
+
+TEST(EltwiseSumMod, mult_input_mod_factor) {
+  uint64_t modulus = 101;
+  std::vector<uint64_t> op{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  for (uint64_t input_mod_factor = 1; input_mod_factor <= 4;
+       input_mod_factor *= 2) {
+    std::vector<uint64_t> lazy_op(op);
+    for (size_t i = 0; i < op.size(); ++i) {
+      lazy_op[i] += (i % input_mod_factor) * modulus;
+    }
+    EXPECT_EQ(EltwiseSumMod(lazy_op.data(), op.size(), modulus,
+                            input_mod_factor),
+              120 % modulus);
+  }
+}
+
+TEST(EltwiseSumMod, multi_modulus) {
+  uint64_t n = 3;
+  std::vector<uint64_t> moduli{10, 20};
+  std::vector<uint64_t> op{1, 2, 3,  //
+                           11, 12, 13};
+  std::vector<uint64_t> result(moduli.size());
+  std::vector<uint64_t> exp_out{(1 + 2 + 3) % 10, (11 + 12 + 13) % 20};
+
+  EltwiseSumMod(result.data(), op.data(), n, moduli.data(), moduli.size(), 1);
+
+  CheckEqual(result, exp_out);
+}
+
+TEST(EltwiseSumMod, random) {
+  for (size_t bits = 20; bits < 62; bits += 7) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (size_t n : {1, 7, 8, 1024, 1031}) {
+      auto op = GenerateInsecureUniformIntRandomValues(n, 0, 2 * modulus);
+
+      uint64_t expected = 0;
+      for (size_t i = 0; i < n; ++i) {
+        expected = AddUIntMod(expected, op[i] % modulus, modulus);
+      }
+      EXPECT_EQ(EltwiseSumMod(op.data(), n, modulus, 2), expected);
+      EXPECT_EQ(EltwiseSumModNative(op.data(), n, modulus), expected);
+    }
+  }
+}
+
+// Moduli just below 2^62 are supported with input_mod_factor 4
+TEST(EltwiseSumMod, large_modulus_input_mod_factor_4) {
+  uint64_t modulus = (1ULL << 62) - 1;
+  for (size_t n : {7, 1031}) {
+    auto op = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+
+    uint64_t expected = 0;
+    for (size_t i = 0; i < n; ++i) {
+      expected = AddUIntMod(expected, op[i] % modulus, modulus);
+    }
+    EXPECT_EQ(EltwiseSumMod(op.data(), n, modulus, 4), expected);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -8,6 +8,7 @@
 #include "hexl/util/aligned-allocator.hpp"
 #include "ntt/ntt-internal.hpp"
 #include "test/test-util.hpp"
+#include "util/measure-algorithm.hpp"
 
 namespace intel {
 namespace hexl {
@@ -81,5 +82,49 @@ TEST(GenerateInsecureUniformRealRandomValues, 1_plus_2_exp_minus_14) {
                           [&](double_t x) { return x = min_value; }));
 }
 
+// The measurement is deferred while inside an OpenMP parallel region, and
+// runs only once
+TEST(MeasuredAlgorithm, deferred_in_parallel_region) {
+  MeasuredAlgorithm<int> algorithm;
+  int num_measurements = 0;
+  auto measure = [&]() {
+    ++num_measurements;
+    return 2;
+  };
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(2)
+  {
+    if (omp_in_parallel()) {
+      EXPECT_EQ(algorithm.Get(1, measure), 1);
+    }
+  }
+  EXPECT_EQ(num_measurements, 0);
+#endif
+
+  EXPECT_EQ(algorithm.Get(1, measure), 2);
+  EXPECT_EQ(algorithm.Get(1, measure), 2);
+  EXPECT_EQ(num_measurements, 1);
+}
+
+TEST(MeasureFastestAlgorithm, runs_each_candidate) {
+  std::vector<int> num_runs(3, 0);
+  auto run = [&](int candidate) {
+    ++num_runs[candidate];
+    // Busy work makes 1 the fastest candidate
+    if (candidate != 1) {
+      volatile uint64_t sink = 0;
+      for (uint64_t i = 0; i < 100000; ++i) {
+        sink = sink + i;
+      }
+    }
+  };
+
+  int fastest = MeasureFastestAlgorithm(std::vector<int>{0, 1, 2}, run);
+  EXPECT_EQ(fastest, 1);
+  // One warm-up run and 16 timed runs each
+  EXPECT_EQ(num_runs, (std::vector<int>{17, 17, 17}));
+}
+
 }  // namespace hexl
 }  // namespace intel